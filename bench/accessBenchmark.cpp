@@ -0,0 +1,82 @@
+#include <cstdio>
+#include "../inc/dynamicArray.hpp"
+#include "../inc/arraySequence.hpp"
+#include "../inc/segmentedDeque.hpp"
+#include "benchmark.hpp"
+
+// Sums every element through each access path so the cost of the range checks
+// can be compared against unchecked access and a raw pointer walk.
+int main()
+{
+    const int elements = 1 << 20;
+    const int rounds = 20;
+
+    DynamicArray<int> array;
+    ArraySequence<int> sequence;
+    SegmentedDeque<int> deque;
+    for (int i = 0; i < elements; i++)
+    {
+        array.append(i & 0xff);
+        sequence.append(i & 0xff);
+        deque.append(i & 0xff);
+    }
+    const Sequence<int> &base = sequence;
+
+    std::printf("Sequential sum over %d ints, %d rounds\n", elements, rounds);
+
+    measure("DynamicArray raw pointer", elements, rounds, [&]()
+            {
+        const int *data = array.getData();
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += data[i];
+        return sum; });
+    measure("DynamicArray::get (checked)", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += array.get(i);
+        return sum; });
+    measure("DynamicArray::operator[]", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += array[i];
+        return sum; });
+    measure("DynamicArray::unsafeGet", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += array.unsafeGet(i);
+        return sum; });
+
+    measure("ArraySequence via Sequence::get", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += base.get(i);
+        return sum; });
+    measure("ArraySequence::at", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += sequence.at(i);
+        return sum; });
+    measure("ArraySequence::unsafeGet", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += sequence.unsafeGet(i);
+        return sum; });
+
+    measure("SegmentedDeque::at", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += deque.at(i);
+        return sum; });
+    measure("SegmentedDeque::unsafeGet", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < elements; i++) sum += deque.unsafeGet(i);
+        return sum; });
+    measure("SegmentedDeque::forEach", elements, rounds, [&]()
+            {
+        long long sum = 0;
+        deque.forEach([&](int x) { sum += x; });
+        return sum; });
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions to count heap allocations and the
+// bytes requested. Every benchmark is its own executable, so include this from
+// one file only.
+static long long allocations = 0;
+static long long allocatedBytes = 0;
+
+void *operator new(std::size_t size)
+{
+    allocations++;
+    allocatedBytes += static_cast<long long>(size);
+    if (void *memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+// Kept out of line: once inlined, GCC pairs the free() with the caller's new
+// and reports -Wmismatched-new-delete for every matching new/delete pair.
+__attribute__((noinline)) void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    ::operator delete(memory);
+}
+
+__attribute__((noinline)) void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t size) noexcept
+{
+    ::operator delete(memory, size);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Minimal timing harness shared by the benchmarks in this directory. Each
+// case runs its body a fixed number of rounds and reports nanoseconds per
+// element; the checksum is printed so the work cannot be optimized away.
+template <typename Body>
+void measure(const char *name, const int elements, const int rounds, const Body &body)
+{
+    long long checksum = body();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++)
+    {
+        checksum += body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-40s %8.3f ns/element   (checksum %lld)\n",
+                name, nanoseconds / (static_cast<double>(elements) * rounds), checksum);
+}
@@ -0,0 +1,56 @@
+#include <cstdio>
+#include "../inc/arraySequence.hpp"
+#include "../inc/listSequence.hpp"
+#include "../inc/segmentedDeque.hpp"
+#include "benchmark.hpp"
+
+// concat() and getSubsequence() between every pair of sequence kinds. The
+// source hands its storage over in contiguous blocks through visitBlocks, so
+// array and deque sources copy whole runs and list sources are walked once.
+template <class Target>
+void concatFrom(const char *name, const Sequence<int> *source, const int items, const int rounds)
+{
+    measure(name, items, rounds, [&]()
+            {
+        Target target;
+        target.concat(source);
+        return static_cast<long long>(target.getLast()); });
+}
+
+int main()
+{
+    const int items = 1 << 18;
+    const int rounds = 10;
+
+    ArraySequence<int> array;
+    ListSequence<int> list;
+    UnrolledListSequence<int> unrolled;
+    SegmentedDeque<int> deque;
+    for (int i = 0; i < items; i++)
+    {
+        array.append(i & 0xff);
+        list.append(i & 0xff);
+        unrolled.append(i & 0xff);
+        deque.append(i & 0xff);
+    }
+
+    std::printf("concat of %d ints, %d rounds\n", items, rounds);
+
+    concatFrom<ArraySequence<int>>("array <- array", &array, items, rounds);
+    concatFrom<ArraySequence<int>>("array <- list", &list, items, rounds);
+    concatFrom<ArraySequence<int>>("array <- deque", &deque, items, rounds);
+    concatFrom<ListSequence<int>>("list <- array", &array, items, rounds);
+    concatFrom<ListSequence<int>>("list <- unrolled", &unrolled, items, rounds);
+    concatFrom<SegmentedDeque<int>>("deque <- array", &array, items, rounds);
+    concatFrom<SegmentedDeque<int>>("deque <- list", &list, items, rounds);
+    concatFrom<SegmentedDeque<int>>("deque <- deque", &deque, items, rounds);
+
+    measure("deque getSubsequence", items / 2, rounds, [&]()
+            {
+        Sequence<int> *sub = deque.getSubsequence(items / 4, items / 4 + items / 2 - 1);
+        long long last = sub->getLast();
+        delete sub;
+        return last; });
+
+    return 0;
+}
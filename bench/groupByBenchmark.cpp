@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <unordered_map>
+#include "../inc/segmentedDeque.hpp"
+#include "benchmark.hpp"
+
+// Summing values per key with one where()->reduce() per key, with an
+// std::unordered_map filled item by item, with groupBy().sum() and with
+// groupBy().sum() on every hardware thread.
+int main()
+{
+    const int items = 1 << 20;
+    const int keys = 64;
+    const int rounds = 5;
+    const int threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SegmentedDeque<int> deque(1024);
+    for (int i = 0; i < items; i++)
+    {
+        deque.append(static_cast<int>((static_cast<unsigned>(i) * 7919u) & 0xffffu));
+    }
+
+    const SegmentedDeque<int> &source = deque;
+
+    auto keyOf = [](const int x)
+    { return x % keys; };
+    auto value = [](const int x)
+    { return static_cast<long long>(x); };
+
+    std::printf("sum per key over %d ints, %d keys, %d rounds, %d threads\n", items, keys, rounds, threads);
+
+    measure("where()->reduce() per key", items, rounds, [&]()
+            {
+        long long result = 0;
+        for (int key = 0; key < keys; key++)
+        {
+            SegmentedDeque<int> *group = deque.where([&](const int x) { return keyOf(x) == key; });
+            result += group->reduce([](long long acc, int x) { return acc + x; }, 0LL) * (key + 1);
+            delete group;
+        }
+        return result; });
+    measure("std::unordered_map", items, rounds, [&]()
+            {
+        std::unordered_map<int, long long> sums;
+        source.forEachBlock([&](const int *block, const int count)
+                            {
+            for (int i = 0; i < count; i++)
+            {
+                sums[keyOf(block[i])] += block[i];
+            } });
+        long long result = 0;
+        for (const auto &entry : sums)
+        {
+            result += entry.second * (entry.first + 1);
+        }
+        return result; });
+
+    auto checksum = [](SegmentedDeque<Group<int, long long>> *groups)
+    {
+        long long result = 0;
+        for (int i = 0; i < groups->getLength(); i++)
+        {
+            result += groups->get(i).value * (groups->get(i).key + 1);
+        }
+        delete groups;
+        return result;
+    };
+    measure("groupBy().sum()", items, rounds, [&]()
+            { return checksum(deque.groupBy(keyOf).sum(value)); });
+    measure("parallel groupBy().sum()", items, rounds, [&]()
+            { return checksum(deque.groupBy(keyOf).sum(value, threads)); });
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <cstdio>
+#include "../inc/dynamicArray.hpp"
+#include "allocationCounter.hpp"
+#include "benchmark.hpp"
+
+// Appends the same number of items under each growth policy and reports the
+// reallocations, the final unused capacity and the time per append.
+template <class Growth>
+void run(const char *name, const int items, const int rounds)
+{
+    DynamicArray<int, 0, Growth> probe;
+    long long before = allocations;
+    for (int i = 0; i < items; i++)
+    {
+        probe.append(i);
+    }
+    std::printf("%-40s %lld reallocations, %zu bytes held, %zu unused\n", name, allocations - before,
+                probe.getMemoryUsage(), probe.getMemoryUsage() - sizeof(int) * probe.getSize());
+
+    measure(name, items, rounds, [&]()
+            {
+        DynamicArray<int, 0, Growth> array;
+        for (int i = 0; i < items; i++) array.append(i);
+        return static_cast<long long>(array.getLast()); });
+}
+
+int main()
+{
+    const int items = 1000000;
+    const int rounds = 20;
+
+    std::printf("Appending %d ints, %d rounds\n", items, rounds);
+    run<DoublingGrowth>("DoublingGrowth", items, rounds);
+    run<HalfGrowth>("HalfGrowth", items, rounds);
+    run<FixedGrowth<65536>>("FixedGrowth<65536>", items, rounds);
+
+    return 0;
+}
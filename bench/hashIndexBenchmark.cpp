@@ -0,0 +1,72 @@
+#include <cstdio>
+#include <string>
+#include "../inc/segmentedDeque.hpp"
+#include "../types/person.hpp"
+#include "benchmark.hpp"
+
+// Finding people by name with a linear where() and with a hash index, and what
+// keeping the index up to date adds to append().
+int main()
+{
+    const int items = 1 << 17;
+    const int lookups = 1000;
+    const int rounds = 3;
+
+    SegmentedDeque<Person> people(64);
+    for (int i = 0; i < items; i++)
+    {
+        people.append(Person("person-" + std::to_string(i), i % 90));
+    }
+    auto name = [](const Person &p)
+    { return p.getName(); };
+    auto *byName = people.hashIndex(name);
+    const SegmentedDeque<Person> &source = people;
+
+    std::printf("%d lookups among %d people, %d rounds\n", lookups, items, rounds);
+
+    measure("where(name == key) per lookup", lookups, rounds, [&]()
+            {
+        long long found = 0;
+        for (int i = 0; i < lookups; i++)
+        {
+            std::string key = "person-" + std::to_string((i * 7919) % items);
+            SegmentedDeque<Person> *matches = people.where([&key](const Person &p) { return p.getName() == key; });
+            found += matches->getLength();
+            delete matches;
+        }
+        return found; });
+    measure("findFirst(key) per lookup", lookups, rounds, [&]()
+            {
+        long long found = 0;
+        for (int i = 0; i < lookups; i++)
+        {
+            found += byName->findFirst("person-" + std::to_string((i * 7919) % items));
+        }
+        return found; });
+
+    std::printf("Appending %d people, %d rounds\n", items, rounds);
+
+    measure("append()", items, rounds, [&]()
+            {
+        SegmentedDeque<Person> copy(64);
+        for (int i = 0; i < items; i++)
+        {
+            copy.append(source.get(i));
+        }
+        return static_cast<long long>(copy.getLength()); });
+    measure("append() with a hash index", items, rounds, [&]()
+            {
+        SegmentedDeque<Person> copy(64);
+        auto *index = copy.hashIndex(name);
+        index->findFirst("");
+        for (int i = 0; i < items; i++)
+        {
+            copy.append(source.get(i));
+        }
+        long long result = index->findFirst("person-5");
+        delete index;
+        return result; });
+
+    delete byName;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "../inc/segmentedDeque.hpp"
+#include "../types/person.hpp"
+#include "benchmark.hpp"
+
+// Joining people to orders by person id with a nested loop of get() calls,
+// with hashJoin() serial and on every hardware thread, and with mergeJoin()
+// on inputs sorted by id.
+int main()
+{
+    const int people = 1 << 10;
+    const int orders = 1 << 14;
+    const int rounds = 3;
+    const int threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SegmentedDeque<Person> persons(64);
+    for (int i = 0; i < people; i++)
+    {
+        persons.append(Person("person-" + std::to_string(i), i));
+    }
+    SegmentedDeque<int> orderOwners(64);
+    for (int i = 0; i < orders; i++)
+    {
+        orderOwners.append(static_cast<int>((static_cast<unsigned>(i) * 7919u) % (people * 2)));
+    }
+    SegmentedDeque<int> sortedOwners(orderOwners);
+    sortedOwners.sort(sortedOwners.begin(), sortedOwners.end());
+
+    auto personId = [](const Person &p)
+    { return p.getAge(); };
+    auto ownerId = [](const int owner)
+    { return owner; };
+
+    std::printf("%d people joined to %d orders, %d rounds, %d threads\n", people, orders, rounds, threads);
+
+    measure("nested loop of get()", orders, rounds, [&]()
+            {
+        long long matches = 0;
+        for (int i = 0; i < persons.getLength(); i++)
+        {
+            for (int j = 0; j < orderOwners.getLength(); j++)
+            {
+                if (personId(persons.get(i)) == ownerId(orderOwners.get(j)))
+                {
+                    matches += ownerId(orderOwners.get(j));
+                }
+            }
+        }
+        return matches; });
+    measure("hashJoin() callback", orders, rounds, [&]()
+            {
+        long long matches = 0;
+        persons.hashJoin(orderOwners, personId, ownerId, [&matches](const Person &, const int owner)
+                         { matches += owner; });
+        return matches; });
+    measure("hashJoin() into a deque", orders, rounds, [&]()
+            {
+        SegmentedDeque<Joined<Person, int>> *joined = persons.hashJoin(orderOwners, personId, ownerId);
+        long long matches = joined->getLength();
+        delete joined;
+        return matches; });
+    measure("parallel hashJoin() into a deque", orders, rounds, [&]()
+            {
+        SegmentedDeque<Joined<Person, int>> *joined = persons.hashJoin(orderOwners, personId, ownerId, threads);
+        long long matches = joined->getLength();
+        delete joined;
+        return matches; });
+    measure("mergeJoin() callback, sorted inputs", orders, rounds, [&]()
+            {
+        long long matches = 0;
+        persons.mergeJoin(sortedOwners, personId, ownerId, [&matches](const Person &, const int owner)
+                          { matches += owner; });
+        return matches; });
+
+    return 0;
+}
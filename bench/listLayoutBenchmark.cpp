@@ -0,0 +1,45 @@
+#include <cstdio>
+#include "../inc/listSequence.hpp"
+#include "allocationCounter.hpp"
+#include "benchmark.hpp"
+
+// Builds the same list of ints with one item per node and with unrolled nodes,
+// then compares heap use and the cost of a full iteration.
+template <class List>
+void run(const char *name, const int items, const int rounds)
+{
+    long long beforeAllocations = allocations;
+    long long beforeBytes = allocatedBytes;
+    List list;
+    for (int i = 0; i < items; i++)
+    {
+        list.append(i & 0xff);
+    }
+    std::printf("%-40s %lld nodes, %.2f bytes per item\n", name, allocations - beforeAllocations,
+                static_cast<double>(allocatedBytes - beforeBytes) / items);
+
+    measure(name, items, rounds, [&]()
+            {
+        long long sum = 0;
+        for (auto it = list.cbegin(); it != list.cend(); ++it) sum += *it;
+        return sum; });
+
+    measure("  ...through forEachBlock", items, rounds, [&]()
+            {
+        long long sum = 0;
+        list.forEachBlock([&](const int *block, const int count)
+                          { for (int i = 0; i < count; i++) sum += block[i]; });
+        return sum; });
+}
+
+int main()
+{
+    const int items = 1 << 20;
+    const int rounds = 20;
+
+    std::printf("Lists of %d ints, %d rounds\n", items, rounds);
+    run<LinkedList<int>>("LinkedList<int>", items, rounds);
+    run<UnrolledLinkedList<int>>("UnrolledLinkedList<int>", items, rounds);
+
+    return 0;
+}
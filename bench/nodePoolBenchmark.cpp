@@ -0,0 +1,67 @@
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include "../inc/linkedList.hpp"
+#include "allocationCounter.hpp"
+#include "benchmark.hpp"
+
+// Compares pooled LinkedList nodes against std::list, which allocates every
+// node separately, and measures traversal before and after compact().
+int main()
+{
+    const int items = 1 << 16;
+    const int rounds = 50;
+
+    std::printf("Fill with %d ints and clear, %d rounds\n", items, rounds);
+
+    LinkedList<int> pooled;
+    long long before = allocations;
+    measure("LinkedList (pooled) append + clear", items, rounds, [&]()
+            {
+        for (int i = 0; i < items; i++) pooled.append(i);
+        long long last = pooled.getLast();
+        pooled.clear();
+        return last; });
+    std::printf("%-40s %lld allocations\n", "", allocations - before);
+
+    std::list<int> standard;
+    before = allocations;
+    measure("std::list append + clear", items, rounds, [&]()
+            {
+        for (int i = 0; i < items; i++) standard.push_back(i);
+        long long last = standard.back();
+        standard.clear();
+        return last; });
+    std::printf("%-40s %lld allocations\n", "", allocations - before);
+
+    std::printf("\nTraversal of %d ints built by prepends and random inserts\n", items);
+
+    LinkedList<int> scattered;
+    std::srand(1);
+    for (int i = 0; i < items; i++)
+    {
+        if (i % 2 == 0)
+        {
+            scattered.prepend(i);
+        }
+        else
+        {
+            scattered.insertAt(i, std::rand() % (scattered.getLength() + 1) / 64);
+        }
+    }
+
+    auto traverse = [&]()
+    {
+        long long sum = 0;
+        for (auto it = scattered.cbegin(); it != scattered.cend(); ++it)
+        {
+            sum += *it;
+        }
+        return sum;
+    };
+    measure("before compact()", items, rounds, traverse);
+    scattered.compact();
+    measure("after compact()", items, rounds, traverse);
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <cstdio>
+#include <thread>
+#include "../inc/segmentedDeque.hpp"
+#include "benchmark.hpp"
+
+// filter -> map -> reduce written as chained where()/reduce() calls, as a
+// fused pipeline and as a pipeline reduced on every hardware thread.
+int main()
+{
+    const int items = 1 << 22;
+    const int rounds = 10;
+    const int threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SegmentedDeque<int> deque(1024);
+    for (int i = 0; i < items; i++)
+    {
+        deque.append(static_cast<int>((static_cast<unsigned>(i) * 7919u) & 0xffffu));
+    }
+
+    auto isSmall = [](int x)
+    { return x < 0x8000; };
+    auto weight = [](int x)
+    { return static_cast<long long>(x) * 3 + 1; };
+    auto sum = [](long long acc, long long x)
+    { return acc + x; };
+
+    std::printf("filter -> map -> reduce over %d ints, %d rounds, %d threads\n", items, rounds, threads);
+
+    measure("where()->reduce()", items, rounds, [&]()
+            {
+        SegmentedDeque<int> *small = deque.where(isSmall);
+        long long result = small->reduce([&](long long acc, int x) { return sum(acc, weight(x)); }, 0LL);
+        delete small;
+        return result; });
+    measure("pipeline().filter().map().reduce()", items, rounds, [&]()
+            { return deque.pipeline().filter(isSmall).map(weight).reduce(sum, 0LL); });
+    measure("parallel pipeline reduce", items, rounds, [&]()
+            { return deque.pipeline().filter(isSmall).map(weight).reduce(sum, sum, 0LL, threads); });
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <cstdio>
+#include <functional>
+#include "../inc/segmentedDeque.hpp"
+#include "../types/complex.hpp"
+#include "benchmark.hpp"
+
+// Picking the 100 largest items by magnitude out of a million: a full sort of
+// a copy, partialSort of a copy, and topK in one pass on one and four threads.
+int main()
+{
+    const int items = 1 << 20;
+    const int k = 100;
+    const int rounds = 3;
+
+    SegmentedDeque<Complex> numbers(64);
+    for (int i = 0; i < items; i++)
+    {
+        unsigned hash = static_cast<unsigned>(i) * 2654435761u;
+        numbers.append(Complex(static_cast<double>(hash % 10000), static_cast<double>((hash >> 12) % 10000)));
+    }
+    auto byMagnitude = [](const Complex &a, const Complex &b)
+    { return b.magnitude() < a.magnitude(); };
+    auto magnitude = [](const Complex &c)
+    { return c.magnitude(); };
+
+    std::printf("Top %d of %d items, %d rounds\n", k, items, rounds);
+
+    measure("sortImmutable, then first k", items, rounds, [&]()
+            {
+        SegmentedDeque<Complex> *sorted = numbers.sortImmutable(numbers.begin(), numbers.end(), byMagnitude);
+        long long result = static_cast<long long>(sorted->get(k - 1).magnitude());
+        delete sorted;
+        return result; });
+    measure("copy, then partialSort(k)", items, rounds, [&]()
+            {
+        SegmentedDeque<Complex> copy(numbers);
+        copy.partialSort(k, byMagnitude);
+        return static_cast<long long>(copy.get(k - 1).magnitude()); });
+    measure("copy, then nthElement(k - 1)", items, rounds, [&]()
+            {
+        SegmentedDeque<Complex> copy(numbers);
+        copy.nthElement(k - 1, byMagnitude);
+        return static_cast<long long>(copy.get(k - 1).magnitude()); });
+    measure("topK(k, magnitude)", items, rounds, [&]()
+            {
+        SegmentedDeque<Complex> *top = numbers.topK(k, magnitude);
+        long long result = static_cast<long long>(top->getLast().magnitude());
+        delete top;
+        return result; });
+    measure("topK(k, magnitude), 4 threads", items, rounds, [&]()
+            {
+        SegmentedDeque<Complex> *top = numbers.topK(k, magnitude, std::less<>(), 4);
+        long long result = static_cast<long long>(top->getLast().magnitude());
+        delete top;
+        return result; });
+
+    return 0;
+}
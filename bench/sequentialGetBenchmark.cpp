@@ -0,0 +1,52 @@
+#include <cstdio>
+#include "../inc/arraySequence.hpp"
+#include "../inc/listSequence.hpp"
+#include "../inc/segmentedDeque.hpp"
+#include "benchmark.hpp"
+
+// Index loops over a ListSequence, directly and through the concat paths that
+// read their argument with get(i). Without the finger each get walks from an
+// end of the list and these loops are quadratic.
+int main()
+{
+    const int items = 1 << 16;
+    const int rounds = 10;
+
+    ListSequence<int> list;
+    for (int i = 0; i < items; i++)
+    {
+        list.append(i & 0xff);
+    }
+    const Sequence<int> *source = &list;
+
+    std::printf("Index access over a ListSequence of %d ints, %d rounds\n", items, rounds);
+
+    measure("forward get(i)", items, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < items; i++) sum += source->get(i);
+        return sum; });
+    measure("backward get(i)", items, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = items - 1; i >= 0; i--) sum += source->get(i);
+        return sum; });
+    measure("stride-2 get(i)", items, rounds, [&]()
+            {
+        long long sum = 0;
+        for (int i = 0; i < items; i += 2) sum += source->get(i);
+        for (int i = 1; i < items; i += 2) sum += source->get(i);
+        return sum; });
+    measure("ArraySequence::concat(list)", items, rounds, [&]()
+            {
+        ArraySequence<int> array;
+        array.concat(source);
+        return static_cast<long long>(array.getLast()); });
+    measure("SegmentedDeque::concat(list)", items, rounds, [&]()
+            {
+        SegmentedDeque<int> deque;
+        deque.concat(source);
+        return static_cast<long long>(deque.getLast()); });
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <functional>
+#include "../inc/slidingWindow.hpp"
+#include "benchmark.hpp"
+
+// Sum and minimum of the last width items of a stream after every push:
+// recomputed with reduce() over a deque used as the stream buffer, and kept
+// by a SlidingWindow.
+int main()
+{
+    const int items = 1 << 16;
+    const int width = 1024;
+    const int rounds = 2;
+
+    auto next = [](const int i)
+    { return static_cast<long long>((static_cast<unsigned>(i) * 7919u) & 0xffffu); };
+
+    std::printf("%d pushes, window of %d, %d rounds\n", items, width, rounds);
+
+    measure("append + erase(0) + reduce() sum", items, rounds, [&]()
+            {
+        SegmentedDeque<long long> buffer(64);
+        long long checksum = 0;
+        for (int i = 0; i < items; i++)
+        {
+            if (buffer.getLength() == width)
+            {
+                buffer.erase(0);
+            }
+            buffer.append(next(i));
+            checksum += buffer.reduce([](long long acc, long long x) { return acc + x; }, 0LL);
+        }
+        return checksum; });
+    measure("SlidingWindow sum", items, rounds, [&]()
+            {
+        SlidingWindow<long long, std::plus<>> window(width, std::plus<>(), 64);
+        long long checksum = 0;
+        for (int i = 0; i < items; i++)
+        {
+            window.push(next(i));
+            checksum += window.query();
+        }
+        return checksum; });
+    measure("append + erase(0) + reduce() min", items, rounds, [&]()
+            {
+        SegmentedDeque<long long> buffer(64);
+        long long checksum = 0;
+        for (int i = 0; i < items; i++)
+        {
+            if (buffer.getLength() == width)
+            {
+                buffer.erase(0);
+            }
+            buffer.append(next(i));
+            checksum += buffer.reduce([](long long acc, long long x) { return x < acc ? x : acc; }, 1LL << 62);
+        }
+        return checksum; });
+    measure("SlidingWindow min", items, rounds, [&]()
+            {
+        SlidingWindow<long long, MinOp<>> window(width, MinOp<>(), 64);
+        long long checksum = 0;
+        for (int i = 0; i < items; i++)
+        {
+            window.push(next(i));
+            checksum += window.query();
+        }
+        return checksum; });
+
+    return 0;
+}
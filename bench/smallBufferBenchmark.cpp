@@ -0,0 +1,60 @@
+#include <cstdio>
+#include "../inc/dynamicArray.hpp"
+#include "../inc/arraySequence.hpp"
+#include "../inc/segmentedDeque.hpp"
+#include "allocationCounter.hpp"
+#include "benchmark.hpp"
+
+template <typename Body>
+void cycle(const char *name, const int items, const int cycles, const Body &body)
+{
+    long long before = allocations;
+    body(items);
+    std::printf("%-40s %lld allocations per cycle\n", name, allocations - before);
+
+    measure(name, items, cycles, [&]()
+            { return body(items); });
+}
+
+int main()
+{
+    const int cycles = 1000000;
+
+    for (int items = 2; items <= 8; items *= 2)
+    {
+        std::printf("\nCreate, fill with %d ints and destroy, %d cycles\n", items, cycles);
+
+        cycle("DynamicArray<int>", items, cycles, [](int n)
+              {
+            DynamicArray<int> array;
+            for (int i = 0; i < n; i++) array.append(i);
+            return static_cast<long long>(array.getLast()); });
+        cycle("DynamicArray<int, 8>", items, cycles, [](int n)
+              {
+            DynamicArray<int, 8> array;
+            for (int i = 0; i < n; i++) array.append(i);
+            return static_cast<long long>(array.getLast()); });
+        cycle("ArraySequence<int>", items, cycles, [](int n)
+              {
+            ArraySequence<int> sequence;
+            for (int i = 0; i < n; i++) sequence.append(i);
+            return static_cast<long long>(sequence.getLast()); });
+        cycle("SegmentedDeque<int>", items, cycles, [](int n)
+              {
+            SegmentedDeque<int> deque;
+            for (int i = 0; i < n; i++) deque.append(i);
+            return static_cast<long long>(deque.getLast()); });
+        cycle("SegmentedDeque<int> prepend", items, cycles, [](int n)
+              {
+            SegmentedDeque<int> deque;
+            for (int i = 0; i < n; i++) deque.prepend(i);
+            return static_cast<long long>(deque.getLast()); });
+        cycle("SegmentedDeque<int> insertAt middle", items, cycles, [](int n)
+              {
+            SegmentedDeque<int> deque;
+            for (int i = 0; i < n; i++) deque.insertAt(i, deque.getLength() / 2);
+            return static_cast<long long>(deque.getLast()); });
+    }
+
+    return 0;
+}
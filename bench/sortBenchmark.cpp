@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <string>
+#include "../inc/segmentedDeque.hpp"
+#include "../types/complex.hpp"
+#include "../types/person.hpp"
+#include "benchmark.hpp"
+
+// Sorting with an expensive comparator (Complex by magnitude, Person by name)
+// through sort(), which computes both keys on every comparison, and through
+// sortByKey(), which computes each key once. Then sort() on int inputs of
+// growing presortedness, which the run detection turns into fewer merges.
+int main()
+{
+    const int items = 1 << 16;
+    const int rounds = 5;
+
+    SegmentedDeque<Complex> numbers;
+    SegmentedDeque<Person> people;
+    for (int i = 0; i < items; i++)
+    {
+        unsigned hash = static_cast<unsigned>(i) * 2654435761u;
+        numbers.append(Complex(static_cast<double>(hash % 1000), static_cast<double>((hash >> 10) % 1000)));
+        people.append(Person("person-" + std::to_string(hash % 100000), static_cast<int>(hash % 90)));
+    }
+
+    std::printf("Sorting %d items, %d rounds\n", items, rounds);
+
+    measure("Complex sort(std::less)", items, rounds, [&]()
+            {
+        SegmentedDeque<Complex> copy(numbers);
+        copy.sort(copy.begin(), copy.end());
+        return static_cast<long long>(copy.getLast().magnitude()); });
+    measure("Complex sortByKey(magnitude)", items, rounds, [&]()
+            {
+        SegmentedDeque<Complex> copy(numbers);
+        copy.sortByKey([](const Complex &c) { return c.magnitude(); });
+        return static_cast<long long>(copy.getLast().magnitude()); });
+    measure("Person sort(by getName())", items, rounds, [&]()
+            {
+        SegmentedDeque<Person> copy(people);
+        copy.sort(copy.begin(), copy.end(), [](const Person &a, const Person &b) { return a.getName() < b.getName(); });
+        return static_cast<long long>(copy.getLast().getAge()); });
+    measure("Person sortByKey(getName)", items, rounds, [&]()
+            {
+        SegmentedDeque<Person> copy(people);
+        copy.sortByKey([](const Person &p) { return p.getName(); });
+        return static_cast<long long>(copy.getLast().getAge()); });
+
+    SegmentedDeque<int> random;
+    SegmentedDeque<int> nearlySorted;
+    SegmentedDeque<int> reversed;
+    for (int i = 0; i < items; i++)
+    {
+        unsigned hash = static_cast<unsigned>(i) * 2654435761u;
+        random.append(static_cast<int>(hash % 1000000));
+        nearlySorted.append(hash % 100 == 0 ? static_cast<int>(hash % items) : i);
+        reversed.append(items - i);
+    }
+
+    measure("int sort(random)", items, rounds, [&]()
+            {
+        SegmentedDeque<int> copy(random);
+        copy.sort(copy.begin(), copy.end());
+        return static_cast<long long>(copy.getLast()); });
+    measure("int sort(1% out of place)", items, rounds, [&]()
+            {
+        SegmentedDeque<int> copy(nearlySorted);
+        copy.sort(copy.begin(), copy.end());
+        return static_cast<long long>(copy.getLast()); });
+    measure("int sort(reversed)", items, rounds, [&]()
+            {
+        SegmentedDeque<int> copy(reversed);
+        copy.sort(copy.begin(), copy.end());
+        return static_cast<long long>(copy.getLast()); });
+    measure("int sort(already sorted)", items, rounds, [&]()
+            {
+        SegmentedDeque<int> copy(reversed);
+        copy.sort(copy.begin(), copy.end());
+        copy.sort(copy.begin(), copy.end());
+        return static_cast<long long>(copy.getLast()); });
+
+    return 0;
+}
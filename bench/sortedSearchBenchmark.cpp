@@ -0,0 +1,61 @@
+#include <cstdio>
+#include "../inc/segmentedDeque.hpp"
+#include "benchmark.hpp"
+
+// Looking values up in a sorted deque with where() and with equalRange(), and
+// merging two sorted deques with mergeSorted() against concat plus sort().
+int main()
+{
+    const int items = 1 << 20;
+    const int lookups = 200;
+    const int rounds = 3;
+
+    SegmentedDeque<int> evens(64);
+    SegmentedDeque<int> odds(64);
+    for (int i = 0; i < items; i++)
+    {
+        evens.append(2 * i);
+        odds.append(2 * i + 1);
+    }
+
+    std::printf("%d lookups in %d sorted items, %d rounds\n", lookups, items, rounds);
+
+    measure("where(== value) per lookup", lookups, rounds, [&]()
+            {
+        long long found = 0;
+        for (int i = 0; i < lookups; i++)
+        {
+            int value = static_cast<int>((static_cast<unsigned>(i) * 2654435761u) % (2u * items));
+            SegmentedDeque<int> *matches = evens.where([value](int x) { return x == value; });
+            found += matches->getLength();
+            delete matches;
+        }
+        return found; });
+    measure("equalRange(value) per lookup", lookups, rounds, [&]()
+            {
+        long long found = 0;
+        for (int i = 0; i < lookups; i++)
+        {
+            int value = static_cast<int>((static_cast<unsigned>(i) * 2654435761u) % (2u * items));
+            std::pair<int, int> range = evens.equalRange(value);
+            found += range.second - range.first;
+        }
+        return found; });
+
+    std::printf("Merging two sorted deques of %d items, %d rounds\n", items, rounds);
+
+    measure("concat, then sort()", 2 * items, rounds, [&]()
+            {
+        SegmentedDeque<int> merged(evens);
+        merged.concat(&odds);
+        merged.sort(merged.begin(), merged.end());
+        return static_cast<long long>(merged.get(items)); });
+    measure("mergeSorted()", 2 * items, rounds, [&]()
+            {
+        SegmentedDeque<int> *merged = evens.mergeSorted(odds);
+        long long result = merged->get(items);
+        delete merged;
+        return result; });
+
+    return 0;
+}
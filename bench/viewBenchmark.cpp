@@ -0,0 +1,52 @@
+#include <cstdio>
+#include "../inc/segmentedDeque.hpp"
+#include "allocationCounter.hpp"
+#include "benchmark.hpp"
+
+// filter -> map -> reduce over a deque, once through the eager where() and
+// a copied intermediate deque, once through a lazy view chain.
+int main()
+{
+    const int items = 1 << 20;
+    const int rounds = 10;
+
+    SegmentedDeque<int> deque;
+    for (int i = 0; i < items; i++)
+    {
+        deque.append(i & 0xfff);
+    }
+
+    auto isEven = [](int x)
+    { return x % 2 == 0; };
+    auto triple = [](int x)
+    { return static_cast<long long>(x) * 3; };
+    auto sum = [](long long acc, long long x)
+    { return acc + x; };
+
+    std::printf("filter -> map -> reduce over %d ints, %d rounds\n", items, rounds);
+
+    long long before = allocations;
+    measure("eager where + reduce", items, rounds, [&]()
+            {
+        SegmentedDeque<int> *even = deque.where(isEven);
+        long long result = even->reduce([&](long long acc, int x) { return sum(acc, triple(x)); }, 0LL);
+        delete even;
+        return result; });
+    std::printf("%-40s %lld allocations per round\n", "eager", (allocations - before) / (rounds + 1));
+
+    before = allocations;
+    measure("lazy filterView.mapView.reduce", items, rounds, [&]()
+            { return deque.filterView(isEven).mapView(triple).reduce(sum, 0LL); });
+    std::printf("%-40s %lld allocations per round\n", "lazy", (allocations - before) / (rounds + 1));
+
+    measure("getSubsequence + reduce", items / 2, rounds, [&]()
+            {
+        Sequence<int> *sub = deque.getSubsequence(items / 4, items / 4 + items / 2 - 1);
+        long long result = static_cast<SegmentedDeque<int> *>(sub)->reduce(sum, 0LL);
+        delete sub;
+        return result; });
+    measure("slice + reduce", items / 2, rounds, [&]()
+            { return deque.slice(items / 4, items / 4 + items / 2 - 1).reduce(sum, 0LL); });
+
+    return 0;
+}
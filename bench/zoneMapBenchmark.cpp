@@ -0,0 +1,42 @@
+#include <cstdio>
+#include "../inc/segmentedDeque.hpp"
+#include "benchmark.hpp"
+
+// Narrow range filters over mostly time-ordered data: where() tests every
+// item, a zone map skips the segments whose min/max rule them out.
+int main()
+{
+    const int items = 1 << 20;
+    const int rounds = 20;
+
+    SegmentedDeque<int> deque(256);
+    for (int i = 0; i < items; i++)
+    {
+        deque.append(i + static_cast<int>((static_cast<unsigned>(i) * 2654435761u) >> 26));
+    }
+    ZoneMap<int> *zones = deque.zoneMap();
+    const int lo = items / 2;
+    const int hi = lo + items / 100;
+
+    std::printf("Range [%d, %d] over %d mostly ordered ints, %d rounds\n", lo, hi, items, rounds);
+
+    measure("where() + getLength()", items, rounds, [&]()
+            {
+        SegmentedDeque<int> *found = deque.where([&](int x) { return x >= lo && x <= hi; });
+        long long result = found->getLength();
+        delete found;
+        return result; });
+    measure("ZoneMap::whereRange()", items, rounds, [&]()
+            {
+        SegmentedDeque<int> *found = zones->whereRange(lo, hi);
+        long long result = found->getLength();
+        delete found;
+        return result; });
+    measure("countIf()", items, rounds, [&]()
+            { return static_cast<long long>(deque.countIf([&](int x) { return x >= lo && x <= hi; })); });
+    measure("ZoneMap::count()", items, rounds, [&]()
+            { return static_cast<long long>(zones->count(lo, hi)); });
+
+    delete zones;
+    return 0;
+}
@@ -61,12 +61,48 @@ const T &ArraySequence<T>::get(const int index) const
     return array.get(index);
 }
 
+template <class T>
+T &ArraySequence<T>::at(const int index)
+{
+    return array.at(index);
+}
+
+template <class T>
+const T &ArraySequence<T>::at(const int index) const
+{
+    return array.at(index);
+}
+
+template <class T>
+T &ArraySequence<T>::unsafeGet(const int index)
+{
+    return array.unsafeGet(index);
+}
+
+template <class T>
+const T &ArraySequence<T>::unsafeGet(const int index) const
+{
+    return array.unsafeGet(index);
+}
+
 template <class T>
 int ArraySequence<T>::getLength() const
 {
     return array.getSize();
 }
 
+template <class T>
+T *ArraySequence<T>::getData()
+{
+    return array.getData();
+}
+
+template <class T>
+const T *ArraySequence<T>::getData() const
+{
+    return array.getData();
+}
+
 template <class T>
 Sequence<T> *ArraySequence<T>::getSubsequence(const int startIndex, const int endIndex) const
 {
@@ -76,10 +112,7 @@ Sequence<T> *ArraySequence<T>::getSubsequence(const int startIndex, const int en
     }
 
     ArraySequence<T> *newSequence = new ArraySequence<T>();
-    for (int i = startIndex; i <= endIndex; i++)
-    {
-        newSequence->append(this->get(i));
-    }
+    newSequence->appendRange(array.getData() + startIndex, endIndex - startIndex + 1);
     return newSequence;
 }
 
@@ -98,21 +131,13 @@ void ArraySequence<T>::prepend(const T &item)
 template <class T>
 void ArraySequence<T>::insertAt(const T &item, const int index)
 {
-    if (index < 0 || index > getLength())
-    {
-        throw std::out_of_range("Invalid index for insertion");
-    }
     array.insertAt(item, index);
 }
 
 template <class T>
 void ArraySequence<T>::set(const int index, const T &data)
 {
-    if (index < 0 || index >= getLength())
-    {
-        throw std::out_of_range("Index out of range");
-    }
-    array[index] = data;
+    array.set(index, data);
 }
 
 template <class T>
@@ -123,9 +148,20 @@ void ArraySequence<T>::concat(const Sequence<T> *other)
         return;
     }
 
-    for (int i = 0; i < other->getLength(); i++)
+    // Reserving first also keeps the blocks valid when other is this sequence.
+    array.reserve(array.getSize() + other->getLength());
+    auto appender = makeBlockVisitor<T>([this](const T *items, const int count)
+                                        { array.appendRange(items, count); });
+    other->visitBlocks(0, other->getLength(), appender);
+}
+
+template <class T>
+void ArraySequence<T>::visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const
+{
+    this->checkBlockRange(startIndex, count);
+    if (count > 0)
     {
-        array.append(other->get(i));
+        visitor.visit(array.getData() + startIndex, count);
     }
 }
 
@@ -175,26 +211,64 @@ void ArraySequence<T>::print() const
     array.print();
 }
 
+template <class T>
+template <class Visitor>
+void ArraySequence<T>::forEachBlock(const Visitor &visit) const
+{
+    visit(array.getData(), array.getSize());
+}
+
+template <class T>
+template <class Visitor>
+void ArraySequence<T>::forEachBlock(const Visitor &visit)
+{
+    visit(array.getData(), array.getSize());
+}
+
 template <class T>
 T &ArraySequence<T>::operator[](const int index)
 {
-    if (index < 0 || index >= getLength())
-    {
-        throw std::out_of_range("Index out of range");
-    }
     return array[index];
 }
 
 template <class T>
 const T &ArraySequence<T>::operator[](const int index) const
 {
-    if (index < 0 || index >= getLength())
-    {
-        throw std::out_of_range("Index out of range");
-    }
     return array[index];
 }
 
+template <class T>
+template <class InputIt>
+void ArraySequence<T>::assign(InputIt first, InputIt last)
+{
+    array.assign(first, last);
+}
+
+template <class T>
+template <class InputIt>
+void ArraySequence<T>::appendRange(InputIt first, InputIt last)
+{
+    array.appendRange(first, last);
+}
+
+template <class T>
+void ArraySequence<T>::appendRange(const T *items, const int count)
+{
+    array.appendRange(items, count);
+}
+
+template <class T>
+void ArraySequence<T>::reserve(const int count)
+{
+    array.reserve(count);
+}
+
+template <class T>
+void ArraySequence<T>::resize(const int count)
+{
+    array.resize(count);
+}
+
 template <class T>
 void ArraySequence<T>::clear()
 {
@@ -0,0 +1,366 @@
+#include "../inc/dequeView.hpp"
+
+//* { DequeView
+template <class Derived, class T>
+template <class Predicate>
+FilterView<Derived, Predicate> DequeView<Derived, T>::filterView(const Predicate &pred) const
+{
+    return FilterView<Derived, Predicate>(this->derived(), pred);
+}
+
+template <class Derived, class T>
+template <class Fn>
+MapView<Derived, Fn> DequeView<Derived, T>::mapView(const Fn &fn) const
+{
+    return MapView<Derived, Fn>(this->derived(), fn);
+}
+
+template <class Derived, class T>
+template <class Other>
+ZipView<Derived, Other> DequeView<Derived, T>::zipView(const Other &other) const
+{
+    return ZipView<Derived, Other>(this->derived(), other);
+}
+
+template <class Derived, class T>
+template <typename U>
+ZipView<Derived, DequeSlice<U>> DequeView<Derived, T>::zipView(const SegmentedDeque<U> &other) const
+{
+    return ZipView<Derived, DequeSlice<U>>(this->derived(), other.view());
+}
+
+template <class Derived, class T>
+int DequeView<Derived, T>::count() const
+{
+    int result = 0;
+    this->derived().forEachBlock([&result](const T *, const int count)
+                                 { result += count; });
+    return result;
+}
+
+template <class Derived, class T>
+SegmentedDeque<T> *DequeView<Derived, T>::toDeque(const int segmentSize) const
+{
+    auto *result = new SegmentedDeque<T>(segmentSize);
+    this->derived().forEachBlock([result](const T *items, const int count)
+                                 { result->appendRange(items, count); });
+    return result;
+}
+//* } DequeView
+
+//* { DequeSlice
+template <typename T>
+DequeSlice<T>::DequeSlice(const SegmentedDeque<T> *deque, const int startIndex, const int count)
+    : deque(deque), startIndex(startIndex), length(count)
+{
+    if (startIndex < 0 || count < 0 || startIndex > deque->getLength() - count)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+}
+
+template <typename T>
+int DequeSlice<T>::getLength() const
+{
+    return length;
+}
+
+template <typename T>
+const T &DequeSlice<T>::get(const int index) const
+{
+    if (index < 0 || index >= length)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+    return deque->unsafeGet(startIndex + index);
+}
+
+template <typename T>
+DequeSlice<T> DequeSlice<T>::slice(const int startIndex, const int endIndex) const
+{
+    if (startIndex < 0 || endIndex >= length || startIndex > endIndex)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+    return DequeSlice<T>(deque, this->startIndex + startIndex, endIndex - startIndex + 1);
+}
+
+template <typename T>
+template <class Visitor>
+void DequeSlice<T>::forEachBlock(const Visitor &visit) const
+{
+    auto visitor = makeBlockVisitor<T>(visit);
+    deque->visitBlocks(startIndex, length, visitor);
+}
+
+template <typename T>
+typename DequeSlice<T>::ConstIterator DequeSlice<T>::begin() const
+{
+    return ConstIterator(deque, startIndex);
+}
+
+template <typename T>
+typename DequeSlice<T>::ConstIterator DequeSlice<T>::end() const
+{
+    return ConstIterator(deque, startIndex + length);
+}
+//* } DequeSlice
+
+//* { FilterView
+template <class Source, class Predicate>
+FilterView<Source, Predicate>::FilterView(const Source &source, const Predicate &pred)
+    : source(source), pred(pred) {}
+
+template <class Source, class Predicate>
+template <class Visitor>
+void FilterView<Source, Predicate>::forEachBlock(const Visitor &visit) const
+{
+    source.forEachBlock([this, &visit](const T *items, const int count)
+                        {
+        int runStart = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (!pred(items[i]))
+            {
+                if (i > runStart)
+                {
+                    visit(items + runStart, i - runStart);
+                }
+                runStart = i + 1;
+            }
+        }
+        if (count > runStart)
+        {
+            visit(items + runStart, count - runStart);
+        } });
+}
+
+template <class Source, class Predicate>
+FilterView<Source, Predicate>::ConstIterator::ConstIterator(const FilterView<Source, Predicate> *view, const SourceIterator &current, const SourceIterator &last)
+    : view(view), current(current), last(last)
+{
+    skip();
+}
+
+template <class Source, class Predicate>
+void FilterView<Source, Predicate>::ConstIterator::skip()
+{
+    while (current != last && !view->pred(*current))
+    {
+        ++current;
+    }
+}
+
+template <class Source, class Predicate>
+typename FilterView<Source, Predicate>::ConstIterator::reference FilterView<Source, Predicate>::ConstIterator::operator*() const
+{
+    return *current;
+}
+
+template <class Source, class Predicate>
+typename FilterView<Source, Predicate>::ConstIterator &FilterView<Source, Predicate>::ConstIterator::operator++()
+{
+    ++current;
+    skip();
+    return *this;
+}
+
+template <class Source, class Predicate>
+typename FilterView<Source, Predicate>::ConstIterator FilterView<Source, Predicate>::ConstIterator::operator++(int)
+{
+    ConstIterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <class Source, class Predicate>
+bool FilterView<Source, Predicate>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    return current == other.current;
+}
+
+template <class Source, class Predicate>
+bool FilterView<Source, Predicate>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
+
+template <class Source, class Predicate>
+typename FilterView<Source, Predicate>::ConstIterator FilterView<Source, Predicate>::begin() const
+{
+    return ConstIterator(this, source.begin(), source.end());
+}
+
+template <class Source, class Predicate>
+typename FilterView<Source, Predicate>::ConstIterator FilterView<Source, Predicate>::end() const
+{
+    return ConstIterator(this, source.end(), source.end());
+}
+//* } FilterView
+
+//* { MapView
+template <class Source, class Fn>
+MapView<Source, Fn>::MapView(const Source &source, const Fn &fn)
+    : source(source), fn(fn) {}
+
+template <class Source, class Fn>
+template <class Visitor>
+void MapView<Source, Fn>::forEachBlock(const Visitor &visit) const
+{
+    using S = typename Source::value_type;
+
+    DynamicArray<R, VIEW_BATCH> buffer;
+    source.forEachBlock([this, &visit, &buffer](const S *items, const int count)
+                        {
+        for (int i = 0; i < count; i++)
+        {
+            buffer.append(fn(items[i]));
+            if (buffer.getSize() == VIEW_BATCH)
+            {
+                visit(buffer.getData(), buffer.getSize());
+                buffer.clear();
+            }
+        } });
+    if (buffer.getSize() > 0)
+    {
+        visit(buffer.getData(), buffer.getSize());
+    }
+}
+
+template <class Source, class Fn>
+MapView<Source, Fn>::ConstIterator::ConstIterator(const MapView<Source, Fn> *view, const SourceIterator &current)
+    : view(view), current(current) {}
+
+template <class Source, class Fn>
+typename MapView<Source, Fn>::R MapView<Source, Fn>::ConstIterator::operator*() const
+{
+    return view->fn(*current);
+}
+
+template <class Source, class Fn>
+typename MapView<Source, Fn>::ConstIterator &MapView<Source, Fn>::ConstIterator::operator++()
+{
+    ++current;
+    return *this;
+}
+
+template <class Source, class Fn>
+typename MapView<Source, Fn>::ConstIterator MapView<Source, Fn>::ConstIterator::operator++(int)
+{
+    ConstIterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <class Source, class Fn>
+bool MapView<Source, Fn>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    return current == other.current;
+}
+
+template <class Source, class Fn>
+bool MapView<Source, Fn>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
+
+template <class Source, class Fn>
+typename MapView<Source, Fn>::ConstIterator MapView<Source, Fn>::begin() const
+{
+    return ConstIterator(this, source.begin());
+}
+
+template <class Source, class Fn>
+typename MapView<Source, Fn>::ConstIterator MapView<Source, Fn>::end() const
+{
+    return ConstIterator(this, source.end());
+}
+//* } MapView
+
+//* { ZipView
+template <class First, class Second>
+ZipView<First, Second>::ZipView(const First &first, const Second &second)
+    : first(first), second(second) {}
+
+template <class First, class Second>
+template <class Visitor>
+void ZipView<First, Second>::forEachBlock(const Visitor &visit) const
+{
+    DynamicArray<T, VIEW_BATCH> buffer;
+    for (ConstIterator it = begin(), last = end(); it != last; ++it)
+    {
+        buffer.append(*it);
+        if (buffer.getSize() == VIEW_BATCH)
+        {
+            visit(buffer.getData(), buffer.getSize());
+            buffer.clear();
+        }
+    }
+    if (buffer.getSize() > 0)
+    {
+        visit(buffer.getData(), buffer.getSize());
+    }
+}
+
+template <class First, class Second>
+ZipView<First, Second>::ConstIterator::ConstIterator(const FirstIterator &firstCurrent, const FirstIterator &firstEnd,
+                                                     const SecondIterator &secondCurrent, const SecondIterator &secondEnd)
+    : firstCurrent(firstCurrent), firstEnd(firstEnd), secondCurrent(secondCurrent), secondEnd(secondEnd) {}
+
+template <class First, class Second>
+bool ZipView<First, Second>::ConstIterator::isExhausted() const
+{
+    return firstCurrent == firstEnd || secondCurrent == secondEnd;
+}
+
+template <class First, class Second>
+typename ZipView<First, Second>::T ZipView<First, Second>::ConstIterator::operator*() const
+{
+    return T(*firstCurrent, *secondCurrent);
+}
+
+template <class First, class Second>
+typename ZipView<First, Second>::ConstIterator &ZipView<First, Second>::ConstIterator::operator++()
+{
+    ++firstCurrent;
+    ++secondCurrent;
+    return *this;
+}
+
+template <class First, class Second>
+typename ZipView<First, Second>::ConstIterator ZipView<First, Second>::ConstIterator::operator++(int)
+{
+    ConstIterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <class First, class Second>
+bool ZipView<First, Second>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    bool exhausted = isExhausted();
+    if (exhausted || other.isExhausted())
+    {
+        return exhausted && other.isExhausted();
+    }
+    return firstCurrent == other.firstCurrent && secondCurrent == other.secondCurrent;
+}
+
+template <class First, class Second>
+bool ZipView<First, Second>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
+
+template <class First, class Second>
+typename ZipView<First, Second>::ConstIterator ZipView<First, Second>::begin() const
+{
+    return ConstIterator(first.begin(), first.end(), second.begin(), second.end());
+}
+
+template <class First, class Second>
+typename ZipView<First, Second>::ConstIterator ZipView<First, Second>::end() const
+{
+    return ConstIterator(first.end(), first.end(), second.end(), second.end());
+}
+//* } ZipView
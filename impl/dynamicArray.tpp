@@ -1,11 +1,20 @@
+#include <cstring>
 #include <iostream>
+#include <utility>
 #include "../inc/dynamicArray.hpp"
 
-template <typename T>
-DynamicArray<T>::DynamicArray() : data(new T[1]), size(0), capacity(1) {}
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth>::DynamicArray()
+    : data(nullptr), size(0), capacity(0), inlineData(nullptr), inlineCapacity(0) {}
 
-template <typename T>
-DynamicArray<T>::DynamicArray(const int size) : data(new T[(size > 0 ? size : 1)]), size(size > 0 ? size : 0), capacity((size > 0 ? size : 1))
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth>::DynamicArray(const int inlineCapacity, T *inlineData)
+    : data(inlineData), size(0), capacity(inlineCapacity), inlineData(inlineData), inlineCapacity(inlineCapacity) {}
+
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth>::DynamicArray(const int size)
+    : data(size > 0 ? new T[size] : nullptr), size(size > 0 ? size : 0), capacity(size > 0 ? size : 0),
+      inlineData(nullptr), inlineCapacity(0)
 {
     for (int i = 0; i < size; ++i)
     {
@@ -13,36 +22,93 @@ DynamicArray<T>::DynamicArray(const int size) : data(new T[(size > 0 ? size : 1)
     }
 }
 
-template <typename T>
-DynamicArray<T>::DynamicArray(const T *items, const int count) : data(new T[(count > 0 ? count : 1)]), size(count), capacity(count)
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth>::DynamicArray(const T *items, const int count)
+    : data(nullptr), size(0), capacity(0), inlineData(nullptr), inlineCapacity(0)
 {
     if (!items)
     {
         throw std::invalid_argument("Count must be greater than 0");
     }
-    for (int i = 0; i < count; ++i)
+    appendRange(items, count);
+}
+
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth>::DynamicArray(const DynamicArray<T, 0, Growth> &dynamicArray)
+    : data(dynamicArray.size > 0 ? new T[dynamicArray.size] : nullptr), size(dynamicArray.size), capacity(dynamicArray.size),
+      inlineData(nullptr), inlineCapacity(0)
+{
+    copyItems(data, dynamicArray.data, size);
+}
+
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth>::~DynamicArray()
+{
+    release();
+}
+
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::release()
+{
+    if (data != inlineData)
     {
-        data[i] = items[i];
+        delete[] data;
     }
 }
 
-template <typename T>
-DynamicArray<T>::DynamicArray(const DynamicArray<T> &dynamicArray) : data(new T[dynamicArray.capacity]), size(dynamicArray.size), capacity(dynamicArray.capacity)
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::copyItems(T *dest, const T *source, const int count)
 {
-    for (int i = 0; i < size; ++i)
+    copyItems(dest, source, count, std::is_trivially_copyable<T>());
+}
+
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::copyItems(T *dest, const T *source, const int count, std::true_type)
+{
+    if (count > 0)
+    {
+        std::memcpy(dest, source, sizeof(T) * count);
+    }
+}
+
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::copyItems(T *dest, const T *source, const int count, std::false_type)
+{
+    for (int i = 0; i < count; ++i)
     {
-        data[i] = dynamicArray.data[i];
+        dest[i] = source[i];
     }
 }
 
-template <typename T>
-DynamicArray<T>::~DynamicArray()
+template <typename T, class Growth>
+int DynamicArray<T, 0, Growth>::grownCapacity(const int required) const
 {
-    delete[] data;
+    return Growth::grow(capacity, required);
 }
 
-template <typename T>
-T &DynamicArray<T>::get(const int index)
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::reallocate(const int newCapacity)
+{
+    T *newData = new T[newCapacity];
+    copyItems(newData, data, size);
+    release();
+    data = newData;
+    capacity = newCapacity;
+}
+
+// Gives the slots [from, to) a default value, so slots past the end never hold
+// old items: they neither keep resources alive nor reappear after a resize.
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::resetItems(const int from, const int to)
+{
+    for (int i = from; i < to; ++i)
+    {
+        data[i] = T();
+    }
+}
+
+template <typename T, class Growth>
+T &DynamicArray<T, 0, Growth>::get(const int index)
 {
     if (index < 0 || index >= size)
     {
@@ -51,8 +117,8 @@ T &DynamicArray<T>::get(const int index)
     return data[index];
 }
 
-template <typename T>
-const T &DynamicArray<T>::get(const int index) const
+template <typename T, class Growth>
+const T &DynamicArray<T, 0, Growth>::get(const int index) const
 {
     if (index < 0 || index >= size)
     {
@@ -61,8 +127,32 @@ const T &DynamicArray<T>::get(const int index) const
     return data[index];
 }
 
-template <typename T>
-T &DynamicArray<T>::getFirst()
+template <typename T, class Growth>
+T &DynamicArray<T, 0, Growth>::at(const int index)
+{
+    return get(index);
+}
+
+template <typename T, class Growth>
+const T &DynamicArray<T, 0, Growth>::at(const int index) const
+{
+    return get(index);
+}
+
+template <typename T, class Growth>
+T &DynamicArray<T, 0, Growth>::unsafeGet(const int index)
+{
+    return data[index];
+}
+
+template <typename T, class Growth>
+const T &DynamicArray<T, 0, Growth>::unsafeGet(const int index) const
+{
+    return data[index];
+}
+
+template <typename T, class Growth>
+T &DynamicArray<T, 0, Growth>::getFirst()
 {
     if (size == 0)
     {
@@ -72,8 +162,8 @@ T &DynamicArray<T>::getFirst()
     return data[0];
 }
 
-template <typename T>
-const T &DynamicArray<T>::getFirst() const
+template <typename T, class Growth>
+const T &DynamicArray<T, 0, Growth>::getFirst() const
 {
     if (size == 0)
     {
@@ -83,8 +173,8 @@ const T &DynamicArray<T>::getFirst() const
     return data[0];
 }
 
-template <typename T>
-T &DynamicArray<T>::getLast()
+template <typename T, class Growth>
+T &DynamicArray<T, 0, Growth>::getLast()
 {
     if (size == 0)
     {
@@ -94,8 +184,8 @@ T &DynamicArray<T>::getLast()
     return data[size - 1];
 }
 
-template <typename T>
-const T &DynamicArray<T>::getLast() const
+template <typename T, class Growth>
+const T &DynamicArray<T, 0, Growth>::getLast() const
 {
     if (size == 0)
     {
@@ -105,47 +195,64 @@ const T &DynamicArray<T>::getLast() const
     return data[size - 1];
 }
 
-template <typename T>
-int DynamicArray<T>::getSize() const
+template <typename T, class Growth>
+int DynamicArray<T, 0, Growth>::getSize() const
 {
     return size;
 }
 
-template <class T>
-void DynamicArray<T>::append(const T &item)
+template <typename T, class Growth>
+int DynamicArray<T, 0, Growth>::getCapacity() const
+{
+    return capacity;
+}
+
+// Heap bytes held by the array; an inline buffer is part of the object itself.
+template <typename T, class Growth>
+size_t DynamicArray<T, 0, Growth>::getMemoryUsage() const
+{
+    return data != inlineData ? sizeof(T) * static_cast<size_t>(capacity) : 0;
+}
+
+template <typename T, class Growth>
+T *DynamicArray<T, 0, Growth>::getData()
+{
+    return data;
+}
+
+template <typename T, class Growth>
+const T *DynamicArray<T, 0, Growth>::getData() const
+{
+    return data;
+}
+
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::append(const T &item)
 {
     if (size >= capacity)
     {
-        int newCapacity = capacity == 0 ? 1 : capacity * 2;
-        T *newData = new T[newCapacity];
-        for (int i = 0; i < size; ++i)
-        {
-            newData[i] = data[i];
-        }
-        for (int i = size; i < newCapacity; ++i)
-        {
-            newData[i] = T();
-        }
-        delete[] data;
-        data = newData;
-        capacity = newCapacity;
+        T copy = item;
+        reallocate(grownCapacity(size + 1));
+        data[size] = copy;
+        size++;
+        return;
     }
     data[size] = item;
     size++;
 }
 
-template <class T>
-void DynamicArray<T>::prepend(const T &item)
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::prepend(const T &item)
 {
     if (size >= capacity)
     {
-        int newCapacity = capacity == 0 ? 1 : capacity * 2;
+        int newCapacity = grownCapacity(size + 1);
         T *newData = new T[newCapacity];
         for (int i = 0; i < size; ++i)
         {
             newData[i + 1] = data[i];
         }
-        delete[] data;
+        release();
         data = newData;
         capacity = newCapacity;
     }
@@ -161,8 +268,8 @@ void DynamicArray<T>::prepend(const T &item)
     size++;
 }
 
-template <typename T>
-void DynamicArray<T>::set(const int index, const T &value)
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::set(const int index, const T &value)
 {
     if (index < 0 || index >= size)
     {
@@ -171,8 +278,8 @@ void DynamicArray<T>::set(const int index, const T &value)
     data[index] = value;
 }
 
-template <class T>
-void DynamicArray<T>::insertAt(const T &item, int index)
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::insertAt(const T &item, int index)
 {
 
     if (index < 0 || index > size)
@@ -209,8 +316,24 @@ void DynamicArray<T>::insertAt(const T &item, int index)
     data[index] = item;
 }
 
-template <typename T>
-void DynamicArray<T>::resize(const int newSize)
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::removeAt(const int index)
+{
+    if (index < 0 || index >= size)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    for (int i = index; i + 1 < size; i++)
+    {
+        data[i] = std::move(data[i + 1]);
+    }
+    size--;
+    resetItems(size, size + 1);
+}
+
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::resize(const int newSize)
 {
     if (newSize < 0)
     {
@@ -219,32 +342,133 @@ void DynamicArray<T>::resize(const int newSize)
 
     if (newSize > capacity)
     {
-        int newCapacity = capacity * 2;
-        while (newCapacity < newSize)
-        {
-            newCapacity *= 2;
-        }
+        reallocate(grownCapacity(newSize));
+    }
+    if (newSize > size)
+    {
+        resetItems(size, newSize);
+    }
+    else
+    {
+        resetItems(newSize, size);
+    }
 
-        T *newData = new T[newCapacity];
-        for (int i = 0; i < size; ++i)
-        {
-            newData[i] = data[i];
-        }
-        for (int i = size; i < newSize; ++i)
-        {
-            newData[i] = T();
-        }
+    size = newSize;
+}
 
-        delete[] data;
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::reserve(const int newCapacity)
+{
+    if (newCapacity < 0)
+    {
+        throw std::invalid_argument("Invalid capacity");
+    }
+
+    if (newCapacity > capacity)
+    {
+        reallocate(newCapacity);
+    }
+}
+
+// Releases unused capacity, moving the items back into the inline buffer when they fit.
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::shrinkToFit()
+{
+    if (data == inlineData || size == capacity)
+    {
+        return;
+    }
+
+    if (size <= inlineCapacity)
+    {
+        copyItems(inlineData, data, size);
+        release();
+        data = inlineData;
+        capacity = inlineCapacity;
+        return;
+    }
+
+    reallocate(size);
+}
+
+template <typename T, class Growth>
+template <class InputIt>
+void DynamicArray<T, 0, Growth>::assign(InputIt first, InputIt last)
+{
+    clear();
+    appendRange(first, last);
+}
+
+template <typename T, class Growth>
+template <class InputIt>
+void DynamicArray<T, 0, Growth>::appendRange(InputIt first, InputIt last)
+{
+    appendRange(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+}
+
+template <typename T, class Growth>
+template <class InputIt>
+void DynamicArray<T, 0, Growth>::appendRange(InputIt first, InputIt last, std::input_iterator_tag)
+{
+    for (; first != last; ++first)
+    {
+        append(*first);
+    }
+}
+
+template <typename T, class Growth>
+template <class ForwardIt>
+void DynamicArray<T, 0, Growth>::appendRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    int count = static_cast<int>(std::distance(first, last));
+    if (size + count > capacity)
+    {
+        reallocate(grownCapacity(size + count));
+    }
+
+    for (; first != last; ++first)
+    {
+        data[size++] = *first;
+    }
+}
+
+// items may point into this array, so the old buffer is released only after the copy.
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::appendRange(const T *items, const int count)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Negative count");
+    }
+    if (count == 0)
+    {
+        return;
+    }
+    if (!items)
+    {
+        throw std::invalid_argument("Null array with non-zero count");
+    }
+
+    if (size + count > capacity)
+    {
+        int newCapacity = grownCapacity(size + count);
+        T *newData = new T[newCapacity];
+        copyItems(newData, data, size);
+        copyItems(newData + size, items, count);
+        release();
         data = newData;
         capacity = newCapacity;
     }
+    else
+    {
+        copyItems(data + size, items, count);
+    }
 
-    size = newSize;
+    size += count;
 }
 
-template <typename T>
-DynamicArray<T> *DynamicArray<T>::getSubArray(const int startIndex, const int endIndex)
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth> *DynamicArray<T, 0, Growth>::getSubArray(const int startIndex, const int endIndex)
 {
     if (startIndex < 0 || endIndex >= size || startIndex > endIndex)
     {
@@ -253,20 +477,11 @@ DynamicArray<T> *DynamicArray<T>::getSubArray(const int startIndex, const int en
 
     int subLength = endIndex - startIndex + 1;
 
-    DynamicArray<T> *result = new DynamicArray<T>(subLength);
-    result->size = subLength;
-    result->capacity = subLength;
-
-    for (int i = startIndex; i <= endIndex; i++)
-    {
-        result->data[i - startIndex] = data[i];
-    }
-
-    return result;
+    return new DynamicArray<T, 0, Growth>(data + startIndex, subLength);
 }
 
-template <typename T>
-void DynamicArray<T>::print() const
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::print() const
 {
     for (int i = 0; i < size; i++)
     {
@@ -279,87 +494,136 @@ void DynamicArray<T>::print() const
     }
 }
 
-template <class T>
-void DynamicArray<T>::clear()
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::clear()
 {
-    T *newData = new T[1];
-    delete[] data;
-    data = newData;
+    resetItems(0, size);
     size = 0;
-    capacity = 1;
 }
 
-template <typename T>
-DynamicArray<T> *DynamicArray<T>::concatImmutable(DynamicArray<T> *dynamicArray)
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth> *DynamicArray<T, 0, Growth>::concatImmutable(DynamicArray<T, 0, Growth> *dynamicArray)
 {
     if (!dynamicArray)
     {
-        DynamicArray<T> *result = new DynamicArray<T>(*this);
+        DynamicArray<T, 0, Growth> *result = new DynamicArray<T, 0, Growth>(*this);
         return result;
     }
-    DynamicArray<T> *result = new DynamicArray<T>(*this);
+    DynamicArray<T, 0, Growth> *result = new DynamicArray<T, 0, Growth>(*this);
     result->concat(dynamicArray);
     return result;
 }
 
-template <typename T>
-void DynamicArray<T>::concat(DynamicArray<T> *dynamicArray)
+template <typename T, class Growth>
+void DynamicArray<T, 0, Growth>::concat(DynamicArray<T, 0, Growth> *dynamicArray)
 {
     if (!dynamicArray)
     {
         return;
     }
 
-    int oldSize = size;
-    resize(size + dynamicArray->size);
-
-    for (int i = 0; i < dynamicArray->size; i++)
-    {
-        data[oldSize + i] = dynamicArray->data[i];
-    }
+    appendRange(dynamicArray->data, dynamicArray->size);
 }
 
-template <typename T>
-DynamicArray<T> &DynamicArray<T>::operator=(const DynamicArray<T> &other)
+template <typename T, class Growth>
+DynamicArray<T, 0, Growth> &DynamicArray<T, 0, Growth>::operator=(const DynamicArray<T, 0, Growth> &other)
 {
     if (this == &other)
     {
         return *this;
     }
 
-    if (size != other.size)
+    if (other.size > capacity)
     {
-        delete[] data;
-        data = new T[other.size];
-        size = other.size;
+        T *newData = new T[other.size];
+        release();
+        data = newData;
+        capacity = other.size;
     }
 
-    capacity = other.capacity;
-
-    for (int i = 0; i < size; i++)
-    {
-        data[i] = other.data[i];
-    }
+    resetItems(other.size, size);
+    size = other.size;
+    copyItems(data, other.data, size);
 
     return *this;
 }
 
-template <typename T>
-T &DynamicArray<T>::operator[](int index)
+template <typename T, class Growth>
+T &DynamicArray<T, 0, Growth>::operator[](int index)
 {
+#if SEQUENCE_BOUNDS_CHECK
     if (index < 0 || index >= size)
     {
         throw std::out_of_range("Index out of range");
     }
+#endif
     return data[index];
 }
 
-template <typename T>
-const T &DynamicArray<T>::operator[](int index) const
+template <typename T, class Growth>
+const T &DynamicArray<T, 0, Growth>::operator[](int index) const
 {
+#if SEQUENCE_BOUNDS_CHECK
     if (index < 0 || index >= size)
     {
         throw std::out_of_range("Index out of range");
     }
+#endif
     return data[index];
 }
+
+//* { Inline storage
+template <typename T, int InlineCapacity, class Growth>
+DynamicArray<T, InlineCapacity, Growth>::DynamicArray()
+    : DynamicArray<T, 0, Growth>(InlineCapacity, buffer) {}
+
+template <typename T, int InlineCapacity, class Growth>
+DynamicArray<T, InlineCapacity, Growth>::DynamicArray(const int size)
+    : DynamicArray<T, 0, Growth>(InlineCapacity, buffer)
+{
+    this->resize(size > 0 ? size : 0);
+    for (int i = 0; i < size; ++i)
+    {
+        this->unsafeGet(i) = T();
+    }
+}
+
+template <typename T, int InlineCapacity, class Growth>
+DynamicArray<T, InlineCapacity, Growth>::DynamicArray(const T *items, const int count)
+    : DynamicArray<T, 0, Growth>(InlineCapacity, buffer)
+{
+    if (!items)
+    {
+        throw std::invalid_argument("Count must be greater than 0");
+    }
+    this->appendRange(items, count);
+}
+
+template <typename T, int InlineCapacity, class Growth>
+DynamicArray<T, InlineCapacity, Growth>::DynamicArray(const DynamicArray<T, InlineCapacity, Growth> &other)
+    : DynamicArray<T, 0, Growth>(InlineCapacity, buffer)
+{
+    DynamicArray<T, 0, Growth>::operator=(other);
+}
+
+template <typename T, int InlineCapacity, class Growth>
+DynamicArray<T, InlineCapacity, Growth>::DynamicArray(const DynamicArray<T, 0, Growth> &other)
+    : DynamicArray<T, 0, Growth>(InlineCapacity, buffer)
+{
+    DynamicArray<T, 0, Growth>::operator=(other);
+}
+
+template <typename T, int InlineCapacity, class Growth>
+DynamicArray<T, InlineCapacity, Growth> &DynamicArray<T, InlineCapacity, Growth>::operator=(const DynamicArray<T, InlineCapacity, Growth> &other)
+{
+    DynamicArray<T, 0, Growth>::operator=(other);
+    return *this;
+}
+
+template <typename T, int InlineCapacity, class Growth>
+DynamicArray<T, InlineCapacity, Growth> &DynamicArray<T, InlineCapacity, Growth>::operator=(const DynamicArray<T, 0, Growth> &other)
+{
+    DynamicArray<T, 0, Growth>::operator=(other);
+    return *this;
+}
+//* } Inline storage
@@ -0,0 +1,131 @@
+#include <stdexcept>
+#include "../inc/fenwickTree.hpp"
+
+template <typename T>
+FenwickTree<T>::FenwickTree() : tree(1), count(0) {}
+
+template <typename T>
+void FenwickTree<T>::rebuild(const T *values, const int count)
+{
+    rebuild(count, [values](const int i)
+            { return values[i]; });
+}
+
+// Fills the tree straight from valueAt(0...count-1), so no copy of the values
+// is needed.
+template <typename T>
+template <class ValueAt>
+void FenwickTree<T>::rebuild(const int count, const ValueAt &valueAt)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Count cannot be negative");
+    }
+
+    tree.resize(count + 1);
+    this->count = count;
+    tree.unsafeGet(0) = T();
+    for (int i = 1; i <= count; i++)
+    {
+        tree.unsafeGet(i) = valueAt(i - 1);
+    }
+    for (int i = 1; i <= count; i++)
+    {
+        int parent = i + (i & -i);
+        if (parent <= count)
+        {
+            tree.unsafeGet(parent) += tree.unsafeGet(i);
+        }
+    }
+}
+
+template <typename T>
+void FenwickTree<T>::push(const T &value)
+{
+    int node = count + 1;
+    // The new node covers (node - lowbit(node), node], i.e. the value plus the
+    // tail of the existing prefix that falls inside that range.
+    T covered = value + prefixSum(count) - prefixSum(node - (node & -node));
+    tree.append(covered);
+    count++;
+}
+
+template <typename T>
+void FenwickTree<T>::add(const int index, const T &delta)
+{
+    if (index < 0 || index >= count)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    for (int node = index + 1; node <= count; node += node & -node)
+    {
+        tree.unsafeGet(node) += delta;
+    }
+}
+
+template <typename T>
+void FenwickTree<T>::clear()
+{
+    tree.resize(1);
+    tree.unsafeGet(0) = T();
+    count = 0;
+}
+
+template <typename T>
+T FenwickTree<T>::prefixSum(const int length) const
+{
+    if (length < 0 || length > count)
+    {
+        throw std::out_of_range("Length out of range");
+    }
+
+    T sum = T();
+    for (int node = length; node > 0; node -= node & -node)
+    {
+        sum += tree.unsafeGet(node);
+    }
+    return sum;
+}
+
+template <typename T>
+T FenwickTree<T>::get(const int index) const
+{
+    if (index < 0 || index >= count)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+    return prefixSum(index + 1) - prefixSum(index);
+}
+
+// Returns the entry whose range contains position and stores the position
+// relative to that entry's start in offset. Zero-sized entries are skipped.
+template <typename T>
+int FenwickTree<T>::find(const T &position, T &offset) const
+{
+    int step = 1;
+    while (step * 2 <= count)
+    {
+        step *= 2;
+    }
+
+    int node = 0;
+    T rest = position;
+    for (; step > 0; step /= 2)
+    {
+        if (node + step <= count && !(rest < tree.unsafeGet(node + step)))
+        {
+            node += step;
+            rest -= tree.unsafeGet(node);
+        }
+    }
+
+    offset = rest;
+    return node;
+}
+
+template <typename T>
+int FenwickTree<T>::getSize() const
+{
+    return count;
+}
@@ -0,0 +1,358 @@
+#include <utility>
+#include <vector>
+#include "../inc/groupBy.hpp"
+
+template <class Key, class R>
+std::ostream &operator<<(std::ostream &os, const Group<Key, R> &group)
+{
+    return os << group.key << ": " << group.value;
+}
+
+//* { Aggregates
+template <class T>
+int CountAggregate::first(const T &) const
+{
+    return 1;
+}
+
+template <class T>
+void CountAggregate::add(int &state, const T &) const
+{
+    state++;
+}
+
+inline void CountAggregate::merge(int &into, const int &from) const
+{
+    into += from;
+}
+
+template <class ValueFn>
+template <class T>
+typename SumAggregate<ValueFn>::template Result<T> SumAggregate<ValueFn>::first(const T &item) const
+{
+    return value(item);
+}
+
+template <class ValueFn>
+template <class T>
+void SumAggregate<ValueFn>::add(Result<T> &state, const T &item) const
+{
+    state += value(item);
+}
+
+template <class ValueFn>
+template <class R>
+void SumAggregate<ValueFn>::merge(R &into, const R &from) const
+{
+    into += from;
+}
+
+template <class ValueFn, class Compare>
+template <class T>
+typename ExtremeAggregate<ValueFn, Compare>::template Result<T> ExtremeAggregate<ValueFn, Compare>::first(const T &item) const
+{
+    return value(item);
+}
+
+// Replaces the state only when strictly better, so the earliest extreme stays.
+template <class ValueFn, class Compare>
+template <class T>
+void ExtremeAggregate<ValueFn, Compare>::add(Result<T> &state, const T &item) const
+{
+    Result<T> candidate = value(item);
+    if (compare(candidate, state))
+    {
+        state = std::move(candidate);
+    }
+}
+
+template <class ValueFn, class Compare>
+template <class R>
+void ExtremeAggregate<ValueFn, Compare>::merge(R &into, const R &from) const
+{
+    if (compare(from, into))
+    {
+        into = from;
+    }
+}
+
+template <class R, class StepFn, class CombineFn>
+template <class T>
+R CustomAggregate<R, StepFn, CombineFn>::first(const T &item) const
+{
+    return step(init, item);
+}
+
+template <class R, class StepFn, class CombineFn>
+template <class T>
+void CustomAggregate<R, StepFn, CombineFn>::add(R &state, const T &item) const
+{
+    state = step(state, item);
+}
+
+template <class R, class StepFn, class CombineFn>
+void CustomAggregate<R, StepFn, CombineFn>::merge(R &into, const R &from) const
+{
+    into = combine(into, from);
+}
+
+inline CountAggregate countAggregate()
+{
+    return CountAggregate();
+}
+
+template <class ValueFn>
+SumAggregate<ValueFn> sumAggregate(const ValueFn &value)
+{
+    return SumAggregate<ValueFn>{value};
+}
+
+template <class ValueFn>
+ExtremeAggregate<ValueFn, std::less<>> minAggregate(const ValueFn &value)
+{
+    return ExtremeAggregate<ValueFn, std::less<>>{value, std::less<>()};
+}
+
+template <class ValueFn>
+ExtremeAggregate<ValueFn, std::greater<>> maxAggregate(const ValueFn &value)
+{
+    return ExtremeAggregate<ValueFn, std::greater<>>{value, std::greater<>()};
+}
+
+template <class R, class StepFn, class CombineFn>
+CustomAggregate<R, StepFn, CombineFn> customAggregate(const R &init, const StepFn &step, const CombineFn &combine)
+{
+    return CustomAggregate<R, StepFn, CombineFn>{init, step, combine};
+}
+//* } Aggregates
+
+//* { GroupTable
+template <class Key, class R>
+GroupTable<Key, R>::GroupTable()
+    : slots(16), mask(15)
+{
+    for (int i = 0; i < slots.getSize(); i++)
+    {
+        slots.unsafeGet(i) = -1;
+    }
+}
+
+template <class Key, class R>
+uint64_t GroupTable<Key, R>::firstSlot(const uint64_t hash) const
+{
+    return (hash ^ (hash >> 32)) & mask;
+}
+
+// First empty slot on the probe path of hash.
+template <class Key, class R>
+int GroupTable<Key, R>::freeSlot(const uint64_t hash) const
+{
+    uint64_t slot = firstSlot(hash);
+    while (slots.unsafeGet(static_cast<int>(slot)) >= 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return static_cast<int>(slot);
+}
+
+// Appends a group whose key is not in the table yet at slot, which ends its
+// probe path. Keeps the slots at most half full so probe runs stay short.
+template <class Key, class R>
+void GroupTable<Key, R>::add(Group<Key, R> &&group, const uint64_t hash, int slot)
+{
+    if ((entries.size() + 1) * 2 > static_cast<size_t>(slots.getSize()))
+    {
+        grow();
+        slot = freeSlot(hash);
+    }
+    entries.push_back(std::move(group));
+    hashes.push_back(hash);
+    slots.unsafeGet(slot) = static_cast<int>(entries.size()) - 1;
+}
+
+// Doubles the slot array and reinserts the entries by their stored hashes.
+template <class Key, class R>
+void GroupTable<Key, R>::grow()
+{
+    slots.resize(slots.getSize() * 2);
+    mask = static_cast<uint64_t>(slots.getSize() - 1);
+    for (int i = 0; i < slots.getSize(); i++)
+    {
+        slots.unsafeGet(i) = -1;
+    }
+    for (int entry = 0; entry < static_cast<int>(hashes.size()); entry++)
+    {
+        slots.unsafeGet(freeSlot(hashes[entry])) = entry;
+    }
+}
+
+// The probe loop lives here rather than in a helper so that the common case,
+// an existing group, compiles into the caller's loop over the items.
+template <class Key, class R>
+template <class Make, class Update>
+void GroupTable<Key, R>::upsert(const Key &key, const Make &make, const Update &update)
+{
+    uint64_t hash = mixHash(hasher(key));
+    uint64_t slot = firstSlot(hash);
+    while (true)
+    {
+        int entry = slots.unsafeGet(static_cast<int>(slot));
+        if (entry < 0)
+        {
+            break;
+        }
+        if (hashes[entry] == hash && entries[entry].key == key)
+        {
+            update(entries[entry].value);
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    add(Group<Key, R>{key, make()}, hash, static_cast<int>(slot));
+}
+
+template <class Key, class R>
+const R *GroupTable<Key, R>::find(const Key &key) const
+{
+    uint64_t hash = mixHash(hasher(key));
+    for (uint64_t slot = firstSlot(hash);; slot = (slot + 1) & mask)
+    {
+        int entry = slots.unsafeGet(static_cast<int>(slot));
+        if (entry < 0)
+        {
+            return nullptr;
+        }
+        if (hashes[entry] == hash && entries[entry].key == key)
+        {
+            return &entries[entry].value;
+        }
+    }
+}
+
+template <class Key, class R>
+template <class Merge>
+void GroupTable<Key, R>::merge(GroupTable<Key, R> &other, const Merge &mergeStates)
+{
+    for (int entry = 0; entry < other.getSize(); entry++)
+    {
+        Group<Key, R> &group = other.entries[entry];
+        uint64_t hash = other.hashes[entry];
+        uint64_t slot = firstSlot(hash);
+        int found;
+        while ((found = slots.unsafeGet(static_cast<int>(slot))) >= 0 &&
+               !(hashes[found] == hash && entries[found].key == group.key))
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        if (found >= 0)
+        {
+            mergeStates(entries[found].value, group.value);
+        }
+        else
+        {
+            add(std::move(group), hash, static_cast<int>(slot));
+        }
+    }
+    other = GroupTable<Key, R>();
+}
+
+template <class Key, class R>
+int GroupTable<Key, R>::getSize() const
+{
+    return static_cast<int>(entries.size());
+}
+
+template <class Key, class R>
+const Group<Key, R> &GroupTable<Key, R>::groupAt(const int entry) const
+{
+    return entries[entry];
+}
+//* } GroupTable
+
+template <typename T, class KeyFn>
+GroupBy<T, KeyFn>::GroupBy(const Sequence<T> *source, const KeyFn &keyFn, const int segmentSize)
+    : source(source), keyFn(keyFn), segmentSize(segmentSize) {}
+
+template <typename T, class KeyFn>
+template <class Aggregate>
+void GroupBy<T, KeyFn>::aggregateRange(GroupTable<Key, typename Aggregate::template Result<T>> &table,
+                                       const Aggregate &aggregate, const int startIndex, const int count) const
+{
+    using State = typename Aggregate::template Result<T>;
+
+    auto visitor = makeBlockVisitor<T>([this, &table, &aggregate](const T *items, const int length)
+                                       {
+        for (int i = 0; i < length; i++)
+        {
+            const T &item = items[i];
+            table.upsert(keyFn(item), [&aggregate, &item]()
+                         { return aggregate.first(item); },
+                         [&aggregate, &item](State &state)
+                         { aggregate.add(state, item); });
+        } });
+    source->visitBlocks(startIndex, count, visitor);
+}
+
+template <typename T, class KeyFn>
+template <class Aggregate>
+typename GroupBy<T, KeyFn>::template Result<Aggregate> *GroupBy<T, KeyFn>::aggregate(const Aggregate &aggregate, const int threadCount) const
+{
+    using State = typename Aggregate::template Result<T>;
+    using Table = GroupTable<Key, State>;
+
+    int length = source->getLength();
+    int parts = parallelPartCount(length, threadCount);
+    std::vector<Table> tables(parts);
+    parallelRanges(length, parts, [&](const int part, const int start, const int end)
+                   { aggregateRange(tables[part], aggregate, start, end - start); });
+
+    // Merging in part order keeps the groups in order of first appearance.
+    for (int part = 1; part < parts; part++)
+    {
+        tables[0].merge(tables[part], [&aggregate](State &into, const State &from)
+                        { aggregate.merge(into, from); });
+    }
+
+    const Table &groups = tables[0];
+    Result<Aggregate> *result = new Result<Aggregate>(segmentSize);
+    result->reserve(groups.getSize());
+    for (int entry = 0; entry < groups.getSize(); entry++)
+    {
+        result->append(groups.groupAt(entry));
+    }
+    return result;
+}
+
+template <typename T, class KeyFn>
+typename GroupBy<T, KeyFn>::template Result<CountAggregate> *GroupBy<T, KeyFn>::count(const int threadCount) const
+{
+    return aggregate(countAggregate(), threadCount);
+}
+
+template <typename T, class KeyFn>
+template <class ValueFn>
+typename GroupBy<T, KeyFn>::template Result<SumAggregate<ValueFn>> *GroupBy<T, KeyFn>::sum(const ValueFn &value, const int threadCount) const
+{
+    return aggregate(sumAggregate(value), threadCount);
+}
+
+template <typename T, class KeyFn>
+template <class ValueFn>
+typename GroupBy<T, KeyFn>::template Result<ExtremeAggregate<ValueFn, std::less<>>> *GroupBy<T, KeyFn>::min(const ValueFn &value, const int threadCount) const
+{
+    return aggregate(minAggregate(value), threadCount);
+}
+
+template <typename T, class KeyFn>
+template <class ValueFn>
+typename GroupBy<T, KeyFn>::template Result<ExtremeAggregate<ValueFn, std::greater<>>> *GroupBy<T, KeyFn>::max(const ValueFn &value, const int threadCount) const
+{
+    return aggregate(maxAggregate(value), threadCount);
+}
+
+template <typename T, class KeyFn>
+GroupBy<T, KeyFn> groupBy(const Sequence<T> &source, const KeyFn &keyFn)
+{
+    return GroupBy<T, KeyFn>(&source, keyFn);
+}
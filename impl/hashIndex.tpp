@@ -0,0 +1,518 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "../inc/hashIndex.hpp"
+
+template <typename T, class KeyFn>
+HashIndex<T, KeyFn>::HashIndex(SegmentedDeque<T> &deque, const KeyFn &keyFn)
+    : deque(&deque), keyFn(keyFn), groupMask(0), live(0), used(0), base(0), stale(true), replacingPending(false)
+{
+    deque.addObserver(this);
+}
+
+template <typename T, class KeyFn>
+HashIndex<T, KeyFn>::~HashIndex()
+{
+    if (deque)
+    {
+        deque->removeObserver(this);
+    }
+}
+
+// Bit i is set when group[i] == tag.
+template <typename T, class KeyFn>
+unsigned HashIndex<T, KeyFn>::matchTag(const int8_t *group, const int8_t tag)
+{
+#if defined(__SSE2__)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag))));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HASH_INDEX_GROUP_SIZE; i++)
+    {
+        mask |= static_cast<unsigned>(group[i] == tag) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i is set when slot i is empty or deleted; only those have the sign bit.
+template <typename T, class KeyFn>
+unsigned HashIndex<T, KeyFn>::matchFree(const int8_t *group)
+{
+#if defined(__SSE2__)
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HASH_INDEX_GROUP_SIZE; i++)
+    {
+        mask |= static_cast<unsigned>(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+template <typename T, class KeyFn>
+int HashIndex<T, KeyFn>::lowestBit(const unsigned mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & (1u << bit)))
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+template <typename T, class KeyFn>
+const T &HashIndex<T, KeyFn>::itemAt(const int index) const
+{
+    const SegmentedDeque<T> &source = *deque;
+    return source.unsafeGet(index);
+}
+
+// The top seven bits of the mixed hash become the tag, the low bits pick the
+// group where probing starts.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::hashOf(const Key &key, int &group, int8_t &tag) const
+{
+    uint64_t hash = mixHash(hasher(key));
+    tag = static_cast<int8_t>(hash >> 57);
+    group = static_cast<int>((hash ^ (hash >> 32)) & static_cast<uint64_t>(groupMask));
+}
+
+// Keeps at least one free slot in eight, so every probe reaches an empty slot.
+template <typename T, class KeyFn>
+bool HashIndex<T, KeyFn>::hasRoomFor(const int count) const
+{
+    return static_cast<long long>(used + count) * 8 <= static_cast<long long>(control.getSize()) * 7;
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::insertEntry(const Key &key, const int index) const
+{
+    int group;
+    int8_t tag;
+    hashOf(key, group, tag);
+    for (int step = 1;; step++)
+    {
+        unsigned free = matchFree(control.getData() + group * HASH_INDEX_GROUP_SIZE);
+        if (free)
+        {
+            int slot = group * HASH_INDEX_GROUP_SIZE + lowestBit(free);
+            if (control.unsafeGet(slot) == CONTROL_EMPTY)
+            {
+                used++;
+            }
+            control.unsafeGet(slot) = tag;
+            positions.unsafeGet(slot) = index + base;
+            live++;
+            return;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+template <typename T, class KeyFn>
+bool HashIndex<T, KeyFn>::eraseEntry(const Key &key, const int index) const
+{
+    int group;
+    int8_t tag;
+    hashOf(key, group, tag);
+    for (int step = 1;; step++)
+    {
+        const int8_t *bytes = control.getData() + group * HASH_INDEX_GROUP_SIZE;
+        for (unsigned matches = matchTag(bytes, tag); matches; matches &= matches - 1)
+        {
+            int slot = group * HASH_INDEX_GROUP_SIZE + lowestBit(matches);
+            if (positions.unsafeGet(slot) == index + base)
+            {
+                control.unsafeGet(slot) = CONTROL_DELETED;
+                live--;
+                return true;
+            }
+        }
+        if (matchTag(bytes, CONTROL_EMPTY))
+        {
+            return false;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+template <typename T, class KeyFn>
+template <class Visitor>
+void HashIndex<T, KeyFn>::probe(const Key &key, const Visitor &visit) const
+{
+    int group;
+    int8_t tag;
+    hashOf(key, group, tag);
+    for (int step = 1;; step++)
+    {
+        const int8_t *bytes = control.getData() + group * HASH_INDEX_GROUP_SIZE;
+        for (unsigned matches = matchTag(bytes, tag); matches; matches &= matches - 1)
+        {
+            int index = positions.unsafeGet(group * HASH_INDEX_GROUP_SIZE + lowestBit(matches)) - base;
+            if (keyFn(itemAt(index)) == key && !visit(index))
+            {
+                return;
+            }
+        }
+        if (matchTag(bytes, CONTROL_EMPTY))
+        {
+            return;
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+// Removes the entries of items at one end of the deque before they go; anything
+// else, or more than half of the entries, is cheaper to rebuild. Items of
+// touched segments have no entry left, only their pending positions.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::eraseRange(const int index, const int count)
+{
+    int length = deque->getLength();
+    if ((index != 0 && index + count != length) || count * 2 > live)
+    {
+        stale = true;
+        return;
+    }
+
+    for (int i = index; i < index + count; i++)
+    {
+        if (!eraseEntry(keyFn(itemAt(i)), i) && pending.getSize() == 0)
+        {
+            stale = true;
+            return;
+        }
+    }
+    dropPending(index, count);
+    if (index == 0)
+    {
+        base += count;
+    }
+}
+
+// Takes the positions of count items from index on out of the pending ranges,
+// as those items are leaving.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::dropPending(const int index, const int count)
+{
+    if (pending.getSize() == 0)
+    {
+        return;
+    }
+
+    int first = index + base;
+    int end = first + count;
+    DynamicArray<int> kept;
+    for (int i = 0; i < pending.getSize(); i += 2)
+    {
+        int rangeFirst = pending.unsafeGet(i);
+        int rangeEnd = pending.unsafeGet(i + 1);
+        if (rangeFirst < first)
+        {
+            kept.append(rangeFirst);
+            kept.append(std::min(rangeEnd, first));
+        }
+        if (end < rangeEnd)
+        {
+            kept.append(std::max(rangeFirst, end));
+            kept.append(rangeEnd);
+        }
+    }
+    pending = kept;
+}
+
+// Puts the entries of the items of touched segments back under their current
+// keys. Ranges of a segment touched again after a reshape may overlap, so they
+// are merged first.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::reinsertPending() const
+{
+    std::vector<std::pair<int, int>> ranges;
+    for (int i = 0; i < pending.getSize(); i += 2)
+    {
+        ranges.emplace_back(pending.unsafeGet(i), pending.unsafeGet(i + 1));
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    int count = 0;
+    int merged = 0;
+    for (const std::pair<int, int> &range : ranges)
+    {
+        if (merged > 0 && range.first <= ranges[merged - 1].second)
+        {
+            ranges[merged - 1].second = std::max(ranges[merged - 1].second, range.second);
+        }
+        else
+        {
+            ranges[merged++] = range;
+        }
+    }
+    ranges.resize(merged);
+    for (const std::pair<int, int> &range : ranges)
+    {
+        count += range.second - range.first;
+    }
+
+    if (!hasRoomFor(count))
+    {
+        rebuild();
+        return;
+    }
+    for (const std::pair<int, int> &range : ranges)
+    {
+        for (int position = range.first; position < range.second; position++)
+        {
+            insertEntry(keyFn(itemAt(position - base)), position - base);
+        }
+    }
+    pending.clear();
+    touched.clear();
+}
+
+// Sizes the table to at most half full and inserts every item in one pass.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::rebuild() const
+{
+    int length = deque->getLength();
+    int groups = 1;
+    while (groups * HASH_INDEX_GROUP_SIZE < length * 2)
+    {
+        groups *= 2;
+    }
+
+    control.resize(groups * HASH_INDEX_GROUP_SIZE);
+    positions.resize(groups * HASH_INDEX_GROUP_SIZE);
+    for (int i = 0; i < control.getSize(); i++)
+    {
+        control.unsafeGet(i) = CONTROL_EMPTY;
+    }
+    groupMask = groups - 1;
+    live = 0;
+    used = 0;
+    base = 0;
+
+    int index = 0;
+    const SegmentedDeque<T> &source = *deque;
+    source.forEachBlock([this, &index](const T *items, const int count)
+                        {
+        for (int i = 0; i < count; i++)
+        {
+            insertEntry(keyFn(items[i]), index++);
+        } });
+    stale = false;
+    pending.clear();
+    touched.clear();
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::refresh() const
+{
+    if (!deque)
+    {
+        throw std::logic_error("Hash index outlived its deque");
+    }
+    if (stale)
+    {
+        rebuild();
+    }
+    else if (pending.getSize() > 0)
+    {
+        reinsertPending();
+    }
+}
+
+// Index of the first item with the given key, or -1.
+template <typename T, class KeyFn>
+int HashIndex<T, KeyFn>::findFirst(const Key &key) const
+{
+    refresh();
+    int first = -1;
+    probe(key, [&first](const int index)
+          {
+        if (first < 0 || index < first)
+        {
+            first = index;
+        }
+        return true; });
+    return first;
+}
+
+// Indices of all items with the given key, ascending.
+template <typename T, class KeyFn>
+SegmentedDeque<int> *HashIndex<T, KeyFn>::findAll(const Key &key) const
+{
+    refresh();
+    std::vector<int> found;
+    probe(key, [&found](const int index)
+          {
+        found.push_back(index);
+        return true; });
+    std::sort(found.begin(), found.end());
+    return new SegmentedDeque<int>(found.data(), static_cast<int>(found.size()));
+}
+
+template <typename T, class KeyFn>
+bool HashIndex<T, KeyFn>::contains(const Key &key) const
+{
+    refresh();
+    bool found = false;
+    probe(key, [&found](const int)
+          {
+        found = true;
+        return false; });
+    return found;
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::invalidate()
+{
+    stale = true;
+}
+
+//* { DequeObserver
+// Insertions, erasures and set() arrive through the index hooks below.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::itemStored(const int, const T &) {}
+
+// The caller may change any item of the segment, so their entries are taken
+// out now, while the items still hold the keys they are filed under. An item
+// without an entry is already pending from before a reshape.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::segmentTouched(const int segment)
+{
+    if (stale || (segment < touched.getSize() && touched.unsafeGet(segment)))
+    {
+        return;
+    }
+
+    int first = deque->getSegmentStart(segment);
+    int end = first + deque->getSegmentLength(segment);
+    for (int i = first; i < end; i++)
+    {
+        if (!eraseEntry(keyFn(itemAt(i)), i) && pending.getSize() == 0)
+        {
+            stale = true;
+            return;
+        }
+    }
+
+    while (touched.getSize() <= segment)
+    {
+        touched.append(false);
+    }
+    touched.unsafeGet(segment) = true;
+    if (pending.getSize() > 0 && pending.getLast() == first + base)
+    {
+        pending.getLast() = end + base;
+    }
+    else
+    {
+        pending.append(first + base);
+        pending.append(end + base);
+    }
+}
+
+// Moving items between segments keeps their indices, and so the pending
+// positions, but segment numbers change.
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::segmentsReshaped()
+{
+    touched.clear();
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::dequeDestroyed()
+{
+    deque = nullptr;
+    control.clear();
+    positions.clear();
+    pending.clear();
+    touched.clear();
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::itemsInserted(const int index, const int count)
+{
+    if (stale)
+    {
+        return;
+    }
+    bool atFront = index == 0 && count < deque->getLength();
+    bool atBack = index + count == deque->getLength();
+    if (!(atFront || atBack) || !hasRoomFor(count))
+    {
+        stale = true;
+        return;
+    }
+
+    if (atFront)
+    {
+        base -= count;
+    }
+    // New items may have landed in a touched segment, whose later writes are
+    // not reported again, so while any items are pending these join them.
+    if (pending.getSize() > 0)
+    {
+        if (atBack && pending.getLast() == index + base)
+        {
+            pending.getLast() = index + count + base;
+        }
+        else
+        {
+            pending.append(index + base);
+            pending.append(index + count + base);
+        }
+        return;
+    }
+    for (int i = index; i < index + count; i++)
+    {
+        insertEntry(keyFn(itemAt(i)), i);
+    }
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::itemsErasing(const int index, const int count)
+{
+    if (!stale)
+    {
+        eraseRange(index, count);
+    }
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::itemReplacing(const int index)
+{
+    replacingPending = false;
+    if (!stale && !eraseEntry(keyFn(itemAt(index)), index))
+    {
+        replacingPending = pending.getSize() > 0;
+        stale = !replacingPending;
+    }
+}
+
+template <typename T, class KeyFn>
+void HashIndex<T, KeyFn>::itemReplaced(const int index)
+{
+    if (stale || replacingPending)
+    {
+        return;
+    }
+    if (!hasRoomFor(1))
+    {
+        stale = true;
+        return;
+    }
+    insertEntry(keyFn(itemAt(index)), index);
+}
+//* } DequeObserver
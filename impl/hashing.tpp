@@ -0,0 +1,6 @@
+#include "../inc/hashing.hpp"
+
+inline uint64_t mixHash(const std::size_t hash)
+{
+    return static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+}
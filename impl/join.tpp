@@ -0,0 +1,222 @@
+#include <stdexcept>
+#include <vector>
+#include "../inc/join.hpp"
+
+template <class L, class R>
+std::ostream &operator<<(std::ostream &os, const Joined<L, R> &joined)
+{
+    return os << "(" << joined.left << ", " << joined.right << ")";
+}
+
+//* { HashJoin
+template <typename L, typename R, class LeftKey, class RightKey>
+HashJoin<L, R, LeftKey, RightKey>::HashJoin(const SegmentedDeque<L> *left, const SegmentedDeque<R> *right,
+                                            const LeftKey &leftKey, const RightKey &rightKey)
+    : left(left), right(right), leftKey(leftKey), rightKey(rightKey) {}
+
+template <typename L, typename R, class LeftKey, class RightKey>
+template <typename B, typename P, class BuildKey, class ProbeKey, class Prepare, class Emit>
+void HashJoin<L, R, LeftKey, RightKey>::join(const SegmentedDeque<B> &build, const SegmentedDeque<P> &probe,
+                                             const BuildKey &buildKey, const ProbeKey &probeKey,
+                                             const Prepare &prepare, const Emit &emit, const int threadCount)
+{
+    int length = probe.getLength();
+    int parts = parallelPartCount(length, threadCount);
+
+    // Build: items[id] is the id-th build item, next[id] the following item
+    // with the same key or -1, and the table holds each key's first and last.
+    std::vector<const B *> items;
+    std::vector<int> next(build.getLength(), -1);
+    items.reserve(build.getLength());
+    GroupTable<Key, Chain> chains;
+    build.forEachBlock([&](const B *block, const int count)
+                       {
+        for (int i = 0; i < count; i++)
+        {
+            int id = static_cast<int>(items.size());
+            items.push_back(block + i);
+            chains.upsert(Key(buildKey(block[i])), [id]()
+                          { return Chain{id, id}; },
+                          [&next, id](Chain &chain)
+                          {
+                next[chain.last] = id;
+                chain.last = id; });
+        } });
+
+    prepare(parts);
+    parallelRanges(length, parts, [&](const int part, const int start, const int end)
+                   {
+        auto visitor = makeBlockVisitor<P>([&](const P *block, const int count)
+                                           {
+            for (int i = 0; i < count; i++)
+            {
+                const Chain *chain = chains.find(Key(probeKey(block[i])));
+                if (!chain)
+                {
+                    continue;
+                }
+                for (int id = chain->first; id >= 0; id = next[id])
+                {
+                    emit(part, *items[id], block[i]);
+                }
+            } });
+        probe.visitBlocks(start, end - start, visitor); });
+}
+
+template <typename L, typename R, class LeftKey, class RightKey>
+template <class Prepare, class Emit>
+void HashJoin<L, R, LeftKey, RightKey>::run(const Prepare &prepare, const Emit &emit, const int threadCount) const
+{
+    if (left->getLength() <= right->getLength())
+    {
+        join(*left, *right, leftKey, rightKey, prepare, [&emit](const int part, const L &l, const R &r)
+             { emit(part, l, r); },
+             threadCount);
+    }
+    else
+    {
+        join(*right, *left, rightKey, leftKey, prepare, [&emit](const int part, const R &r, const L &l)
+             { emit(part, l, r); },
+             threadCount);
+    }
+}
+
+template <typename L, typename R, class LeftKey, class RightKey>
+template <class Visitor>
+void HashJoin<L, R, LeftKey, RightKey>::forEach(const Visitor &visit, const int threadCount) const
+{
+    run([](const int) {}, [&visit](const int, const L &l, const R &r)
+        { visit(l, r); },
+        threadCount);
+}
+
+// Each probe range fills its own deque; their segments are then moved onto the
+// result in range order.
+template <typename L, typename R, class LeftKey, class RightKey>
+SegmentedDeque<Joined<L, R>> *HashJoin<L, R, LeftKey, RightKey>::toDeque(const int segmentSize, const int threadCount) const
+{
+    using Output = SegmentedDeque<Joined<L, R>>;
+
+    std::vector<Output> parts;
+    run([&parts, segmentSize](const int count)
+        {
+        parts.reserve(count);
+        for (int part = 0; part < count; part++)
+        {
+            parts.emplace_back(segmentSize);
+        } },
+        [&parts](const int part, const L &l, const R &r)
+        { parts[part].append(Joined<L, R>{l, r}); },
+        threadCount);
+
+    Output *result = new Output(segmentSize);
+    for (Output &part : parts)
+    {
+        result->splice(part);
+    }
+    return result;
+}
+
+//* } HashJoin
+
+//* { MergeJoin
+template <typename L, typename R, class LeftKey, class RightKey>
+MergeJoin<L, R, LeftKey, RightKey>::MergeJoin(const SegmentedDeque<L> *left, const SegmentedDeque<R> *right,
+                                              const LeftKey &leftKey, const RightKey &rightKey)
+    : left(left), right(right), leftKey(leftKey), rightKey(rightKey) {}
+
+template <typename L, typename R, class LeftKey, class RightKey>
+template <class Visitor>
+void MergeJoin<L, R, LeftKey, RightKey>::forEach(const Visitor &visit) const
+{
+    auto l = left->cbegin();
+    auto lEnd = left->cend();
+    auto r = right->cbegin();
+    auto rEnd = right->cend();
+    if (l == lEnd || r == rEnd)
+    {
+        return;
+    }
+
+    // Moves a cursor on and refreshes its cached key, checking the order.
+    auto step = [](auto &it, const auto &end, Key &key, const auto &keyFn)
+    {
+        ++it;
+        if (it == end)
+        {
+            return false;
+        }
+        Key nextKey = keyFn(*it);
+        if (nextKey < key)
+        {
+            throw std::invalid_argument("Join input is not sorted by key");
+        }
+        key = std::move(nextKey);
+        return true;
+    };
+
+    Key lKey = leftKey(*l);
+    Key rKey = rightKey(*r);
+    while (true)
+    {
+        if (lKey < rKey)
+        {
+            if (!step(l, lEnd, lKey, leftKey))
+            {
+                return;
+            }
+            continue;
+        }
+        if (rKey < lKey)
+        {
+            if (!step(r, rEnd, rKey, rightKey))
+            {
+                return;
+            }
+            continue;
+        }
+
+        // Equal keys: find where the right run ends, then pair every left item
+        // of the key with the whole run.
+        auto runStart = r;
+        Key key = rKey;
+        bool moreRight = step(r, rEnd, rKey, rightKey);
+        while (moreRight && !(key < rKey))
+        {
+            moreRight = step(r, rEnd, rKey, rightKey);
+        }
+
+        bool moreLeft = true;
+        while (moreLeft && !(key < lKey))
+        {
+            for (auto it = runStart; it != r; ++it)
+            {
+                visit(*l, *it);
+            }
+            moreLeft = step(l, lEnd, lKey, leftKey);
+        }
+
+        if (!moreLeft || !moreRight)
+        {
+            return;
+        }
+    }
+}
+
+template <typename L, typename R, class LeftKey, class RightKey>
+SegmentedDeque<Joined<L, R>> *MergeJoin<L, R, LeftKey, RightKey>::toDeque(const int segmentSize) const
+{
+    SegmentedDeque<Joined<L, R>> *result = new SegmentedDeque<Joined<L, R>>(segmentSize);
+    try
+    {
+        forEach([result](const L &l, const R &r)
+                { result->append(Joined<L, R>{l, r}); });
+    }
+    catch (...)
+    {
+        delete result;
+        throw;
+    }
+    return result;
+}
+//* } MergeJoin
@@ -1,4 +1,7 @@
+#include <cstdlib>
 #include <iostream>
+#include <new>
+#include <utility>
 #include "../inc/linkedList.hpp"
 
 //* Iterator {
@@ -159,10 +162,10 @@ bool LinkedList<T>::ConstIterator::notEnd() const
 //* } end of ConstIterator section
 
 template <typename T>
-LinkedList<T>::LinkedList() : head(nullptr), length(0) {}
+LinkedList<T>::LinkedList() : head(nullptr), tail(nullptr), length(0), finger(nullptr), fingerIndex(0), fingerBusy(false) {}
 
 template <class T>
-LinkedList<T>::LinkedList(const int count) : head(nullptr), length(0)
+LinkedList<T>::LinkedList(const int count) : head(nullptr), tail(nullptr), length(0), finger(nullptr), fingerIndex(0), fingerBusy(false)
 {
     if (count < 0)
     {
@@ -177,7 +180,7 @@ LinkedList<T>::LinkedList(const int count) : head(nullptr), length(0)
 }
 
 template <typename T>
-LinkedList<T>::LinkedList(const T *items, const int count) : head(nullptr), length(0)
+LinkedList<T>::LinkedList(const T *items, const int count) : head(nullptr), tail(nullptr), length(0), finger(nullptr), fingerIndex(0), fingerBusy(false)
 {
     if (!items)
     {
@@ -191,7 +194,7 @@ LinkedList<T>::LinkedList(const T *items, const int count) : head(nullptr), leng
 }
 
 template <typename T>
-LinkedList<T>::LinkedList(const LinkedList<T> &list) : head(nullptr), length(0)
+LinkedList<T>::LinkedList(const LinkedList<T> &list) : head(nullptr), tail(nullptr), length(0), finger(nullptr), fingerIndex(0), fingerBusy(false)
 {
     for (ConstIterator it = list.cbegin(); it != list.cend(); ++it)
     {
@@ -212,17 +215,118 @@ void LinkedList<T>::clear()
     while (current != nullptr)
     {
         Node *next = current->next;
-        delete current;
+        destroyNode(current);
         current = next;
     }
+    pool.reset();
     head = nullptr;
+    tail = nullptr;
     length = 0;
+    finger = nullptr;
+}
+
+// Nodes live in a per-list NodePool, so allocating and freeing them is O(1) and
+// nodes appended in a row sit next to each other in memory.
+template <typename T>
+typename LinkedList<T>::Node *LinkedList<T>::createNode(const T &value)
+{
+    void *slot = pool.allocate();
+    try
+    {
+        return new (slot) Node(value);
+    }
+    catch (...)
+    {
+        pool.release(slot);
+        throw;
+    }
+}
+
+template <typename T>
+void LinkedList<T>::destroyNode(Node *node)
+{
+    node->~Node();
+    pool.release(node);
+}
+
+// Rebuilds the list in a fresh pool so that its nodes are laid out in list
+// order, undoing the scattering left by prepends, inserts and reused slots.
+template <typename T>
+void LinkedList<T>::compact()
+{
+    LinkedList<T> packed;
+    for (Node *node = head; node; node = node->next)
+    {
+        packed.append(node->value);
+    }
+
+    std::swap(head, packed.head);
+    std::swap(tail, packed.tail);
+    std::swap(length, packed.length);
+    pool.swap(packed.pool);
+    finger = nullptr;
+}
+
+// Walks to index from head, tail or from, whichever is closest.
+template <typename T>
+typename LinkedList<T>::Node *LinkedList<T>::walk(const int index, Node *from, const int fromIndex) const
+{
+    Node *node = head;
+    int position = 0;
+    int distance = index;
+
+    if (length - 1 - index < distance)
+    {
+        node = tail;
+        position = length - 1;
+        distance = length - 1 - index;
+    }
+    if (from && std::abs(index - fromIndex) < distance)
+    {
+        node = from;
+        position = fromIndex;
+    }
+
+    for (; position < index; position++)
+    {
+        node = node->next;
+    }
+    for (; position > index; position--)
+    {
+        node = node->prev;
+    }
+    return node;
+}
+
+template <typename T>
+typename LinkedList<T>::Node *LinkedList<T>::seek(const int index)
+{
+    finger = walk(index, finger, fingerIndex);
+    fingerIndex = index;
+    return finger;
+}
+
+// Const lookups may run concurrently, so they use the finger only when no
+// other one holds it.
+template <typename T>
+typename LinkedList<T>::Node *LinkedList<T>::seek(const int index) const
+{
+    if (fingerBusy.exchange(true, std::memory_order_acquire))
+    {
+        return walk(index, nullptr, 0);
+    }
+
+    finger = walk(index, finger, fingerIndex);
+    fingerIndex = index;
+    Node *node = finger;
+    fingerBusy.store(false, std::memory_order_release);
+    return node;
 }
 
 template <typename T>
 void LinkedList<T>::append(const T &item)
 {
-    Node *newNode = new Node(item);
+    Node *newNode = createNode(item);
 
     if (!head)
     {
@@ -230,29 +334,113 @@ void LinkedList<T>::append(const T &item)
     }
     else
     {
-        Iterator it = begin();
-        while (it.current->next != nullptr)
-        {
-            ++it;
-        }
-        it.current->next = newNode;
-        newNode->prev = it.current;
+        tail->next = newNode;
+        newNode->prev = tail;
     }
+    tail = newNode;
 
     length++;
 }
 
+template <typename T>
+template <class InputIt>
+void LinkedList<T>::assign(InputIt first, InputIt last)
+{
+    clear();
+    appendRange(first, last);
+}
+
+template <typename T>
+template <class InputIt>
+void LinkedList<T>::appendRange(InputIt first, InputIt last)
+{
+    for (; first != last; ++first)
+    {
+        append(*first);
+    }
+}
+
+template <typename T>
+void LinkedList<T>::appendRange(const T *items, const int count)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Negative count");
+    }
+    if (count > 0 && !items)
+    {
+        throw std::invalid_argument("Null array with non-zero count");
+    }
+
+    appendRange(items, items + count);
+}
+
+// Nodes are allocated one at a time, so there is nothing to set aside in advance.
+template <typename T>
+void LinkedList<T>::reserve(const int count)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Invalid capacity");
+    }
+}
+
+template <typename T>
+template <class Visitor>
+void LinkedList<T>::forEachBlock(const Visitor &visit) const
+{
+    for (const Node *node = head; node; node = node->next)
+    {
+        visit(&node->value, 1);
+    }
+}
+
+template <typename T>
+template <class Visitor>
+void LinkedList<T>::forEachBlock(const Visitor &visit)
+{
+    for (Node *node = head; node; node = node->next)
+    {
+        visit(&node->value, 1);
+    }
+}
+
+template <typename T>
+template <class Visitor>
+void LinkedList<T>::forEachBlock(const int startIndex, const int count, const Visitor &visit) const
+{
+    if (startIndex < 0 || count < 0 || startIndex > length - count)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+    if (count == 0)
+    {
+        return;
+    }
+
+    const Node *node = seek(startIndex);
+    for (int i = 0; i < count; i++, node = node->next)
+    {
+        visit(&node->value, 1);
+    }
+}
+
 template <typename T>
 void LinkedList<T>::prepend(const T &item)
 {
-    Node *newNode = new Node(item);
+    Node *newNode = createNode(item);
     newNode->next = head;
     if (head)
     {
         head->prev = newNode;
     }
+    else
+    {
+        tail = newNode;
+    }
     head = newNode;
     length++;
+    fingerIndex++;
 }
 
 template <typename T>
@@ -283,12 +471,7 @@ T &LinkedList<T>::getLast()
         throw std::out_of_range("List is empty");
     }
 
-    Iterator it = begin();
-    while (it.current->next != nullptr)
-    {
-        ++it;
-    }
-    return *it;
+    return tail->value;
 }
 
 template <typename T>
@@ -299,12 +482,7 @@ const T &LinkedList<T>::getLast() const
         throw std::out_of_range("List is empty");
     }
 
-    ConstIterator it = cbegin();
-    while (it.current->next != nullptr)
-    {
-        ++it;
-    }
-    return *it;
+    return tail->value;
 }
 
 template <typename T>
@@ -315,12 +493,7 @@ T &LinkedList<T>::get(const int index)
         throw std::out_of_range("Index out of range");
     }
 
-    Iterator it = begin();
-    for (int i = 0; i < index; i++)
-    {
-        ++it;
-    }
-    return *it;
+    return seek(index)->value;
 }
 
 template <typename T>
@@ -331,12 +504,7 @@ const T &LinkedList<T>::get(const int index) const
         throw std::out_of_range("Index out of range");
     }
 
-    ConstIterator it = cbegin();
-    for (int i = 0; i < index; i++)
-    {
-        ++it;
-    }
-    return *it;
+    return seek(index)->value;
 }
 
 template <typename T>
@@ -347,12 +515,7 @@ void LinkedList<T>::set(const int index, const T &value)
         throw std::out_of_range("Index out of range");
     }
 
-    Iterator it = begin();
-    for (int i = 0; i < index; i++)
-    {
-        ++it;
-    }
-    it.current->value = value;
+    seek(index)->value = value;
 }
 
 template <typename T>
@@ -375,23 +538,19 @@ void LinkedList<T>::insertAt(const T &value, const int index)
         return;
     }
 
-    Iterator it = begin();
-    for (int i = 0; i < index; i++)
-    {
-        ++it;
-    }
+    Node *current = seek(index);
+    Node *newNode = createNode(value);
+    newNode->next = current;
+    newNode->prev = current->prev;
 
-    Node *newNode = new Node(value);
-    newNode->next = it.current;
-    newNode->prev = it.current->prev;
-
-    if (it.current->prev)
+    if (current->prev)
     {
-        it.current->prev->next = newNode;
+        current->prev->next = newNode;
     }
-    it.current->prev = newNode;
+    current->prev = newNode;
 
     length++;
+    finger = newNode;
 }
 
 template <typename T>
@@ -407,12 +566,7 @@ LinkedList<T> *LinkedList<T>::getSubList(const int startIndex, const int endInde
 
     LinkedList<T> *subList = new LinkedList<T>();
 
-    ConstIterator it = cbegin();
-    for (int i = 0; i < startIndex; i++)
-    {
-        ++it;
-    }
-
+    ConstIterator it(seek(startIndex));
     for (int i = startIndex; i <= endIndex; i++)
     {
         subList->append(*it);
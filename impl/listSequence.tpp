@@ -1,170 +1,209 @@
 #include "../inc/listSequence.hpp"
 
-template <class T>
-ListSequence<T>::ListSequence() : list() {}
+template <class T, class List>
+ListSequence<T, List>::ListSequence() : list() {}
 
-template <class T>
-ListSequence<T>::ListSequence(const T *items, const int count) : list(items, count) {}
+template <class T, class List>
+ListSequence<T, List>::ListSequence(const T *items, const int count) : list(items, count) {}
 
-template <class T>
-ListSequence<T>::ListSequence(const int count) : list(count) {}
+template <class T, class List>
+ListSequence<T, List>::ListSequence(const int count) : list(count) {}
 
-template <class T>
-ListSequence<T>::ListSequence(const LinkedList<T> &list) : list(list) {}
+template <class T, class List>
+ListSequence<T, List>::ListSequence(const List &list) : list(list) {}
 
-template <class T>
-ListSequence<T>::~ListSequence() {}
+template <class T, class List>
+ListSequence<T, List>::~ListSequence() {}
 
-template <class T>
-T &ListSequence<T>::getFirst()
+template <class T, class List>
+T &ListSequence<T, List>::getFirst()
 {
     return list.getFirst();
 }
 
-template <class T>
-const T &ListSequence<T>::getFirst() const
+template <class T, class List>
+const T &ListSequence<T, List>::getFirst() const
 {
     return list.getFirst();
 }
 
-template <class T>
-T &ListSequence<T>::getLast()
+template <class T, class List>
+T &ListSequence<T, List>::getLast()
 {
     return list.getLast();
 }
 
-template <class T>
-const T &ListSequence<T>::getLast() const
+template <class T, class List>
+const T &ListSequence<T, List>::getLast() const
 {
     return list.getLast();
 }
 
-template <class T>
-T &ListSequence<T>::get(int index)
+template <class T, class List>
+T &ListSequence<T, List>::get(int index)
 {
     return list.get(index);
 }
 
-template <class T>
-const T &ListSequence<T>::get(const int index) const
+template <class T, class List>
+const T &ListSequence<T, List>::get(const int index) const
 {
     return list.get(index);
 }
 
-template <class T>
-int ListSequence<T>::getLength() const
+template <class T, class List>
+int ListSequence<T, List>::getLength() const
 {
     return list.getLength();
 }
 
-template <class T>
-Sequence<T> *ListSequence<T>::getSubsequence(const int startIndex, const int endIndex) const
+template <class T, class List>
+Sequence<T> *ListSequence<T, List>::getSubsequence(const int startIndex, const int endIndex) const
 {
-    LinkedList<T> *subLinkedList = list.getSubList(startIndex, endIndex);
-    ListSequence<T> *subList = new ListSequence<T>(*subLinkedList);
+    List *subLinkedList = list.getSubList(startIndex, endIndex);
+    ListSequence<T, List> *subList = new ListSequence<T, List>(*subLinkedList);
     delete subLinkedList;
     return subList;
 }
 
-template <class T>
-void ListSequence<T>::append(const T &item)
+template <class T, class List>
+void ListSequence<T, List>::append(const T &item)
 {
     list.append(item);
 }
 
-template <class T>
-void ListSequence<T>::prepend(const T &item)
+template <class T, class List>
+void ListSequence<T, List>::prepend(const T &item)
 {
     list.prepend(item);
 }
 
-template <class T>
-void ListSequence<T>::insertAt(const T &item, const int index)
+template <class T, class List>
+void ListSequence<T, List>::insertAt(const T &item, const int index)
 {
-    if (index < 0 || index > getLength())
-    {
-        throw std::out_of_range("Invalid index for insertion");
-    }
-
     list.insertAt(item, index);
 }
 
-template <class T>
-void ListSequence<T>::concat(const Sequence<T> *other)
+template <class T, class List>
+void ListSequence<T, List>::concat(const Sequence<T> *other)
 {
-    for (int i = 0; i < other->getLength(); i++)
+    if (!other)
     {
-        list.append(other->get(i));
+        return;
     }
+
+    auto appender = makeBlockVisitor<T>([this](const T *items, const int count)
+                                        { list.appendRange(items, count); });
+    other->visitBlocks(0, other->getLength(), appender);
 }
 
-template <class T>
-void ListSequence<T>::set(const int index, const T &data)
+template <class T, class List>
+void ListSequence<T, List>::visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const
 {
-    if (index < 0 || index >= getLength())
-    {
-        throw std::out_of_range("Index out of range");
-    }
-    this->get(index) = data;
+    list.forEachBlock(startIndex, count, [&visitor](const T *items, const int length)
+                      { visitor.visit(items, length); });
 }
 
-template <class T>
-Sequence<T> *ListSequence<T>::setImmutable(const int index, const T &data) const
+template <class T, class List>
+void ListSequence<T, List>::set(const int index, const T &data)
 {
-    ListSequence<T> *newSequence = new ListSequence<T>(*this);
+    list.set(index, data);
+}
+
+template <class T, class List>
+Sequence<T> *ListSequence<T, List>::setImmutable(const int index, const T &data) const
+{
+    ListSequence<T, List> *newSequence = new ListSequence<T, List>(*this);
     newSequence->set(index, data);
     return newSequence;
 }
 
-template <class T>
-Sequence<T> *ListSequence<T>::appendImmutable(const T &item) const
+template <class T, class List>
+Sequence<T> *ListSequence<T, List>::appendImmutable(const T &item) const
 {
-    ListSequence<T> *newSequence = new ListSequence<T>(*this);
+    ListSequence<T, List> *newSequence = new ListSequence<T, List>(*this);
     newSequence->append(item);
     return newSequence;
 }
 
-template <class T>
-Sequence<T> *ListSequence<T>::prependImmutable(const T &item) const
+template <class T, class List>
+Sequence<T> *ListSequence<T, List>::prependImmutable(const T &item) const
 {
-    ListSequence<T> *newSequence = new ListSequence<T>(*this);
+    ListSequence<T, List> *newSequence = new ListSequence<T, List>(*this);
     newSequence->prepend(item);
     return newSequence;
 }
 
-template <class T>
-Sequence<T> *ListSequence<T>::insertAtImmutable(const T &item, const int index) const
+template <class T, class List>
+Sequence<T> *ListSequence<T, List>::insertAtImmutable(const T &item, const int index) const
 {
-    ListSequence<T> *newSequence = new ListSequence<T>(*this);
+    ListSequence<T, List> *newSequence = new ListSequence<T, List>(*this);
     newSequence->insertAt(item, index);
     return newSequence;
 }
 
-template <class T>
-Sequence<T> *ListSequence<T>::concatImmutable(const Sequence<T> *list) const
+template <class T, class List>
+Sequence<T> *ListSequence<T, List>::concatImmutable(const Sequence<T> *list) const
 {
-    ListSequence<T> *newSequence = new ListSequence<T>(*this);
-    for (int i = 0; i < list->getLength(); i++)
-    {
-        newSequence->append(list->get(i));
-    }
+    ListSequence<T, List> *newSequence = new ListSequence<T, List>(*this);
+    newSequence->concat(list);
     return newSequence;
 }
 
-template <class T>
-void ListSequence<T>::print() const
+template <class T, class List>
+void ListSequence<T, List>::print() const
 {
     list.print();
 }
 
-template <class T>
-void ListSequence<T>::clear()
+template <class T, class List>
+template <class InputIt>
+void ListSequence<T, List>::assign(InputIt first, InputIt last)
+{
+    list.assign(first, last);
+}
+
+template <class T, class List>
+template <class InputIt>
+void ListSequence<T, List>::appendRange(InputIt first, InputIt last)
+{
+    list.appendRange(first, last);
+}
+
+template <class T, class List>
+void ListSequence<T, List>::appendRange(const T *items, const int count)
+{
+    list.appendRange(items, count);
+}
+
+template <class T, class List>
+void ListSequence<T, List>::reserve(const int count)
+{
+    list.reserve(count);
+}
+
+template <class T, class List>
+template <class Visitor>
+void ListSequence<T, List>::forEachBlock(const Visitor &visit) const
+{
+    list.forEachBlock(visit);
+}
+
+template <class T, class List>
+template <class Visitor>
+void ListSequence<T, List>::forEachBlock(const Visitor &visit)
+{
+    list.forEachBlock(visit);
+}
+
+template <class T, class List>
+void ListSequence<T, List>::clear()
 {
     list.clear();
 }
 
-template <class T>
-ListSequence<T> &ListSequence<T>::operator=(const ListSequence<T> &other)
+template <class T, class List>
+ListSequence<T, List> &ListSequence<T, List>::operator=(const ListSequence<T, List> &other)
 {
     if (this != &other)
     {
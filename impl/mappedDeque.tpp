@@ -0,0 +1,481 @@
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../inc/mappedDeque.hpp"
+
+template <typename T>
+MappedDeque<T>::MappedDeque(const std::string &path)
+    : mapping(nullptr), mappingSize(0), segmentSize(0), totalSize(0)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(DequeFileHeader))
+    {
+        ::close(fd);
+        throw std::runtime_error("File does not contain a serialized deque");
+    }
+
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw std::runtime_error("Cannot map " + path);
+    }
+
+    try
+    {
+        const char *bytes = static_cast<const char *>(mapping);
+        const DequeFileHeader *header = reinterpret_cast<const DequeFileHeader *>(bytes);
+
+        if (header->magic != DEQUE_FILE_MAGIC || header->version != DEQUE_FILE_VERSION)
+        {
+            throw std::runtime_error("File does not contain a serialized deque");
+        }
+        if (header->typeTag != TypeTag<T>::value || header->elementSize != sizeof(T))
+        {
+            throw std::runtime_error("Serialized element type does not match");
+        }
+
+        if (header->segmentSize == 0 || header->segmentSize > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+        {
+            throw std::runtime_error("Serialized segment size is invalid");
+        }
+
+        segmentSize = static_cast<int>(header->segmentSize);
+        segmentStarts.append(0);
+
+        uint64_t mappedSize = 0;
+        size_t position = sizeof(DequeFileHeader);
+        for (uint32_t i = 0; i < header->segmentCount; i++)
+        {
+            if (position + sizeof(DequeSegmentHeader) > mappingSize)
+            {
+                throw std::runtime_error("Serialized deque is truncated");
+            }
+            const DequeSegmentHeader *segmentHeader = reinterpret_cast<const DequeSegmentHeader *>(bytes + position);
+            position += sizeof(DequeSegmentHeader);
+
+            // Segments are never empty and never exceed the segment size.
+            if (segmentHeader->length == 0 || segmentHeader->length > header->segmentSize)
+            {
+                throw std::runtime_error("Serialized segment length is invalid");
+            }
+
+            uint64_t payload = static_cast<uint64_t>(segmentHeader->length) * sizeof(T);
+            if (position + payload > mappingSize)
+            {
+                throw std::runtime_error("Serialized deque is truncated");
+            }
+
+            mappedSize += segmentHeader->length;
+            if (mappedSize > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+            {
+                throw std::runtime_error("Serialized deque is too large");
+            }
+
+            segmentData.append(reinterpret_cast<const T *>(bytes + position));
+            totalSize = static_cast<int>(mappedSize);
+            segmentStarts.append(totalSize);
+            position += payload + paddingFor(payload);
+        }
+
+        if (static_cast<uint64_t>(totalSize) != header->totalSize)
+        {
+            throw std::runtime_error("Serialized deque size does not match its segments");
+        }
+    }
+    catch (...)
+    {
+        munmap(mapping, mappingSize);
+        throw;
+    }
+}
+
+template <typename T>
+const MappedDeque<T> *MappedDeque<T>::open(const std::string &path)
+{
+    return new MappedDeque<T>(path);
+}
+
+template <typename T>
+MappedDeque<T>::~MappedDeque()
+{
+    if (mapping)
+    {
+        munmap(mapping, mappingSize);
+    }
+}
+
+template <typename T>
+int MappedDeque<T>::findSegment(const int index) const
+{
+    const int *starts = segmentStarts.getData();
+    return static_cast<int>(std::upper_bound(starts, starts + segmentStarts.getSize(), index) - starts) - 1;
+}
+
+template <typename T>
+void MappedDeque<T>::advise(const int advice) const
+{
+    madvise(mapping, mappingSize, advice);
+}
+
+template <typename T>
+void MappedDeque<T>::adviseSequential() const
+{
+    advise(MADV_SEQUENTIAL);
+}
+
+template <typename T>
+void MappedDeque<T>::adviseRandom() const
+{
+    advise(MADV_RANDOM);
+}
+
+template <typename T>
+T &MappedDeque<T>::getFirst()
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+T &MappedDeque<T>::getLast()
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+T &MappedDeque<T>::get(const int)
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+const T &MappedDeque<T>::getFirst() const
+{
+    if (totalSize == 0)
+    {
+        throw std::out_of_range("Deque is empty");
+    }
+    return get(0);
+}
+
+template <typename T>
+const T &MappedDeque<T>::getLast() const
+{
+    if (totalSize == 0)
+    {
+        throw std::out_of_range("Deque is empty");
+    }
+    return get(totalSize - 1);
+}
+
+template <typename T>
+const T &MappedDeque<T>::get(const int index) const
+{
+    if (index < 0 || index >= totalSize)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    int segment = findSegment(index);
+    return segmentData.unsafeGet(segment)[index - segmentStarts.unsafeGet(segment)];
+}
+
+template <typename T>
+void MappedDeque<T>::append(const T &)
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+void MappedDeque<T>::prepend(const T &)
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+void MappedDeque<T>::insertAt(const T &, const int)
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+void MappedDeque<T>::set(const int, const T &)
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+void MappedDeque<T>::concat(const Sequence<T> *)
+{
+    throw std::logic_error("Mapped deque is read-only");
+}
+
+template <typename T>
+int MappedDeque<T>::getLength() const
+{
+    return totalSize;
+}
+
+template <typename T>
+int MappedDeque<T>::getSegmentSize() const
+{
+    return segmentSize;
+}
+
+template <typename T>
+int MappedDeque<T>::getSegmentCount() const
+{
+    return segmentData.getSize();
+}
+
+template <typename T>
+SegmentedDeque<T> *MappedDeque<T>::toDeque() const
+{
+    auto *result = new SegmentedDeque<T>(segmentSize);
+    result->concat(this);
+    return result;
+}
+
+template <typename T>
+Sequence<T> *MappedDeque<T>::getSubsequence(const int startIndex, const int endIndex) const
+{
+    if (startIndex < 0 || startIndex >= totalSize ||
+        endIndex < 0 || endIndex >= totalSize ||
+        startIndex > endIndex)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+
+    auto *result = new SegmentedDeque<T>(segmentSize);
+    auto appender = makeBlockVisitor<T>([result](const T *items, const int count)
+                                        { result->appendRange(items, count); });
+    visitBlocks(startIndex, endIndex - startIndex + 1, appender);
+    return result;
+}
+
+template <typename T>
+void MappedDeque<T>::visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const
+{
+    this->checkBlockRange(startIndex, count);
+    if (count == 0)
+    {
+        return;
+    }
+
+    int segment = findSegment(startIndex);
+    int position = startIndex - segmentStarts.unsafeGet(segment);
+    int remaining = count;
+    while (remaining > 0)
+    {
+        int length = segmentStarts.unsafeGet(segment + 1) - segmentStarts.unsafeGet(segment);
+        int chunk = std::min(length - position, remaining);
+        visitor.visit(segmentData.unsafeGet(segment) + position, chunk);
+        remaining -= chunk;
+        segment++;
+        position = 0;
+    }
+}
+
+template <typename T>
+Sequence<T> *MappedDeque<T>::appendImmutable(const T &item) const
+{
+    SegmentedDeque<T> *result = toDeque();
+    result->append(item);
+    return result;
+}
+
+template <typename T>
+Sequence<T> *MappedDeque<T>::prependImmutable(const T &item) const
+{
+    SegmentedDeque<T> *result = toDeque();
+    result->prepend(item);
+    return result;
+}
+
+template <typename T>
+Sequence<T> *MappedDeque<T>::insertAtImmutable(const T &item, const int index) const
+{
+    SegmentedDeque<T> *result = toDeque();
+    try
+    {
+        result->insertAt(item, index);
+    }
+    catch (...)
+    {
+        delete result;
+        throw;
+    }
+    return result;
+}
+
+template <typename T>
+Sequence<T> *MappedDeque<T>::setImmutable(const int index, const T &data) const
+{
+    SegmentedDeque<T> *result = toDeque();
+    try
+    {
+        result->set(index, data);
+    }
+    catch (...)
+    {
+        delete result;
+        throw;
+    }
+    return result;
+}
+
+template <typename T>
+Sequence<T> *MappedDeque<T>::concatImmutable(const Sequence<T> *other) const
+{
+    SegmentedDeque<T> *result = toDeque();
+    result->concat(other);
+    return result;
+}
+
+template <typename T>
+void MappedDeque<T>::print() const
+{
+    if (totalSize == 0)
+    {
+        std::cout << "Empty";
+        return;
+    }
+
+    std::cout << "Total segments: " << getSegmentCount() << ", Total size: " << totalSize << std::endl;
+    for (int i = 0; i < getSegmentCount(); i++)
+    {
+        int length = segmentStarts[i + 1] - segmentStarts[i];
+        std::cout << "Segment " << i << " (length: " << length << "): ";
+        for (int j = 0; j < length; j++)
+        {
+            std::cout << "[" << segmentData[i][j] << "]";
+            if (j < length - 1)
+            {
+                std::cout << ", ";
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
+template <typename T>
+template <typename Predicate>
+SegmentedDeque<T> *MappedDeque<T>::where(const Predicate &pred) const
+{
+    adviseSequential();
+
+    auto *result = new SegmentedDeque<T>(segmentSize);
+    for (int i = 0; i < getSegmentCount(); i++)
+    {
+        const T *items = segmentData.unsafeGet(i);
+        int length = segmentStarts.unsafeGet(i + 1) - segmentStarts.unsafeGet(i);
+        for (int j = 0; j < length; j++)
+        {
+            if (pred(items[j]))
+            {
+                result->append(items[j]);
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+template <typename R, typename BinaryOp>
+R MappedDeque<T>::reduce(const BinaryOp &op, R init) const
+{
+    adviseSequential();
+
+    for (int i = 0; i < getSegmentCount(); i++)
+    {
+        const T *items = segmentData.unsafeGet(i);
+        int length = segmentStarts.unsafeGet(i + 1) - segmentStarts.unsafeGet(i);
+        for (int j = 0; j < length; j++)
+        {
+            init = op(init, items[j]);
+        }
+    }
+    return init;
+}
+
+//* { ConstIterator
+template <typename T>
+MappedDeque<T>::ConstIterator::ConstIterator(const MappedDeque<T> *deque, const int segment, const int offset)
+    : deque(deque), segment(segment), offset(offset)
+{
+    while (this->segment < deque->getSegmentCount() &&
+           this->offset >= deque->segmentStarts.unsafeGet(this->segment + 1) - deque->segmentStarts.unsafeGet(this->segment))
+    {
+        this->segment++;
+        this->offset = 0;
+    }
+}
+
+template <typename T>
+const T &MappedDeque<T>::ConstIterator::operator*() const
+{
+    if (!notEnd())
+    {
+        throw std::runtime_error("Iterator out of range");
+    }
+    return deque->segmentData.unsafeGet(segment)[offset];
+}
+
+template <typename T>
+typename MappedDeque<T>::ConstIterator &MappedDeque<T>::ConstIterator::operator++()
+{
+    *this = ConstIterator(deque, segment, offset + 1);
+    return *this;
+}
+
+template <typename T>
+typename MappedDeque<T>::ConstIterator MappedDeque<T>::ConstIterator::operator++(int)
+{
+    ConstIterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <typename T>
+bool MappedDeque<T>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    return deque == other.deque && segment == other.segment && offset == other.offset;
+}
+
+template <typename T>
+bool MappedDeque<T>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
+
+template <typename T>
+bool MappedDeque<T>::ConstIterator::notEnd() const
+{
+    return segment < deque->getSegmentCount();
+}
+
+template <typename T>
+typename MappedDeque<T>::ConstIterator MappedDeque<T>::cbegin() const
+{
+    return ConstIterator(this, 0, 0);
+}
+
+template <typename T>
+typename MappedDeque<T>::ConstIterator MappedDeque<T>::cend() const
+{
+    return ConstIterator(this, getSegmentCount(), 0);
+}
+
+//* } ConstIterator
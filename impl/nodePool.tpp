@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <new>
+#include "../inc/nodePool.hpp"
+
+template <typename Item>
+NodePool<Item>::NodePool() : activeSlab(-1), cursor(nullptr), slabEnd(nullptr), freeList(nullptr) {}
+
+template <typename Item>
+NodePool<Item>::~NodePool()
+{
+    for (int i = 0; i < slabs.getSize(); i++)
+    {
+        ::operator delete(slabs[i].slots);
+    }
+}
+
+// Moves the bump cursor to the next slab, allocating one only when reset()
+// has not left an already allocated slab to reuse.
+template <typename Item>
+void NodePool<Item>::nextSlab()
+{
+    activeSlab++;
+    if (activeSlab == slabs.getSize())
+    {
+        Slab slab;
+        slab.size = slabs.getSize() == 0 ? NODE_POOL_FIRST_SLAB : std::min(slabs.getLast().size * 2, NODE_POOL_MAX_SLAB);
+        slab.slots = static_cast<Slot *>(::operator new(sizeof(Slot) * slab.size));
+        slabs.append(slab);
+    }
+
+    cursor = slabs[activeSlab].slots;
+    slabEnd = cursor + slabs[activeSlab].size;
+}
+
+template <typename Item>
+void *NodePool<Item>::allocate()
+{
+    if (freeList)
+    {
+        Slot *slot = freeList;
+        freeList = slot->next;
+        return slot;
+    }
+
+    if (cursor == slabEnd)
+    {
+        nextSlab();
+    }
+    return cursor++;
+}
+
+template <typename Item>
+void NodePool<Item>::release(void *item)
+{
+    if (!item)
+    {
+        return;
+    }
+
+    Slot *slot = static_cast<Slot *>(item);
+    slot->next = freeList;
+    freeList = slot;
+}
+
+// Marks every slot free while keeping the slabs for reuse. Items still living
+// in the pool are not destroyed.
+template <typename Item>
+void NodePool<Item>::reset()
+{
+    activeSlab = -1;
+    cursor = nullptr;
+    slabEnd = nullptr;
+    freeList = nullptr;
+}
+
+template <typename Item>
+void NodePool<Item>::swap(NodePool<Item> &other)
+{
+    std::swap(activeSlab, other.activeSlab);
+    std::swap(cursor, other.cursor);
+    std::swap(slabEnd, other.slabEnd);
+    std::swap(freeList, other.freeList);
+
+    DynamicArray<Slab> slabsCopy(slabs);
+    slabs = other.slabs;
+    other.slabs = slabsCopy;
+}
+
+template <typename Item>
+int NodePool<Item>::getSlabCount() const
+{
+    return slabs.getSize();
+}
+
+template <typename Item>
+int NodePool<Item>::getCapacity() const
+{
+    int capacity = 0;
+    for (int i = 0; i < slabs.getSize(); i++)
+    {
+        capacity += slabs[i].size;
+    }
+    return capacity;
+}
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../inc/parallel.hpp"
+
+inline int parallelPartCount(const int length, const int threadCount, const int minPerThread)
+{
+    if (threadCount < 1)
+    {
+        throw std::invalid_argument("Thread count must be positive");
+    }
+    return std::min(threadCount, std::max(1, length / minPerThread));
+}
+
+template <class Fn>
+void parallelRanges(const int length, const int parts, const Fn &fn)
+{
+    if (parts == 1)
+    {
+        fn(0, 0, length);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(parts);
+    auto work = [&](const int part)
+    {
+        int start = static_cast<int>(static_cast<long long>(length) * part / parts);
+        int end = static_cast<int>(static_cast<long long>(length) * (part + 1) / parts);
+        try
+        {
+            fn(part, start, end);
+        }
+        catch (...)
+        {
+            errors[part] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    try
+    {
+        for (int part = 1; part < parts; part++)
+        {
+            workers.emplace_back(work, part);
+        }
+    }
+    catch (...)
+    {
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        throw;
+    }
+    work(0);
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    for (const std::exception_ptr &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
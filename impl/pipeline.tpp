@@ -0,0 +1,120 @@
+#include <vector>
+#include "../inc/pipeline.hpp"
+
+//* { Stages
+template <class Item, class Sink>
+void IdentityStage::operator()(const Item &item, const Sink &sink) const
+{
+    sink(item);
+}
+
+template <class Inner, class Predicate>
+template <class Item, class Sink>
+void FilterStage<Inner, Predicate>::operator()(const Item &item, const Sink &sink) const
+{
+    inner(item, [this, &sink](const auto &value)
+          {
+        if (pred(value))
+        {
+            sink(value);
+        } });
+}
+
+template <class Inner, class Fn>
+template <class Item, class Sink>
+void MapStage<Inner, Fn>::operator()(const Item &item, const Sink &sink) const
+{
+    inner(item, [this, &sink](const auto &value)
+          { sink(fn(value)); });
+}
+//* } Stages
+
+template <typename T, class Stage>
+Pipeline<T, Stage>::Pipeline(const SegmentedDeque<T> *deque, const Stage &stage)
+    : deque(deque), stage(stage) {}
+
+template <typename T, class Stage>
+template <class Predicate>
+Pipeline<T, FilterStage<Stage, Predicate>> Pipeline<T, Stage>::filter(const Predicate &pred) const
+{
+    return Pipeline<T, FilterStage<Stage, Predicate>>(deque, FilterStage<Stage, Predicate>{stage, pred});
+}
+
+template <typename T, class Stage>
+template <class Fn>
+Pipeline<T, MapStage<Stage, Fn>> Pipeline<T, Stage>::map(const Fn &fn) const
+{
+    return Pipeline<T, MapStage<Stage, Fn>>(deque, MapStage<Stage, Fn>{stage, fn});
+}
+
+template <typename T, class Stage>
+template <typename R, class BinaryOp>
+R Pipeline<T, Stage>::reduceRange(const BinaryOp &op, R init, const int startIndex, const int count) const
+{
+    auto visitor = makeBlockVisitor<T>([this, &op, &init](const T *items, const int length)
+                                       {
+        for (int i = 0; i < length; i++)
+        {
+            stage(items[i], [&op, &init](const auto &value)
+                  { init = op(init, value); });
+        } });
+    deque->visitBlocks(startIndex, count, visitor);
+    return init;
+}
+
+template <typename T, class Stage>
+template <typename R, class BinaryOp>
+R Pipeline<T, Stage>::reduce(const BinaryOp &op, R init) const
+{
+    return reduceRange(op, init, 0, deque->getLength());
+}
+
+template <typename T, class Stage>
+template <typename R, class BinaryOp, class CombineOp>
+R Pipeline<T, Stage>::reduce(const BinaryOp &op, const CombineOp &combine, R init, const int threadCount) const
+{
+    int length = deque->getLength();
+    int parts = parallelPartCount(length, threadCount);
+    if (parts == 1)
+    {
+        return reduce(op, init);
+    }
+
+    // Each partial in its own object: std::vector<bool> would pack them into
+    // shared words that the threads write concurrently.
+    struct Partial
+    {
+        R value;
+    };
+    std::vector<Partial> partials(parts, Partial{init});
+    parallelRanges(length, parts, [&](const int part, const int start, const int end)
+                   { partials[part].value = reduceRange(op, init, start, end - start); });
+
+    R result = partials[0].value;
+    for (int part = 1; part < parts; part++)
+    {
+        result = combine(result, partials[part].value);
+    }
+    return result;
+}
+
+template <typename T, class Stage>
+template <class UnaryFn>
+void Pipeline<T, Stage>::forEach(const UnaryFn &fn) const
+{
+    auto visitor = makeBlockVisitor<T>([this, &fn](const T *items, const int length)
+                                       {
+        for (int i = 0; i < length; i++)
+        {
+            stage(items[i], fn);
+        } });
+    deque->visitBlocks(0, deque->getLength(), visitor);
+}
+
+template <typename T, class Stage>
+int Pipeline<T, Stage>::count() const
+{
+    return reduce([](const int acc, const auto &)
+                  { return acc + 1; },
+                  0);
+}
@@ -1,51 +1,206 @@
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <vector>
 #include "../inc/segmentedDeque.hpp"
 
 template <typename T>
 SegmentedDeque<T>::SegmentedDeque(int segmentSize)
-    : segmentSize(segmentSize), totalSize(0)
+    : inlineSegmentInUse(false), segmentSize(segmentSize), totalSize(0)
 {
     if (segmentSize <= 0)
     {
         throw std::invalid_argument("Segment size must be positive");
     }
-    segments = new ListSequence<ArraySequence<T> *>();
+}
+
+template <typename T>
+SegmentedDeque<T>::SegmentedDeque(const T *items, const int count, int segmentSize)
+    : SegmentedDeque(segmentSize)
+{
+    appendRange(items, count);
 }
 
 template <typename T>
 SegmentedDeque<T>::SegmentedDeque(const SegmentedDeque<T> &other)
-    : segmentSize(other.segmentSize), totalSize(other.totalSize)
+    : inlineSegmentInUse(false), segmentSize(other.segmentSize), totalSize(0)
 {
-    segments = new ListSequence<ArraySequence<T> *>();
+    *this = other;
+}
 
-    for (int i = 0; i < other.segments->getLength(); i++)
+template <typename T>
+SegmentedDeque<T>::~SegmentedDeque()
+{
+    for (int i = 0; i < observers.getSize(); i++)
     {
-        ArraySequence<T> *newSegment = new ArraySequence<T>();
-        ArraySequence<T> *otherSegment = other.segments->get(i);
+        observers.unsafeGet(i)->dequeDestroyed();
+    }
+    observers.clear();
+    clear();
+}
 
-        for (int j = 0; j < otherSegment->getLength(); j++)
-        {
-            newSegment->append(otherSegment->get(j));
-        }
+template <typename T>
+SegmentedDeque<T> &SegmentedDeque<T>::operator=(const SegmentedDeque<T> &other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
 
-        segments->append(newSegment);
+    clear();
+    segmentSize = other.segmentSize;
+    for (int i = 0; i < other.segments.getSize(); i++)
+    {
+        const DynamicArray<T> *source = other.segments.unsafeGet(i);
+        DynamicArray<T> *segment = createSegment();
+        segment->appendRange(source->getData(), source->getSize());
+        segments.append(segment);
+    }
+    totalSize = other.totalSize;
+    rebuildIndex();
+    notifyReshaped();
+    if (totalSize > 0)
+    {
+        notifyInserted(0, totalSize);
     }
+    return *this;
 }
 
+// Hands out the inline segment while it is free, otherwise a heap segment with
+// room for a full segment.
 template <typename T>
-SegmentedDeque<T>::~SegmentedDeque()
+DynamicArray<T> *SegmentedDeque<T>::createSegment()
 {
-    if (segments)
+    if (!inlineSegmentInUse)
     {
-        for (int i = 0; i < segments->getLength(); i++)
-        {
-            if (segments->get(i))
-            {
-                delete segments->get(i);
-            }
-        }
-        delete segments;
+        inlineSegmentInUse = true;
+        return &inlineSegment;
+    }
+
+    DynamicArray<T> *segment = new DynamicArray<T>();
+    segment->reserve(segmentSize);
+    return segment;
+}
+
+template <typename T>
+void SegmentedDeque<T>::releaseSegment(DynamicArray<T> *segment)
+{
+    if (segment == &inlineSegment)
+    {
+        inlineSegment.clear();
+        inlineSegment.shrinkToFit();
+        inlineSegmentInUse = false;
+        return;
+    }
+    delete segment;
+}
+
+// Returns a segment of owner that this deque may keep. Heap segments change hands
+// as they are; owner's inline segment cannot leave it and is copied instead.
+template <typename T>
+DynamicArray<T> *SegmentedDeque<T>::adoptSegment(SegmentedDeque<T> &owner, DynamicArray<T> *segment)
+{
+    if (segment != &owner.inlineSegment)
+    {
+        return segment;
+    }
+
+    DynamicArray<T> *copy = createSegment();
+    copy->appendRange(segment->getData(), segment->getSize());
+    owner.releaseSegment(segment);
+    return copy;
+}
+
+template <typename T>
+void SegmentedDeque<T>::locate(const int index, int &segment, int &position) const
+{
+    segment = segmentIndex.find(index, position);
+}
+
+template <typename T>
+void SegmentedDeque<T>::rebuildIndex()
+{
+    segmentIndex.rebuild(segments.getSize(), [this](const int i)
+                         { return segments.unsafeGet(i)->getSize(); });
+}
+
+// Moves the back half of a full segment into a new segment right after it.
+template <typename T>
+void SegmentedDeque<T>::splitSegment(const int segment)
+{
+    DynamicArray<T> *source = segments.get(segment);
+    int half = source->getSize() / 2;
+
+    DynamicArray<T> *back = createSegment();
+    back->appendRange(source->getData() + half, source->getSize() - half);
+    source->resize(half);
+
+    segments.insertAt(back, segment + 1);
+    rebuildIndex();
+    notifyReshaped();
+}
+
+template <typename T>
+void SegmentedDeque<T>::notifyStored(const int segment, const T &item)
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        observers.unsafeGet(i)->itemStored(segment, item);
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::notifyTouched(const int segment)
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        observers.unsafeGet(i)->segmentTouched(segment);
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::notifyReshaped()
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        observers.unsafeGet(i)->segmentsReshaped();
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::notifyInserted(const int index, const int count)
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        observers.unsafeGet(i)->itemsInserted(index, count);
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::notifyErasing(const int index, const int count)
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        observers.unsafeGet(i)->itemsErasing(index, count);
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::notifyReplacing(const int index)
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        observers.unsafeGet(i)->itemReplacing(index);
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::notifyReplaced(const int index)
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        observers.unsafeGet(i)->itemReplaced(index);
     }
 }
 
@@ -56,7 +211,8 @@ T &SegmentedDeque<T>::getFirst()
     {
         throw std::out_of_range("Deque is empty");
     }
-    return segments->getFirst()->getFirst();
+    notifyTouched(0);
+    return segments.getFirst()->getFirst();
 }
 
 template <typename T>
@@ -66,7 +222,7 @@ const T &SegmentedDeque<T>::getFirst() const
     {
         throw std::out_of_range("Deque is empty");
     }
-    return segments->getFirst()->getFirst();
+    return segments.getFirst()->getFirst();
 }
 
 template <typename T>
@@ -76,7 +232,8 @@ T &SegmentedDeque<T>::getLast()
     {
         throw std::out_of_range("Deque is empty");
     }
-    return segments->getLast()->getLast();
+    notifyTouched(segments.getSize() - 1);
+    return segments.getLast()->getLast();
 }
 
 template <typename T>
@@ -86,7 +243,7 @@ const T &SegmentedDeque<T>::getLast() const
     {
         throw std::out_of_range("Deque is empty");
     }
-    return segments->getLast()->getLast();
+    return segments.getLast()->getLast();
 }
 
 template <typename T>
@@ -96,21 +253,7 @@ T &SegmentedDeque<T>::get(int index)
     {
         throw std::out_of_range("Index out of range");
     }
-
-    int currentIndex = 0;
-    for (int segmentIndex = 0; segmentIndex < segments->getLength(); ++segmentIndex)
-    {
-        ArraySequence<T> *segment = segments->get(segmentIndex);
-        int segmentLength = segment->getLength();
-        if (index < currentIndex + segmentLength)
-        {
-            int segmentPosition = index - currentIndex;
-            return segment->get(segmentPosition);
-        }
-        currentIndex += segmentLength;
-    }
-
-    throw std::out_of_range("Position in segment out of range");
+    return unsafeGet(index);
 }
 
 template <typename T>
@@ -120,106 +263,119 @@ const T &SegmentedDeque<T>::get(int index) const
     {
         throw std::out_of_range("Index out of range");
     }
+    return unsafeGet(index);
+}
 
-    int currentIndex = 0;
-    for (int segmentIndex = 0; segmentIndex < segments->getLength(); ++segmentIndex)
-    {
-        ArraySequence<T> *segment = segments->get(segmentIndex);
-        int segmentLength = segment->getLength();
-        if (index < currentIndex + segmentLength)
-        {
-            int segmentPosition = index - currentIndex;
-            return segment->get(segmentPosition);
-        }
-        currentIndex += segmentLength;
-    }
+template <typename T>
+T &SegmentedDeque<T>::at(const int index)
+{
+    return get(index);
+}
+
+template <typename T>
+const T &SegmentedDeque<T>::at(const int index) const
+{
+    return get(index);
+}
+
+template <typename T>
+T &SegmentedDeque<T>::unsafeGet(const int index)
+{
+    int segment, position;
+    locate(index, segment, position);
+    notifyTouched(segment);
+    return segments.unsafeGet(segment)->unsafeGet(position);
+}
+
+template <typename T>
+const T &SegmentedDeque<T>::unsafeGet(const int index) const
+{
+    int segment, position;
+    locate(index, segment, position);
+    return segments.unsafeGet(segment)->unsafeGet(position);
+}
+
+template <typename T>
+T &SegmentedDeque<T>::operator[](const int index)
+{
+#if SEQUENCE_BOUNDS_CHECK
+    return get(index);
+#else
+    return unsafeGet(index);
+#endif
+}
 
-    throw std::out_of_range("Position in segment out of range");
+template <typename T>
+const T &SegmentedDeque<T>::operator[](const int index) const
+{
+#if SEQUENCE_BOUNDS_CHECK
+    return get(index);
+#else
+    return unsafeGet(index);
+#endif
 }
 
 template <typename T>
 void SegmentedDeque<T>::append(const T &item)
 {
-    if (segments->getLength() == 0 || segments->getLast()->getLength() == segmentSize)
+    if (segments.getSize() == 0 || segments.getLast()->getSize() >= segmentSize)
     {
-        segments->append(new ArraySequence<T>());
+        segments.append(createSegment());
+        segmentIndex.push(0);
     }
 
-    segments->getLast()->append(item);
+    segments.getLast()->append(item);
+    segmentIndex.add(segments.getSize() - 1, 1);
     totalSize++;
+    notifyStored(segments.getSize() - 1, item);
+    notifyInserted(totalSize - 1, 1);
 }
 
 template <typename T>
 void SegmentedDeque<T>::prepend(const T &item)
 {
-    if (segments->getLength() == 0)
+    if (segments.getSize() == 0 || segments.getFirst()->getSize() >= segmentSize)
     {
-        ArraySequence<T> *newSegment = new ArraySequence<T>();
+        DynamicArray<T> *newSegment = createSegment();
         newSegment->append(item);
-        segments->append(newSegment);
+        segments.prepend(newSegment);
         totalSize++;
+        rebuildIndex();
+        notifyReshaped();
+        notifyInserted(0, 1);
         return;
     }
 
-    if (segments->getFirst()->getLength() == segmentSize)
-    {
-        ArraySequence<T> *newSegment = new ArraySequence<T>();
-        newSegment->append(item);
-        segments->prepend(newSegment);
-        totalSize++;
-
-        rebalanceSegments();
-        return;
-    }
-
-    segments->getFirst()->prepend(item);
+    segments.getFirst()->prepend(item);
+    segmentIndex.add(0, 1);
     totalSize++;
+    notifyStored(0, item);
+    notifyInserted(0, 1);
 }
 
+// Packs all elements into full segments, keeping their order.
 template <typename T>
 void SegmentedDeque<T>::rebalanceSegments()
 {
-    if (segments->getLength() <= 1)
-        return;
+    DynamicArray<DynamicArray<T> *> packed;
 
-    for (int i = 0; i < segments->getLength() - 1; i++)
+    for (int i = 0; i < segments.getSize(); i++)
     {
-        ArraySequence<T> *currentSegment = segments->get(i);
-        ArraySequence<T> *nextSegment = segments->get(i + 1);
-
-        while (currentSegment->getLength() < segmentSize && nextSegment->getLength() > 0)
+        DynamicArray<T> *segment = segments.get(i);
+        for (int j = 0; j < segment->getSize(); j++)
         {
-            currentSegment->append(nextSegment->getFirst());
-
-            ArraySequence<T> *tempSegment = new ArraySequence<T>();
-            for (int j = 1; j < nextSegment->getLength(); j++)
+            if (packed.getSize() == 0 || packed.getLast()->getSize() >= segmentSize)
             {
-                tempSegment->append(nextSegment->get(j));
+                packed.append(createSegment());
             }
-
-            delete nextSegment;
-            segments->set(i + 1, tempSegment);
-            nextSegment = tempSegment;
-        }
-    }
-
-    ListSequence<ArraySequence<T> *> *newSegments = new ListSequence<ArraySequence<T> *>();
-
-    for (int i = 0; i < segments->getLength(); i++)
-    {
-        ArraySequence<T> *segment = segments->get(i);
-        if (segment->getLength() > 0)
-        {
-            newSegments->append(segment);
-        }
-        else
-        {
-            delete segment;
+            packed.getLast()->append(segment->get(j));
         }
+        releaseSegment(segment);
     }
 
-    delete segments;
-    segments = newSegments;
+    segments = packed;
+    rebuildIndex();
+    notifyReshaped();
 }
 
 template <typename T>
@@ -242,20 +398,32 @@ void SegmentedDeque<T>::insertAt(const T &item, const int index)
         return;
     }
 
-    int segmentIndex = index / segmentSize;
-    int segmentPosition = index % segmentSize;
+    int segment, position;
+    locate(index, segment, position);
 
-    if (segmentIndex >= segments->getLength())
+    if (segments.get(segment)->getSize() >= segmentSize)
     {
-        throw std::out_of_range("Segment index out of range");
-    }
-    if (segmentPosition >= segments->get(segmentIndex)->getLength())
-    {
-        throw std::out_of_range("Position in segment out of range");
+        if (position == 0)
+        {
+            DynamicArray<T> *newSegment = createSegment();
+            newSegment->append(item);
+            segments.insertAt(newSegment, segment);
+            totalSize++;
+            rebuildIndex();
+            notifyReshaped();
+            notifyInserted(index, 1);
+            return;
+        }
+
+        splitSegment(segment);
+        locate(index, segment, position);
     }
 
-    segments->get(segmentIndex)->insertAt(item, segmentPosition);
+    segments.get(segment)->insertAt(item, position);
+    segmentIndex.add(segment, 1);
     totalSize++;
+    notifyStored(segment, item);
+    notifyInserted(index, 1);
 }
 
 template <typename T>
@@ -266,98 +434,440 @@ void SegmentedDeque<T>::set(const int index, const T &data)
         throw std::out_of_range("Index is out of range");
     }
 
-    int segmentIndex = index / segmentSize;
-    int segmentPosition = index % segmentSize;
-
-    segments->get(segmentIndex)->set(segmentPosition, data);
+    notifyReplacing(index);
+    int segment, position;
+    locate(index, segment, position);
+    segments.unsafeGet(segment)->unsafeGet(position) = data;
+    notifyStored(segment, data);
+    notifyReplaced(index);
 }
 
+// Shifts the rest of the item's segment; a segment left empty is released, so
+// segments never stay empty.
 template <typename T>
-void SegmentedDeque<T>::concat(const Sequence<T> *other)
+void SegmentedDeque<T>::erase(const int index)
 {
-    if (!other)
+    if (index < 0 || index >= totalSize)
     {
-        return;
+        throw std::out_of_range("Index is out of range");
     }
 
-    for (int i = 0; i < other->getLength(); i++)
+    notifyErasing(index, 1);
+    int segment, position;
+    locate(index, segment, position);
+    DynamicArray<T> *items = segments.unsafeGet(segment);
+    totalSize--;
+    if (items->getSize() == 1)
     {
-        append(other->get(i));
+        releaseSegment(items);
+        segments.removeAt(segment);
+        rebuildIndex();
+        notifyReshaped();
+        return;
     }
+
+    items->removeAt(position);
+    segmentIndex.add(segment, -1);
 }
 
+// Removes the first count items. Segments emptied entirely are released
+// without moving their items, so draining the deque from the front costs one
+// index rebuild per segment rather than a shift per item.
 template <typename T>
-int SegmentedDeque<T>::getLength() const
+void SegmentedDeque<T>::eraseFront(const int count)
 {
-    return totalSize;
+    if (count < 0 || count > totalSize)
+    {
+        throw std::out_of_range("Count is out of range");
+    }
+    if (count == 0)
+    {
+        return;
+    }
+
+    notifyErasing(0, count);
+    int released = 0;
+    int remaining = count;
+    while (remaining > 0 && segments.unsafeGet(released)->getSize() <= remaining)
+    {
+        remaining -= segments.unsafeGet(released)->getSize();
+        releaseSegment(segments.unsafeGet(released));
+        released++;
+    }
+
+    if (remaining > 0)
+    {
+        DynamicArray<T> *first = segments.unsafeGet(released);
+        T *items = first->getData();
+        for (int i = remaining; i < first->getSize(); i++)
+        {
+            items[i - remaining] = std::move(items[i]);
+        }
+        first->resize(first->getSize() - remaining);
+    }
+    totalSize -= count;
+
+    if (released == 0)
+    {
+        segmentIndex.add(0, -remaining);
+        return;
+    }
+    for (int i = released; i < segments.getSize(); i++)
+    {
+        segments.unsafeGet(i - released) = segments.unsafeGet(i);
+    }
+    segments.resize(segments.getSize() - released);
+    rebuildIndex();
+    notifyReshaped();
 }
 
 template <typename T>
-int SegmentedDeque<T>::getSegmentSize() const
+void SegmentedDeque<T>::concat(const Sequence<T> *other)
 {
-    return segmentSize;
+    if (!other)
+    {
+        return;
+    }
+
+    // Appending can move the segment being read, so a deque copies itself first.
+    if (other == this)
+    {
+        SegmentedDeque<T> copy(*this);
+        splice(copy);
+        return;
+    }
+
+    reserve(totalSize + other->getLength());
+    auto appender = makeBlockVisitor<T>([this](const T *items, const int count)
+                                        { appendRange(items, count); });
+    other->visitBlocks(0, other->getLength(), appender);
 }
 
 template <typename T>
-Sequence<T> *SegmentedDeque<T>::getSubsequence(const int startIndex, const int endIndex) const
+void SegmentedDeque<T>::visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const
 {
-    int size = getLength();
-    if (startIndex < 0 || startIndex >= size ||
-        endIndex < 0 || endIndex >= size ||
-        startIndex > endIndex)
+    this->checkBlockRange(startIndex, count);
+    if (count == 0)
     {
-        throw std::out_of_range("Invalid index range");
+        return;
     }
 
-    auto *newDq = new SegmentedDeque<T>(segmentSize);
+    int segment, position;
+    locate(startIndex, segment, position);
 
-    for (int i = startIndex; i <= endIndex; i++)
+    int remaining = count;
+    while (remaining > 0)
     {
-        newDq->append(get(i));
+        const DynamicArray<T> *source = segments.unsafeGet(segment);
+        int chunk = std::min(source->getSize() - position, remaining);
+        visitor.visit(source->getData() + position, chunk);
+        remaining -= chunk;
+        segment++;
+        position = 0;
     }
-
-    return newDq;
 }
 
 template <typename T>
-Sequence<T> *SegmentedDeque<T>::appendImmutable(const T &item) const
+void SegmentedDeque<T>::concat(SegmentedDeque<T> &&other)
 {
-    auto *newDq = new SegmentedDeque<T>(*this);
-    newDq->append(item);
-    return newDq;
+    splice(other);
 }
 
+// Takes over the segments of other, leaving it empty. Only the boundary segment
+// is copied, and only when it fits into the free room of this deque's last one.
 template <typename T>
-Sequence<T> *SegmentedDeque<T>::prependImmutable(const T &item) const
+void SegmentedDeque<T>::splice(SegmentedDeque<T> &other)
 {
-    auto *newDq = new SegmentedDeque<T>(*this);
-    newDq->prepend(item);
-    return newDq;
+    if (&other == this)
+    {
+        throw std::invalid_argument("Cannot splice a deque into itself");
+    }
+    if (other.totalSize == 0)
+    {
+        return;
+    }
+
+    int start = totalSize;
+    other.notifyErasing(0, other.totalSize);
+    int firstMoved = 0;
+    if (segments.getSize() > 0)
+    {
+        DynamicArray<T> *last = segments.getLast();
+        DynamicArray<T> *boundary = other.segments.getFirst();
+        if (last->getSize() + boundary->getSize() <= segmentSize)
+        {
+            last->appendRange(boundary->getData(), boundary->getSize());
+            other.releaseSegment(boundary);
+            firstMoved = 1;
+        }
+    }
+
+    for (int i = firstMoved; i < other.segments.getSize(); i++)
+    {
+        segments.append(adoptSegment(other, other.segments.unsafeGet(i)));
+    }
+    totalSize += other.totalSize;
+    rebuildIndex();
+
+    other.segments.clear();
+    other.segmentIndex.clear();
+    other.totalSize = 0;
+    notifyReshaped();
+    other.notifyReshaped();
+    notifyInserted(start, totalSize - start);
 }
 
+// Hands elements [index, length) over to a new deque by moving segment pointers;
+// only the segment that contains index is split by copying its tail.
 template <typename T>
-Sequence<T> *SegmentedDeque<T>::insertAtImmutable(const T &item, const int index) const
+SegmentedDeque<T> *SegmentedDeque<T>::splitAt(const int index)
 {
-    auto *newDq = new SegmentedDeque<T>(*this);
-    newDq->insertAt(item, index);
-    return newDq;
+    if (index < 0 || index > totalSize)
+    {
+        throw std::out_of_range("Index is out of range");
+    }
+
+    auto *result = new SegmentedDeque<T>(segmentSize);
+    if (index == totalSize)
+    {
+        return result;
+    }
+
+    notifyErasing(index, totalSize - index);
+    int segment, position;
+    locate(index, segment, position);
+
+    int firstMoved = segment;
+    if (position > 0)
+    {
+        DynamicArray<T> *source = segments.get(segment);
+        DynamicArray<T> *tail = result->createSegment();
+        tail->appendRange(source->getData() + position, source->getSize() - position);
+        result->segments.append(tail);
+        source->resize(position);
+        firstMoved = segment + 1;
+    }
+
+    for (int i = firstMoved; i < segments.getSize(); i++)
+    {
+        result->segments.append(result->adoptSegment(*this, segments.unsafeGet(i)));
+    }
+    segments.resize(firstMoved);
+
+    result->totalSize = totalSize - index;
+    totalSize = index;
+    rebuildIndex();
+    result->rebuildIndex();
+    notifyReshaped();
+
+    return result;
 }
 
 template <typename T>
-Sequence<T> *SegmentedDeque<T>::setImmutable(const int index, const T &data) const
+template <class InputIt>
+void SegmentedDeque<T>::assign(InputIt first, InputIt last)
 {
-    auto *newDq = new SegmentedDeque<T>(*this);
-    newDq->set(index, data);
-    return newDq;
+    clear();
+    appendRange(first, last);
 }
 
 template <typename T>
-Sequence<T> *SegmentedDeque<T>::concatImmutable(const Sequence<T> *other) const
+template <class InputIt>
+void SegmentedDeque<T>::appendRange(InputIt first, InputIt last)
 {
-    auto *newDq = new SegmentedDeque<T>(*this);
-    newDq->concat(other);
-    return newDq;
-}
+    while (first != last)
+    {
+        if (segments.getSize() == 0 || segments.getLast()->getSize() >= segmentSize)
+        {
+            segments.append(createSegment());
+            segmentIndex.push(0);
+        }
+
+        DynamicArray<T> *segment = segments.getLast();
+        int added = 0;
+        for (; first != last && segment->getSize() < segmentSize; ++first)
+        {
+            segment->append(*first);
+            added++;
+        }
+
+        segmentIndex.add(segments.getSize() - 1, added);
+        totalSize += added;
+        for (int i = segment->getSize() - added; observers.getSize() > 0 && i < segment->getSize(); i++)
+        {
+            notifyStored(segments.getSize() - 1, segment->unsafeGet(i));
+        }
+        notifyInserted(totalSize - added, added);
+    }
+}
+
+// Fills the free room of the last segment, then whole new segments, with one block copy each.
+template <typename T>
+void SegmentedDeque<T>::appendRange(const T *items, const int count)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Negative count");
+    }
+    if (count > 0 && !items)
+    {
+        throw std::invalid_argument("Null array with non-zero count");
+    }
+
+    int copied = 0;
+    while (copied < count)
+    {
+        if (segments.getSize() == 0 || segments.getLast()->getSize() >= segmentSize)
+        {
+            segments.append(createSegment());
+            segmentIndex.push(0);
+        }
+
+        DynamicArray<T> *segment = segments.getLast();
+        int chunk = std::min(segmentSize - segment->getSize(), count - copied);
+        segment->appendRange(items + copied, chunk);
+
+        segmentIndex.add(segments.getSize() - 1, chunk);
+        totalSize += chunk;
+        for (int i = 0; observers.getSize() > 0 && i < chunk; i++)
+        {
+            notifyStored(segments.getSize() - 1, items[copied + i]);
+        }
+        notifyInserted(totalSize - chunk, chunk);
+        copied += chunk;
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::reserve(const int count)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Invalid capacity");
+    }
+
+    int needed = count - totalSize;
+    if (needed <= 0)
+    {
+        return;
+    }
+
+    if (segments.getSize() > 0 && segments.getLast()->getSize() < segmentSize)
+    {
+        DynamicArray<T> *last = segments.getLast();
+        needed -= segmentSize - last->getSize();
+        last->reserve(segmentSize);
+    }
+
+    if (needed > 0)
+    {
+        segments.reserve(segments.getSize() + (needed + segmentSize - 1) / segmentSize);
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::clear()
+{
+    if (totalSize > 0)
+    {
+        notifyErasing(0, totalSize);
+    }
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        releaseSegment(segments.unsafeGet(i));
+    }
+    segments.clear();
+    segmentIndex.clear();
+    totalSize = 0;
+    notifyReshaped();
+}
+
+template <typename T>
+int SegmentedDeque<T>::getLength() const
+{
+    return totalSize;
+}
+
+template <typename T>
+int SegmentedDeque<T>::getSegmentSize() const
+{
+    return segmentSize;
+}
+
+// Index of the first item of segment.
+template <typename T>
+int SegmentedDeque<T>::getSegmentStart(const int segment) const
+{
+    if (segment < 0 || segment >= segments.getSize())
+    {
+        throw std::out_of_range("Segment out of range");
+    }
+    return segmentIndex.prefixSum(segment);
+}
+
+template <typename T>
+int SegmentedDeque<T>::getSegmentLength(const int segment) const
+{
+    return segments.get(segment)->getSize();
+}
+
+template <typename T>
+Sequence<T> *SegmentedDeque<T>::getSubsequence(const int startIndex, const int endIndex) const
+{
+    int size = getLength();
+    if (startIndex < 0 || startIndex >= size ||
+        endIndex < 0 || endIndex >= size ||
+        startIndex > endIndex)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+
+    auto *newDq = new SegmentedDeque<T>(segmentSize);
+    auto appender = makeBlockVisitor<T>([newDq](const T *items, const int count)
+                                        { newDq->appendRange(items, count); });
+    visitBlocks(startIndex, endIndex - startIndex + 1, appender);
+    return newDq;
+}
+
+template <typename T>
+Sequence<T> *SegmentedDeque<T>::appendImmutable(const T &item) const
+{
+    auto *newDq = new SegmentedDeque<T>(*this);
+    newDq->append(item);
+    return newDq;
+}
+
+template <typename T>
+Sequence<T> *SegmentedDeque<T>::prependImmutable(const T &item) const
+{
+    auto *newDq = new SegmentedDeque<T>(*this);
+    newDq->prepend(item);
+    return newDq;
+}
+
+template <typename T>
+Sequence<T> *SegmentedDeque<T>::insertAtImmutable(const T &item, const int index) const
+{
+    auto *newDq = new SegmentedDeque<T>(*this);
+    newDq->insertAt(item, index);
+    return newDq;
+}
+
+template <typename T>
+Sequence<T> *SegmentedDeque<T>::setImmutable(const int index, const T &data) const
+{
+    auto *newDq = new SegmentedDeque<T>(*this);
+    newDq->set(index, data);
+    return newDq;
+}
+
+template <typename T>
+Sequence<T> *SegmentedDeque<T>::concatImmutable(const Sequence<T> *other) const
+{
+    auto *newDq = new SegmentedDeque<T>(*this);
+    newDq->concat(other);
+    return newDq;
+}
 
 template <typename T>
 void SegmentedDeque<T>::print() const
@@ -368,154 +878,825 @@ void SegmentedDeque<T>::print() const
         return;
     }
 
-    std::cout << "Total segments: " << segments->getLength() << ", Total size: " << totalSize << std::endl;
-    for (int i = 0; i < segments->getLength(); i++)
+    std::cout << "Total segments: " << segments.getSize() << ", Total size: " << totalSize << std::endl;
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        std::cout << "Segment " << i << " (length: " << segments.get(i)->getSize() << "): ";
+        segments.get(i)->print();
+        std::cout << std::endl;
+    }
+}
+
+template <typename T>
+void SegmentedDeque<T>::save(std::ostream &os) const
+{
+    DequeFileHeader header = {};
+    header.magic = DEQUE_FILE_MAGIC;
+    header.version = DEQUE_FILE_VERSION;
+    header.typeTag = TypeTag<T>::value;
+    header.elementSize = Serializer<T>::isRaw ? sizeof(T) : 0;
+    header.segmentSize = static_cast<uint32_t>(segmentSize);
+    header.segmentCount = static_cast<uint32_t>(segments.getSize());
+    header.totalSize = static_cast<uint64_t>(totalSize);
+    writeBinary(os, header);
+
+    const char padding[DEQUE_FILE_ALIGNMENT] = {};
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const DynamicArray<T> *segment = segments.get(i);
+
+        DequeSegmentHeader segmentHeader = {};
+        segmentHeader.length = static_cast<uint32_t>(segment->getSize());
+        writeBinary(os, segmentHeader);
+
+        Serializer<T>::write(os, segment->getData(), segment->getSize());
+        if (Serializer<T>::isRaw)
+        {
+            os.write(padding, paddingFor(static_cast<uint64_t>(sizeof(T)) * segmentHeader.length));
+        }
+    }
+
+    if (!os)
+    {
+        throw std::runtime_error("Failed to write deque");
+    }
+}
+
+template <typename T>
+SegmentedDeque<T> *SegmentedDeque<T>::load(std::istream &is)
+{
+    DequeFileHeader header;
+    readBinary(is, header);
+
+    if (header.magic != DEQUE_FILE_MAGIC || header.version != DEQUE_FILE_VERSION)
+    {
+        throw std::runtime_error("Stream does not contain a serialized deque");
+    }
+    if (header.typeTag != TypeTag<T>::value ||
+        header.elementSize != (Serializer<T>::isRaw ? sizeof(T) : 0))
+    {
+        throw std::runtime_error("Serialized element type does not match");
+    }
+    if (header.segmentSize == 0 || header.segmentSize > static_cast<uint32_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::runtime_error("Serialized segment size is invalid");
+    }
+
+    auto *result = new SegmentedDeque<T>(static_cast<int>(header.segmentSize));
+    try
+    {
+        char padding[DEQUE_FILE_ALIGNMENT];
+        for (uint32_t i = 0; i < header.segmentCount; i++)
+        {
+            DequeSegmentHeader segmentHeader;
+            readBinary(is, segmentHeader);
+            if (!is)
+            {
+                throw std::runtime_error("Unexpected end of stream");
+            }
+            // Segments are never empty and never exceed the segment size.
+            if (segmentHeader.length == 0 || segmentHeader.length > header.segmentSize)
+            {
+                throw std::runtime_error("Serialized segment length is invalid");
+            }
+
+            DynamicArray<T> *segment = result->createSegment();
+            segment->resize(static_cast<int>(segmentHeader.length));
+            result->segments.append(segment);
+
+            Serializer<T>::read(is, segment->getData(), segment->getSize());
+            if (Serializer<T>::isRaw)
+            {
+                is.read(padding, paddingFor(static_cast<uint64_t>(sizeof(T)) * segmentHeader.length));
+            }
+            if (!is)
+            {
+                throw std::runtime_error("Unexpected end of stream");
+            }
+
+            result->totalSize += segment->getSize();
+        }
+
+        result->rebuildIndex();
+
+        if (static_cast<uint64_t>(result->totalSize) != header.totalSize)
+        {
+            throw std::runtime_error("Serialized deque size does not match its segments");
+        }
+    }
+    catch (...)
+    {
+        delete result;
+        throw;
+    }
+
+    return result;
+}
+
+template <typename T>
+template <class InputIt, class OutputIt, class UnaryOp>
+OutputIt SegmentedDeque<T>::apply(InputIt first1, InputIt last1, OutputIt destFirst, const UnaryOp unaryOp)
+{
+    while (first1 != last1)
+    {
+        *destFirst = unaryOp(*first1);
+        ++first1;
+        ++destFirst;
+    }
+
+    return destFirst;
+}
+
+template <typename T>
+template <class InputIt1, class InputIt2, class OutputIt, class BinaryOp>
+OutputIt SegmentedDeque<T>::apply(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt destFirst, const BinaryOp binaryOp)
+{
+    while (first1 != last1)
+    {
+        *destFirst = binaryOp(*first1, *first2);
+        ++first1;
+        ++first2;
+        ++destFirst;
+    }
+
+    return destFirst;
+}
+
+template <typename T>
+template <typename Predicate>
+SegmentedDeque<T> *SegmentedDeque<T>::where(const Predicate &pred) const
+{
+    auto *result = new SegmentedDeque<T>(this->segmentSize);
+    this->forEach([result, &pred](const T &item)
+                  {
+        if (pred(item))
+        {
+            result->append(item);
+        } });
+    return result;
+}
+
+//* { Views
+template <typename T>
+DequeSlice<T> SegmentedDeque<T>::view() const
+{
+    return DequeSlice<T>(this, 0, totalSize);
+}
+
+// Zero-copy counterpart of getSubsequence; endIndex is inclusive as well.
+template <typename T>
+DequeSlice<T> SegmentedDeque<T>::slice(const int startIndex, const int endIndex) const
+{
+    if (startIndex < 0 || endIndex >= totalSize || startIndex > endIndex)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+    return DequeSlice<T>(this, startIndex, endIndex - startIndex + 1);
+}
+
+template <typename T>
+template <class Predicate>
+FilterView<DequeSlice<T>, Predicate> SegmentedDeque<T>::filterView(const Predicate &pred) const
+{
+    return view().filterView(pred);
+}
+
+template <typename T>
+template <class Fn>
+MapView<DequeSlice<T>, Fn> SegmentedDeque<T>::mapView(const Fn &fn) const
+{
+    return view().mapView(fn);
+}
+
+template <typename T>
+template <class Other>
+ZipView<DequeSlice<T>, Other> SegmentedDeque<T>::zipView(const Other &other) const
+{
+    return view().zipView(other);
+}
+
+template <typename T>
+template <typename U>
+ZipView<DequeSlice<T>, DequeSlice<U>> SegmentedDeque<T>::zipView(const SegmentedDeque<U> &other) const
+{
+    return view().zipView(other.view());
+}
+//* } Views
+
+//* { Observers
+template <typename T>
+void SegmentedDeque<T>::addObserver(DequeObserver<T> *observer)
+{
+    if (!observer)
+    {
+        throw std::invalid_argument("Observer cannot be null");
+    }
+    observers.append(observer);
+}
+
+template <typename T>
+void SegmentedDeque<T>::removeObserver(DequeObserver<T> *observer)
+{
+    for (int i = 0; i < observers.getSize(); i++)
+    {
+        if (observers.unsafeGet(i) == observer)
+        {
+            observers.unsafeGet(i) = observers.getLast();
+            observers.resize(observers.getSize() - 1);
+            return;
+        }
+    }
+}
+
+template <typename T>
+ZoneMap<T> *SegmentedDeque<T>::zoneMap()
+{
+    return new ZoneMap<T>(*this);
+}
+
+template <typename T>
+template <class KeyFn>
+ZoneMap<T, KeyFn> *SegmentedDeque<T>::zoneMap(const KeyFn &keyFn)
+{
+    return new ZoneMap<T, KeyFn>(*this, keyFn);
+}
+
+template <typename T>
+HashIndex<T, IdentityKey> *SegmentedDeque<T>::hashIndex()
+{
+    return new HashIndex<T, IdentityKey>(*this);
+}
+
+template <typename T>
+template <class KeyFn>
+HashIndex<T, KeyFn> *SegmentedDeque<T>::hashIndex(const KeyFn &keyFn)
+{
+    return new HashIndex<T, KeyFn>(*this, keyFn);
+}
+//* } Observers
+
+template <typename T>
+Pipeline<T> SegmentedDeque<T>::pipeline() const
+{
+    return Pipeline<T>(this);
+}
+
+// Results use this deque's segment size.
+template <typename T>
+template <class KeyFn>
+GroupBy<T, KeyFn> SegmentedDeque<T>::groupBy(const KeyFn &keyFn) const
+{
+    return GroupBy<T, KeyFn>(this, keyFn, segmentSize);
+}
+
+//* { Joins
+// visit(item, otherItem) for every pair with equal keys; see HashJoin.
+template <typename T>
+template <typename U, class LeftKey, class RightKey, class Visitor>
+void SegmentedDeque<T>::hashJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey, const RightKey &rightKey,
+                                 const Visitor &visit, const int threadCount) const
+{
+    HashJoin<T, U, LeftKey, RightKey>(this, &other, leftKey, rightKey).forEach(visit, threadCount);
+}
+
+template <typename T>
+template <typename U, class LeftKey, class RightKey>
+SegmentedDeque<Joined<T, U>> *SegmentedDeque<T>::hashJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey,
+                                                          const RightKey &rightKey, const int threadCount) const
+{
+    return HashJoin<T, U, LeftKey, RightKey>(this, &other, leftKey, rightKey).toDeque(segmentSize, threadCount);
+}
+
+// Both deques must be sorted ascending by their keys; see MergeJoin.
+template <typename T>
+template <typename U, class LeftKey, class RightKey, class Visitor>
+void SegmentedDeque<T>::mergeJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey, const RightKey &rightKey,
+                                  const Visitor &visit) const
+{
+    MergeJoin<T, U, LeftKey, RightKey>(this, &other, leftKey, rightKey).forEach(visit);
+}
+
+template <typename T>
+template <typename U, class LeftKey, class RightKey>
+SegmentedDeque<Joined<T, U>> *SegmentedDeque<T>::mergeJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey,
+                                                           const RightKey &rightKey) const
+{
+    return MergeJoin<T, U, LeftKey, RightKey>(this, &other, leftKey, rightKey).toDeque(segmentSize);
+}
+//* } Joins
+
+template <typename T>
+template <class Visitor>
+void SegmentedDeque<T>::forEachBlock(const Visitor &visit) const
+{
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const DynamicArray<T> *segment = segments.getData()[i];
+        visit(segment->getData(), segment->getSize());
+    }
+}
+
+template <typename T>
+template <class Visitor>
+void SegmentedDeque<T>::forEachBlock(const Visitor &visit)
+{
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        notifyTouched(i);
+        DynamicArray<T> *segment = segments.getData()[i];
+        visit(segment->getData(), segment->getSize());
+    }
+}
+
+// Like forEachBlock, but only over the items [startIndex, startIndex + count).
+template <typename T>
+template <class Visitor>
+void SegmentedDeque<T>::forEachBlockIn(const int startIndex, const int count, const Visitor &visit)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    int segment, position;
+    locate(startIndex, segment, position);
+
+    int remaining = count;
+    while (remaining > 0)
+    {
+        notifyTouched(segment);
+        DynamicArray<T> *target = segments.getData()[segment];
+        int chunk = std::min(target->getSize() - position, remaining);
+        visit(target->getData() + position, chunk);
+        remaining -= chunk;
+        segment++;
+        position = 0;
+    }
+}
+
+// Sorts the items in [first, last). Stable and adaptive: a sorted deque is
+// detected in one pass and left alone, otherwise the range is moved into one
+// buffer, TimSorted there, so runs that span segment boundaries are found as
+// well, and moved back.
+template <typename T>
+template <class RandomIt, class Compare>
+void SegmentedDeque<T>::sort(RandomIt first, RandomIt last, Compare compare)
+{
+    int startIndex = static_cast<int>(first - begin());
+    int count = static_cast<int>(last - first);
+    if (startIndex < 0 || count < 0 || startIndex + count > totalSize)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+    if (count <= 1 || (count == totalSize && isSorted(compare)))
+    {
+        return;
+    }
+
+    std::vector<T> buffer;
+    buffer.reserve(count);
+    forEachBlockIn(startIndex, count, [&buffer](T *items, const int chunk)
+                   { buffer.insert(buffer.end(), std::make_move_iterator(items), std::make_move_iterator(items + chunk)); });
+
+    timSort(buffer.data(), count, compare);
+
+    int next = 0;
+    forEachBlockIn(startIndex, count, [&buffer, &next](T *items, const int chunk)
+                   {
+        std::move(buffer.begin() + next, buffer.begin() + next + chunk, items);
+        next += chunk; });
+}
+
+template <typename T>
+template <class Compare>
+bool SegmentedDeque<T>::isSorted(Compare compare) const
+{
+    const T *previous = nullptr;
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const DynamicArray<T> *segment = segments.unsafeGet(i);
+        const T *items = segment->getData();
+        int count = segment->getSize();
+        if (count == 0)
+        {
+            continue;
+        }
+        if (previous && compare(items[0], *previous))
+        {
+            return false;
+        }
+        for (int j = 1; j < count; j++)
+        {
+            if (compare(items[j], items[j - 1]))
+            {
+                return false;
+            }
+        }
+        previous = items + count - 1;
+    }
+    return true;
+}
+
+template <typename T>
+template <class RandomIt>
+SegmentedDeque<T> *SegmentedDeque<T>::sortImmutable(RandomIt first, RandomIt last)
+{
+    return sortImmutable(first, last, std::less<T>());
+}
+
+template <typename T>
+template <class RandomIt, class Compare>
+SegmentedDeque<T> *SegmentedDeque<T>::sortImmutable(RandomIt first, RandomIt last, Compare compare)
+{
+    SegmentedDeque<T> *newDq = new SegmentedDeque<T>(*this);
+    newDq->sort(newDq->begin() + (first - begin()), newDq->begin() + (last - begin()), compare);
+    return newDq;
+}
+
+template <typename T>
+template <class RandomIt>
+void SegmentedDeque<T>::sort(RandomIt first, RandomIt last)
+{
+    sort(first, last, std::less<T>());
+}
+
+// Stable sort that calls keyFn once per item: (key, item) pairs are sorted by
+// key and the items are then copied into fresh, full segments in one pass.
+template <typename T>
+template <class KeyFn, class Compare>
+void SegmentedDeque<T>::sortByKey(const KeyFn &keyFn, Compare compare)
+{
+    using Key = typename std::decay<decltype(keyFn(std::declval<const T &>()))>::type;
+
+    if (totalSize <= 1)
+    {
+        return;
+    }
+
+    std::vector<std::pair<Key, const T *>> keyed;
+    keyed.reserve(totalSize);
+    const SegmentedDeque<T> &self = *this;
+    self.forEachBlock([&keyed, &keyFn](const T *items, const int count)
+                      {
+        for (int i = 0; i < count; i++)
+        {
+            keyed.emplace_back(keyFn(items[i]), items + i);
+        } });
+
+    std::stable_sort(keyed.begin(), keyed.end(), [&compare](const std::pair<Key, const T *> &a, const std::pair<Key, const T *> &b)
+                     { return compare(a.first, b.first); });
+
+    SegmentedDeque<T> sorted(segmentSize);
+    sorted.reserve(totalSize);
+    for (const std::pair<Key, const T *> &entry : keyed)
+    {
+        sorted.append(*entry.second);
+    }
+
+    clear();
+    splice(sorted);
+}
+
+template <typename T>
+template <class KeyFn, class Compare>
+SegmentedDeque<T> *SegmentedDeque<T>::sortByKeyImmutable(const KeyFn &keyFn, Compare compare) const
+{
+    auto *newDq = new SegmentedDeque<T>(*this);
+    newDq->sortByKey(keyFn, compare);
+    return newDq;
+}
+
+//* { Selection
+// Introselect in place over the segment-aware iterators: afterwards the item at
+// k is the one a full sort would put there, with nothing greater before it and
+// nothing less after it.
+template <typename T>
+template <class Compare>
+void SegmentedDeque<T>::nthElement(const int k, Compare compare)
+{
+    if (k < 0 || k >= totalSize)
     {
-        std::cout << "Segment " << i << " (length: " << segments->get(i)->getLength() << "): ";
-        segments->get(i)->print();
-        std::cout << std::endl;
+        throw std::out_of_range("Index out of range");
     }
+    introSelect(begin(), begin() + k, end(), compare);
 }
 
+// Puts the k smallest items in front, sorted; the order of the rest is
+// unspecified.
 template <typename T>
-template <class InputIt, class OutputIt, class UnaryOp>
-OutputIt SegmentedDeque<T>::apply(InputIt first1, InputIt last1, OutputIt destFirst, const UnaryOp unaryOp)
+template <class Compare>
+void SegmentedDeque<T>::partialSort(const int k, Compare compare)
 {
-    while (first1 != last1)
+    if (k < 0 || k > totalSize)
     {
-        *destFirst = unaryOp(*first1);
-        ++first1;
-        ++destFirst;
+        throw std::out_of_range("Index out of range");
+    }
+    if (k < totalSize)
+    {
+        introSelect(begin(), begin() + k, end(), compare);
     }
 
-    return destFirst;
+    std::vector<T> buffer;
+    buffer.reserve(k);
+    for (Iterator it = begin(); buffer.size() < static_cast<size_t>(k); ++it)
+    {
+        buffer.push_back(std::move(*it));
+    }
+    timSort(buffer.data(), k, compare);
+    std::move(buffer.begin(), buffer.end(), begin());
 }
 
+// The k items with the greatest keys, best first, in a new deque; of equal keys
+// the earlier item comes first. One pass over the segments offers every item
+// to a bounded heap, so nothing is copied but the result. With several threads
+// each scans a contiguous range into its own heap and the heaps are merged at
+// the end; keyFn and compare are then called concurrently.
 template <typename T>
-template <class InputIt1, class InputIt2, class OutputIt, class BinaryOp>
-OutputIt SegmentedDeque<T>::apply(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt destFirst, const BinaryOp binaryOp)
+template <class KeyFn, class Compare>
+SegmentedDeque<T> *SegmentedDeque<T>::topK(const int k, const KeyFn &keyFn, Compare compare, const int threadCount) const
 {
-    while (first1 != last1)
+    using Key = typename std::decay<decltype(keyFn(std::declval<const T &>()))>::type;
+    using Heap = TopKHeap<T, Key, Compare>;
+
+    if (k < 0)
     {
-        *destFirst = binaryOp(*first1, *first2);
-        ++first1;
-        ++first2;
-        ++destFirst;
+        throw std::invalid_argument("Count must not be negative");
+    }
+    int parts = parallelPartCount(totalSize, threadCount);
+    std::vector<Heap> heaps;
+    heaps.reserve(parts);
+    for (int part = 0; part < parts; part++)
+    {
+        heaps.emplace_back(std::min(k, totalSize), compare);
     }
 
-    return destFirst;
-}
+    parallelRanges(totalSize, parts, [&](const int part, const int start, const int end)
+                   {
+        Heap &heap = heaps[part];
+        int index = start;
+        auto offer = makeBlockVisitor<T>([&heap, &keyFn, &index](const T *items, const int count)
+                                         {
+            for (int i = 0; i < count; i++, index++)
+            {
+                heap.offer(keyFn(items[i]), index, items + i);
+            } });
+        visitBlocks(start, end - start, offer); });
 
-template <typename T>
-template <typename Predicate>
-SegmentedDeque<T> *SegmentedDeque<T>::where(const Predicate &pred) const
-{
-    auto *result = new SegmentedDeque<T>(this->segmentSize);
-    for (int i = 0; i < this->getLength(); i++)
+    for (int part = 1; part < parts; part++)
     {
-        const T &item = this->get(i);
-        if (pred(item))
-        {
-            result->append(item);
-        }
+        heaps[0].merge(std::move(heaps[part]));
     }
+
+    auto *result = new SegmentedDeque<T>(segmentSize);
+    heaps[0].forEachBest([result](const T &item)
+                         { result->append(item); });
     return result;
 }
-
+//* } Selection
+
+//* { Sorted
+// Finds where the prefix of items satisfying before ends: a binary search over
+// the first items of the segments picks the last segment that starts inside
+// the prefix, and a second one inside that segment the position. The result may
+// be one past the end of that segment. Segments are never empty, so every
+// segment has a first item to compare.
 template <typename T>
-template <typename R, typename BinaryOp>
-R SegmentedDeque<T>::reduce(const BinaryOp &op, R init) const
+template <class Predicate>
+void SegmentedDeque<T>::partitionPoint(const Predicate &before, int &segment, int &position) const
 {
-    for (int i = 0; i < this->getLength(); i++)
+    int lo = 0;
+    int hi = segments.getSize();
+    while (lo < hi)
     {
-        init = op(init, this->get(i));
+        int mid = lo + (hi - lo) / 2;
+        if (before(segments.unsafeGet(mid)->unsafeGet(0)))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
     }
-    return init;
-}
 
-template <typename T>
-template <class RandomIt, class Compare>
-void SegmentedDeque<T>::sort(RandomIt first, RandomIt last, Compare compare)
-{
-    int n = this->getLength();
-    if (n <= 1)
+    if (lo == 0)
     {
+        segment = 0;
+        position = 0;
         return;
     }
 
-    mergeSort(0, n - 1, compare);
+    segment = lo - 1;
+    const DynamicArray<T> *items = segments.unsafeGet(segment);
+    lo = 1;
+    hi = items->getSize();
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (before(items->unsafeGet(mid)))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    position = lo;
 }
 
+// Index of the first item not ordered before value; the deque must be sorted by
+// compare.
 template <typename T>
-template <class RandomIt>
-SegmentedDeque<T> *SegmentedDeque<T>::sortImmutable(RandomIt first, RandomIt last)
+template <class Compare>
+int SegmentedDeque<T>::lowerBound(const T &value, Compare compare) const
 {
-    auto *newDq = new SegmentedDeque<T>(*this);
-    newDq->sort(first, last);
-    return newDq;
+    int segment, position;
+    partitionPoint([&](const T &item)
+                   { return compare(item, value); },
+                   segment, position);
+    return segmentIndex.prefixSum(segment) + position;
 }
 
+// Index of the first item ordered after value.
 template <typename T>
-template <class RandomIt, class Compare>
-SegmentedDeque<T> *SegmentedDeque<T>::sortImmutable(RandomIt first, RandomIt last, Compare compare)
+template <class Compare>
+int SegmentedDeque<T>::upperBound(const T &value, Compare compare) const
 {
-    SegmentedDeque<T> *newDq = new SegmentedDeque<T>(*this);
-    newDq->sort(first, last, compare);
-    return newDq;
+    int segment, position;
+    partitionPoint([&](const T &item)
+                   { return !compare(value, item); },
+                   segment, position);
+    return segmentIndex.prefixSum(segment) + position;
 }
 
+// [first, second) holds the items equivalent to value.
 template <typename T>
-template <class RandomIt>
-void SegmentedDeque<T>::sort(RandomIt first, RandomIt last)
+template <class Compare>
+std::pair<int, int> SegmentedDeque<T>::equalRange(const T &value, Compare compare) const
 {
-    sort(first, last, std::less<T>());
+    return std::make_pair(lowerBound(value, compare), upperBound(value, compare));
 }
 
+// Inserts item after any equal items and returns its index. Only the segment
+// that receives it is shifted. When that one is full, an item for either end of
+// the deque starts a new segment, as append and prepend do, one for the end of
+// a segment goes to the front of the next one if it has room or else into a
+// segment of its own when the full one holds a single item, and otherwise the
+// segment is split in half first.
 template <typename T>
 template <class Compare>
-void SegmentedDeque<T>::mergeSort(int left, int right, Compare compare)
+int SegmentedDeque<T>::insertSorted(const T &item, Compare compare)
 {
-    if (left >= right)
-    {
-        return;
-    }
-
-    int mid = left + (right - left) / 2;
-    mergeSort(left, mid, compare);
-    mergeSort(mid + 1, right, compare);
-
-    std::vector<T> buffer(right - left + 1);
-    for (int i = 0; i < buffer.size(); ++i)
+    if (totalSize == 0)
     {
-        buffer[i] = this->get(left + i);
+        append(item);
+        return 0;
     }
 
-    int i = 0;
-    int j = mid - left + 1;
-    int k = left;
+    int segment, position;
+    partitionPoint([&](const T &other)
+                   { return !compare(item, other); },
+                   segment, position);
 
-    while (i <= mid - left && j < buffer.size())
+    int size = segments.unsafeGet(segment)->getSize();
+    if (size >= segmentSize)
     {
-        if (compare(buffer[i], buffer[j]))
+        if (position == 0)
+        {
+            prepend(item);
+            return 0;
+        }
+        if (position == size && segment + 1 == segments.getSize())
         {
-            this->set(k++, buffer[i++]);
+            append(item);
+            return totalSize - 1;
+        }
+        if (position == size && segments.unsafeGet(segment + 1)->getSize() < segmentSize)
+        {
+            segment++;
+            position = 0;
+        }
+        else if (size < 2)
+        {
+            // A one-item segment cannot be split; the item gets a segment of
+            // its own right after it, as insertAt does for its first position.
+            DynamicArray<T> *newSegment = createSegment();
+            newSegment->append(item);
+            segments.insertAt(newSegment, segment + 1);
+            totalSize++;
+            rebuildIndex();
+            notifyReshaped();
+            int index = segmentIndex.prefixSum(segment + 1);
+            notifyInserted(index, 1);
+            return index;
         }
         else
         {
-            this->set(k++, buffer[j++]);
+            splitSegment(segment);
+            int half = size / 2;
+            if (position > half)
+            {
+                segment++;
+                position -= half;
+            }
         }
     }
 
-    while (i <= mid - left)
+    segments.unsafeGet(segment)->insertAt(item, position);
+    segmentIndex.add(segment, 1);
+    totalSize++;
+    notifyStored(segment, item);
+    int index = segmentIndex.prefixSum(segment) + position;
+    notifyInserted(index, 1);
+    return index;
+}
+
+// Linear, stable merge of two deques sorted by compare into a new deque with
+// full segments; of equal items those of this deque come first. Both sides are
+// read segment by segment through raw pointers, merged items are stored one
+// block copy per segment, and whatever is left of one side is copied a whole
+// source segment at a time.
+template <typename T>
+template <class Compare>
+SegmentedDeque<T> *SegmentedDeque<T>::mergeSorted(const SegmentedDeque<T> &other, Compare compare) const
+{
+    auto *result = new SegmentedDeque<T>(segmentSize);
+    try
     {
-        this->set(k++, buffer[i++]);
-    }
+        result->reserve(totalSize + other.totalSize);
+        int leftSegment = 0;
+        int rightSegment = 0;
+        const T *left = nullptr;
+        const T *leftEnd = nullptr;
+        const T *right = nullptr;
+        const T *rightEnd = nullptr;
+        auto nextSegment = [](const SegmentedDeque<T> &deque, int &segment, const T *&item, const T *&end)
+        {
+            if (segment == deque.segments.getSize())
+            {
+                return false;
+            }
+            const DynamicArray<T> *items = deque.segments.unsafeGet(segment++);
+            item = items->getData();
+            end = item + items->getSize();
+            return true;
+        };
+
+        std::vector<T> block;
+        block.reserve(segmentSize);
+        auto flush = [&block, result]()
+        {
+            result->appendRange(block.data(), static_cast<int>(block.size()));
+            block.clear();
+        };
+
+        bool leftMore = nextSegment(*this, leftSegment, left, leftEnd);
+        bool rightMore = nextSegment(other, rightSegment, right, rightEnd);
+        while (leftMore && rightMore)
+        {
+            if (compare(*right, *left))
+            {
+                block.push_back(*right++);
+                if (right == rightEnd)
+                {
+                    rightMore = nextSegment(other, rightSegment, right, rightEnd);
+                }
+            }
+            else
+            {
+                block.push_back(*left++);
+                if (left == leftEnd)
+                {
+                    leftMore = nextSegment(*this, leftSegment, left, leftEnd);
+                }
+            }
+            if (static_cast<int>(block.size()) == segmentSize)
+            {
+                flush();
+            }
+        }
+        flush();
 
-    while (j < buffer.size())
+        while (leftMore)
+        {
+            result->appendRange(left, static_cast<int>(leftEnd - left));
+            leftMore = nextSegment(*this, leftSegment, left, leftEnd);
+        }
+        while (rightMore)
+        {
+            result->appendRange(right, static_cast<int>(rightEnd - right));
+            rightMore = nextSegment(other, rightSegment, right, rightEnd);
+        }
+    }
+    catch (...)
     {
-        this->set(k++, buffer[j++]);
+        delete result;
+        throw;
     }
+    return result;
 }
+//* } Sorted
 
 template <typename T>
 template <class ForwardIt1, class ForwardIt2>
@@ -556,21 +1737,57 @@ bool SegmentedDeque<T>::searchSubsequence(ForwardIt1 first, ForwardIt1 last, For
 //* { Iterator
 template <typename T>
 SegmentedDeque<T>::Iterator::Iterator(SegmentedDeque<T> *deque, const int index)
-    : deque(deque), index(index) {}
+    : deque(deque), index(index), segment(0), position(0)
+{
+    if (index >= 0 && index < deque->totalSize)
+    {
+        deque->locate(index, segment, position);
+    }
+    else if (index >= deque->totalSize)
+    {
+        segment = deque->segments.getSize();
+    }
+}
 
 template <typename T>
-T &SegmentedDeque<T>::Iterator::operator*()
+T &SegmentedDeque<T>::Iterator::operator*() const
 {
     if (index < 0 || index >= deque->getLength())
     {
         throw std::out_of_range("Iterator out of range");
     }
-    return deque->get(index);
+    deque->notifyTouched(segment);
+    return deque->segments.unsafeGet(segment)->unsafeGet(position);
+}
+
+// Jumps inside the current segment only adjust the position; anything else
+// looks the target up in the segment index.
+template <typename T>
+void SegmentedDeque<T>::Iterator::moveBy(const difference_type offset)
+{
+    int target = index + static_cast<int>(offset);
+    if (segment < deque->segments.getSize())
+    {
+        int inSegment = position + static_cast<int>(offset);
+        if (inSegment >= 0 && inSegment < deque->segments.unsafeGet(segment)->getSize())
+        {
+            index = target;
+            position = inSegment;
+            return;
+        }
+    }
+    *this = Iterator(deque, target);
 }
+
 template <typename T>
 typename SegmentedDeque<T>::Iterator &SegmentedDeque<T>::Iterator::operator++()
 {
     ++index;
+    if (segment < deque->segments.getSize() && ++position == deque->segments.unsafeGet(segment)->getSize())
+    {
+        segment++;
+        position = 0;
+    }
     return *this;
 }
 
@@ -582,6 +1799,64 @@ typename SegmentedDeque<T>::Iterator SegmentedDeque<T>::Iterator::operator++(int
     return temp;
 }
 
+template <typename T>
+typename SegmentedDeque<T>::Iterator &SegmentedDeque<T>::Iterator::operator--()
+{
+    moveBy(-1);
+    return *this;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::Iterator SegmentedDeque<T>::Iterator::operator--(int)
+{
+    Iterator temp = *this;
+    moveBy(-1);
+    return temp;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::Iterator &SegmentedDeque<T>::Iterator::operator+=(const difference_type offset)
+{
+    moveBy(offset);
+    return *this;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::Iterator &SegmentedDeque<T>::Iterator::operator-=(const difference_type offset)
+{
+    moveBy(-offset);
+    return *this;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::Iterator SegmentedDeque<T>::Iterator::operator+(const difference_type offset) const
+{
+    Iterator result = *this;
+    result.moveBy(offset);
+    return result;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::Iterator SegmentedDeque<T>::Iterator::operator-(const difference_type offset) const
+{
+    Iterator result = *this;
+    result.moveBy(-offset);
+    return result;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::Iterator::difference_type SegmentedDeque<T>::Iterator::operator-(const Iterator &other) const
+{
+    return index - other.index;
+}
+
+template <typename T>
+T &SegmentedDeque<T>::Iterator::operator[](const difference_type offset) const
+{
+    Iterator target = *this + offset;
+    return *target;
+}
+
 template <typename T>
 bool SegmentedDeque<T>::Iterator::operator==(const Iterator &other) const
 {
@@ -594,6 +1869,30 @@ bool SegmentedDeque<T>::Iterator::operator!=(const Iterator &other) const
     return !(*this == other);
 }
 
+template <typename T>
+bool SegmentedDeque<T>::Iterator::operator<(const Iterator &other) const
+{
+    return index < other.index;
+}
+
+template <typename T>
+bool SegmentedDeque<T>::Iterator::operator>(const Iterator &other) const
+{
+    return index > other.index;
+}
+
+template <typename T>
+bool SegmentedDeque<T>::Iterator::operator<=(const Iterator &other) const
+{
+    return index <= other.index;
+}
+
+template <typename T>
+bool SegmentedDeque<T>::Iterator::operator>=(const Iterator &other) const
+{
+    return index >= other.index;
+}
+
 template <typename T>
 typename SegmentedDeque<T>::Iterator SegmentedDeque<T>::begin()
 {
@@ -617,7 +1916,17 @@ bool SegmentedDeque<T>::Iterator::notEnd() const
 //* { ConstIterator
 template <typename T>
 SegmentedDeque<T>::ConstIterator::ConstIterator(const SegmentedDeque<T> *deque, const int index)
-    : deque(deque), index(index) {}
+    : deque(deque), index(index), segment(0), position(0)
+{
+    if (index >= 0 && index < deque->totalSize)
+    {
+        deque->locate(index, segment, position);
+    }
+    else if (index >= deque->totalSize)
+    {
+        segment = deque->segments.getSize();
+    }
+}
 
 template <typename T>
 const T &SegmentedDeque<T>::ConstIterator::operator*() const
@@ -626,13 +1935,37 @@ const T &SegmentedDeque<T>::ConstIterator::operator*() const
     {
         throw std::runtime_error("Iterator out of range");
     }
-    return deque->get(index);
+    return deque->segments.unsafeGet(segment)->unsafeGet(position);
+}
+
+// Jumps inside the current segment only adjust the position; anything else
+// looks the target up in the segment index.
+template <typename T>
+void SegmentedDeque<T>::ConstIterator::moveBy(const difference_type offset)
+{
+    int target = index + static_cast<int>(offset);
+    if (segment < deque->segments.getSize())
+    {
+        int inSegment = position + static_cast<int>(offset);
+        if (inSegment >= 0 && inSegment < deque->segments.unsafeGet(segment)->getSize())
+        {
+            index = target;
+            position = inSegment;
+            return;
+        }
+    }
+    *this = ConstIterator(deque, target);
 }
 
 template <typename T>
 typename SegmentedDeque<T>::ConstIterator &SegmentedDeque<T>::ConstIterator::operator++()
 {
     ++index;
+    if (segment < deque->segments.getSize() && ++position == deque->segments.unsafeGet(segment)->getSize())
+    {
+        segment++;
+        position = 0;
+    }
     return *this;
 }
 
@@ -644,6 +1977,64 @@ typename SegmentedDeque<T>::ConstIterator SegmentedDeque<T>::ConstIterator::oper
     return temp;
 }
 
+template <typename T>
+typename SegmentedDeque<T>::ConstIterator &SegmentedDeque<T>::ConstIterator::operator--()
+{
+    moveBy(-1);
+    return *this;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::ConstIterator SegmentedDeque<T>::ConstIterator::operator--(int)
+{
+    ConstIterator temp = *this;
+    moveBy(-1);
+    return temp;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::ConstIterator &SegmentedDeque<T>::ConstIterator::operator+=(const difference_type offset)
+{
+    moveBy(offset);
+    return *this;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::ConstIterator &SegmentedDeque<T>::ConstIterator::operator-=(const difference_type offset)
+{
+    moveBy(-offset);
+    return *this;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::ConstIterator SegmentedDeque<T>::ConstIterator::operator+(const difference_type offset) const
+{
+    ConstIterator result = *this;
+    result.moveBy(offset);
+    return result;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::ConstIterator SegmentedDeque<T>::ConstIterator::operator-(const difference_type offset) const
+{
+    ConstIterator result = *this;
+    result.moveBy(-offset);
+    return result;
+}
+
+template <typename T>
+typename SegmentedDeque<T>::ConstIterator::difference_type SegmentedDeque<T>::ConstIterator::operator-(const ConstIterator &other) const
+{
+    return index - other.index;
+}
+
+template <typename T>
+const T &SegmentedDeque<T>::ConstIterator::operator[](const difference_type offset) const
+{
+    ConstIterator target = *this + offset;
+    return *target;
+}
+
 template <typename T>
 bool SegmentedDeque<T>::ConstIterator::operator==(const ConstIterator &other) const
 {
@@ -656,6 +2047,30 @@ bool SegmentedDeque<T>::ConstIterator::operator!=(const ConstIterator &other) co
     return !(*this == other);
 }
 
+template <typename T>
+bool SegmentedDeque<T>::ConstIterator::operator<(const ConstIterator &other) const
+{
+    return index < other.index;
+}
+
+template <typename T>
+bool SegmentedDeque<T>::ConstIterator::operator>(const ConstIterator &other) const
+{
+    return index > other.index;
+}
+
+template <typename T>
+bool SegmentedDeque<T>::ConstIterator::operator<=(const ConstIterator &other) const
+{
+    return index <= other.index;
+}
+
+template <typename T>
+bool SegmentedDeque<T>::ConstIterator::operator>=(const ConstIterator &other) const
+{
+    return index >= other.index;
+}
+
 template <typename T>
 typename SegmentedDeque<T>::ConstIterator SegmentedDeque<T>::cbegin() const
 {
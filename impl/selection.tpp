@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include "../inc/selection.hpp"
+
+//* { IntroSelect
+template <class RandomIt, class Compare>
+IntroSelect<RandomIt, Compare>::IntroSelect(const Compare &compare)
+    : compare(compare) {}
+
+template <class RandomIt, class Compare>
+void introSelect(RandomIt first, RandomIt nth, RandomIt last, Compare compare)
+{
+    IntroSelect<RandomIt, Compare>(compare).select(first, nth, last);
+}
+
+template <class RandomIt, class Compare>
+void IntroSelect<RandomIt, Compare>::select(RandomIt first, RandomIt nth, RandomIt last)
+{
+    if (first == last || nth == last)
+    {
+        return;
+    }
+
+    int depthLimit = 0;
+    for (auto n = last - first; n > 1; n >>= 1)
+    {
+        depthLimit += 2;
+    }
+
+    while (last - first > SELECTION_INSERTION_THRESHOLD)
+    {
+        if (depthLimit == 0)
+        {
+            heapSelect(first, nth + 1, last);
+            std::iter_swap(first, nth);
+            return;
+        }
+        depthLimit--;
+
+        RandomIt cut = partition(first, last);
+        if (cut <= nth)
+        {
+            first = cut;
+        }
+        else
+        {
+            last = cut;
+        }
+    }
+    insertionSort(first, last);
+}
+
+template <class RandomIt, class Compare>
+void IntroSelect<RandomIt, Compare>::moveMedianToFirst(RandomIt result, RandomIt a, RandomIt b, RandomIt c)
+{
+    if (compare(*a, *b))
+    {
+        if (compare(*b, *c))
+        {
+            std::iter_swap(result, b);
+        }
+        else if (compare(*a, *c))
+        {
+            std::iter_swap(result, c);
+        }
+        else
+        {
+            std::iter_swap(result, a);
+        }
+    }
+    else if (compare(*a, *c))
+    {
+        std::iter_swap(result, a);
+    }
+    else if (compare(*b, *c))
+    {
+        std::iter_swap(result, c);
+    }
+    else
+    {
+        std::iter_swap(result, b);
+    }
+}
+
+// Hoare partition of [first + 1, last) around the median of three moved to
+// *first. The other two samples stop both scans, so neither needs a bounds
+// check. Returns the first position of the part that is not less than the
+// pivot; everything before it is not greater.
+template <class RandomIt, class Compare>
+RandomIt IntroSelect<RandomIt, Compare>::partition(RandomIt first, RandomIt last)
+{
+    moveMedianToFirst(first, first + 1, first + (last - first) / 2, last - 1);
+
+    RandomIt left = first + 1;
+    RandomIt right = last;
+    while (true)
+    {
+        while (compare(*left, *first))
+        {
+            ++left;
+        }
+        --right;
+        while (compare(*first, *right))
+        {
+            --right;
+        }
+        if (!(left < right))
+        {
+            return left;
+        }
+        std::iter_swap(left, right);
+        ++left;
+    }
+}
+
+// Leaves the nth - first smallest items of [first, last) in [first, nth) as a
+// heap with the greatest of them at first.
+template <class RandomIt, class Compare>
+void IntroSelect<RandomIt, Compare>::heapSelect(RandomIt first, RandomIt nth, RandomIt last)
+{
+    std::make_heap(first, nth, compare);
+    for (RandomIt it = nth; it < last; ++it)
+    {
+        if (compare(*it, *first))
+        {
+            std::pop_heap(first, nth, compare);
+            std::iter_swap(nth - 1, it);
+            std::push_heap(first, nth, compare);
+        }
+    }
+}
+
+template <class RandomIt, class Compare>
+void IntroSelect<RandomIt, Compare>::insertionSort(RandomIt first, RandomIt last)
+{
+    if (first == last)
+    {
+        return;
+    }
+
+    for (RandomIt it = first + 1; it < last; ++it)
+    {
+        typename std::iterator_traits<RandomIt>::value_type value = std::move(*it);
+        RandomIt hole = it;
+        while (hole > first)
+        {
+            RandomIt previous = hole - 1;
+            if (!compare(value, *previous))
+            {
+                break;
+            }
+            *hole = std::move(*previous);
+            hole = previous;
+        }
+        *hole = std::move(value);
+    }
+}
+//* } IntroSelect
+
+//* { TopKHeap
+template <class T, class Key, class Compare>
+TopKHeap<T, Key, Compare>::TopKHeap(const int capacity, const Compare &compare)
+    : capacity(capacity), compare(compare)
+{
+    entries.reserve(capacity);
+}
+
+template <class T, class Key, class Compare>
+bool TopKHeap<T, Key, Compare>::better(const Entry &a, const Entry &b) const
+{
+    if (compare(b.key, a.key))
+    {
+        return true;
+    }
+    if (compare(a.key, b.key))
+    {
+        return false;
+    }
+    return a.index < b.index;
+}
+
+template <class T, class Key, class Compare>
+void TopKHeap<T, Key, Compare>::push(Entry &&entry)
+{
+    entries.push_back(std::move(entry));
+    std::push_heap(entries.begin(), entries.end(), [this](const Entry &a, const Entry &b)
+                   { return better(a, b); });
+}
+
+template <class T, class Key, class Compare>
+void TopKHeap<T, Key, Compare>::offer(Key key, const int index, const T *item)
+{
+    if (static_cast<int>(entries.size()) < capacity)
+    {
+        push(Entry{std::move(key), index, item});
+        return;
+    }
+
+    Entry candidate{std::move(key), index, item};
+    if (capacity == 0 || !better(candidate, entries.front()))
+    {
+        return;
+    }
+    std::pop_heap(entries.begin(), entries.end(), [this](const Entry &a, const Entry &b)
+                  { return better(a, b); });
+    entries.pop_back();
+    push(std::move(candidate));
+}
+
+template <class T, class Key, class Compare>
+void TopKHeap<T, Key, Compare>::merge(TopKHeap<T, Key, Compare> &&other)
+{
+    for (Entry &entry : other.entries)
+    {
+        offer(std::move(entry.key), entry.index, entry.item);
+    }
+    other.entries.clear();
+}
+
+template <class T, class Key, class Compare>
+int TopKHeap<T, Key, Compare>::getSize() const
+{
+    return static_cast<int>(entries.size());
+}
+
+template <class T, class Key, class Compare>
+template <class Visitor>
+void TopKHeap<T, Key, Compare>::forEachBest(const Visitor &visit)
+{
+    auto heapOrder = [this](const Entry &a, const Entry &b)
+    { return better(a, b); };
+
+    std::sort_heap(entries.begin(), entries.end(), heapOrder);
+    for (const Entry &entry : entries)
+    {
+        visit(*entry.item);
+    }
+    std::make_heap(entries.begin(), entries.end(), heapOrder);
+}
+//* } TopKHeap
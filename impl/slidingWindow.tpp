@@ -0,0 +1,197 @@
+#include <stdexcept>
+#include "../inc/slidingWindow.hpp"
+
+//* { Ops
+template <class Compare>
+template <typename T>
+const T &MinOp<Compare>::operator()(const T &a, const T &b) const
+{
+    return compare(b, a) ? b : a;
+}
+
+template <class Compare>
+template <typename T>
+bool MinOp<Compare>::prefers(const T &a, const T &b) const
+{
+    return compare(a, b);
+}
+
+template <class Compare>
+template <typename T>
+const T &MaxOp<Compare>::operator()(const T &a, const T &b) const
+{
+    return compare(a, b) ? b : a;
+}
+
+template <class Compare>
+template <typename T>
+bool MaxOp<Compare>::prefers(const T &a, const T &b) const
+{
+    return compare(b, a);
+}
+//* } Ops
+
+//* { TwoStacksAggregator
+template <typename T, class Op>
+TwoStacksAggregator<T, Op>::TwoStacksAggregator(const Op &op, const int capacity)
+    : op(op), frontStart(0), back(), backCount(0)
+{
+    front.reserve(capacity);
+}
+
+template <typename T, class Op>
+void TwoStacksAggregator<T, Op>::push(const T &item)
+{
+    back = backCount > 0 ? op(back, item) : item;
+    backCount++;
+}
+
+// An empty front stack takes over the back stack's items, which are all the
+// live ones, storing for each the aggregate of it and everything after it.
+template <typename T, class Op>
+void TwoStacksAggregator<T, Op>::evict(const SegmentedDeque<T> &items, const int first)
+{
+    if (frontStart == static_cast<int>(front.size()))
+    {
+        front.clear();
+        auto loader = makeBlockVisitor<T>([this](const T *block, const int count)
+                                          { front.insert(front.end(), block, block + count); });
+        items.visitBlocks(first, backCount, loader);
+        for (int i = static_cast<int>(front.size()) - 2; i >= 0; i--)
+        {
+            front[i] = op(front[i], front[i + 1]);
+        }
+        frontStart = 0;
+        backCount = 0;
+    }
+    frontStart++;
+}
+
+template <typename T, class Op>
+T TwoStacksAggregator<T, Op>::query() const
+{
+    if (frontStart == static_cast<int>(front.size()))
+    {
+        return back;
+    }
+    if (backCount == 0)
+    {
+        return front[frontStart];
+    }
+    return op(front[frontStart], back);
+}
+//* } TwoStacksAggregator
+
+//* { MonotonicAggregator
+template <typename T, class Op>
+MonotonicAggregator<T, Op>::MonotonicAggregator(const Op &op, const int capacity)
+    : op(op), ring(capacity), head(0), count(0), pushed(0), evicted(0) {}
+
+// Entries no better than the new item can never be the answer again; ties
+// keep the newer item, which stays in the window longer.
+template <typename T, class Op>
+void MonotonicAggregator<T, Op>::push(const T &item)
+{
+    while (count > 0 && !op.prefers(ring.unsafeGet((head + count - 1) % ring.getSize()).item, item))
+    {
+        count--;
+    }
+    ring.unsafeGet((head + count) % ring.getSize()) = Entry{item, pushed++};
+    count++;
+}
+
+template <typename T, class Op>
+void MonotonicAggregator<T, Op>::evict(const SegmentedDeque<T> &, const int)
+{
+    if (count > 0 && ring.unsafeGet(head).sequence == evicted)
+    {
+        head = (head + 1) % ring.getSize();
+        count--;
+    }
+    evicted++;
+}
+
+template <typename T, class Op>
+T MonotonicAggregator<T, Op>::query() const
+{
+    return ring.unsafeGet(head).item;
+}
+//* } MonotonicAggregator
+
+template <typename T, class Op>
+SlidingWindow<T, Op>::SlidingWindow(const int width, const Op &op, const int segmentSize)
+    : items(segmentSize), start(0), width(width), aggregator(op, width)
+{
+    if (width < 1)
+    {
+        throw std::invalid_argument("Window width must be positive");
+    }
+}
+
+template <typename T, class Op>
+void SlidingWindow<T, Op>::push(const T &item)
+{
+    if (getLength() == width)
+    {
+        evict();
+    }
+    items.append(item);
+    aggregator.push(item);
+}
+
+// Evicted items are released a segment at a time; until then they only move
+// the start of the window.
+template <typename T, class Op>
+void SlidingWindow<T, Op>::evict()
+{
+    if (getLength() == 0)
+    {
+        throw std::out_of_range("Window is empty");
+    }
+
+    aggregator.evict(items, start);
+    start++;
+    if (start == items.getSegmentSize())
+    {
+        items.eraseFront(start);
+        start = 0;
+    }
+}
+
+template <typename T, class Op>
+T SlidingWindow<T, Op>::query() const
+{
+    if (getLength() == 0)
+    {
+        throw std::out_of_range("Window is empty");
+    }
+    return aggregator.query();
+}
+
+template <typename T, class Op>
+const T &SlidingWindow<T, Op>::get(const int index) const
+{
+    if (index < 0 || index >= getLength())
+    {
+        throw std::out_of_range("Index is out of range");
+    }
+    return items.get(start + index);
+}
+
+template <typename T, class Op>
+int SlidingWindow<T, Op>::getLength() const
+{
+    return items.getLength() - start;
+}
+
+template <typename T, class Op>
+int SlidingWindow<T, Op>::getWidth() const
+{
+    return width;
+}
+
+template <typename T, class Op>
+bool SlidingWindow<T, Op>::isFull() const
+{
+    return getLength() == width;
+}
@@ -0,0 +1,548 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "../inc/soaSegmentedDeque.hpp"
+
+//* { Reference
+template <typename T>
+SoASegmentedDeque<T>::Reference::Reference(SoASegmentedDeque<T> *deque, const int index)
+    : deque(deque), index(index) {}
+
+template <typename T>
+SoASegmentedDeque<T>::Reference::operator T() const
+{
+    return deque->get(index);
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::Reference &SoASegmentedDeque<T>::Reference::operator=(const T &item)
+{
+    deque->set(index, item);
+    return *this;
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::Reference &SoASegmentedDeque<T>::Reference::operator=(const Reference &other)
+{
+    deque->set(index, static_cast<T>(other));
+    return *this;
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::Field SoASegmentedDeque<T>::Reference::getField(const int field) const
+{
+    return deque->getField(index, field);
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::Reference::setField(const int field, const Field value)
+{
+    deque->setField(index, field, value);
+}
+//* } Reference
+
+template <typename T>
+SoASegmentedDeque<T>::SoASegmentedDeque(int segmentSize)
+    : segments(), segmentSize(segmentSize), totalSize(0)
+{
+    if (segmentSize <= 0)
+    {
+        throw std::invalid_argument("Segment size must be positive");
+    }
+}
+
+template <typename T>
+SoASegmentedDeque<T>::SoASegmentedDeque(const SoASegmentedDeque<T> &other)
+    : segments(), segmentSize(other.segmentSize), totalSize(0)
+{
+    copyFrom(other);
+}
+
+template <typename T>
+SoASegmentedDeque<T>::~SoASegmentedDeque()
+{
+    release();
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::Segment *SoASegmentedDeque<T>::createSegment(const int begin)
+{
+    Segment *segment = new Segment();
+    segment->storage = new Field[Layout::fieldCount * segmentSize];
+    for (int field = 0; field < Layout::fieldCount; field++)
+    {
+        segment->columns[field] = segment->storage + field * segmentSize;
+    }
+    segment->begin = begin;
+    segment->length = 0;
+    return segment;
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::copyFrom(const SoASegmentedDeque<T> &other)
+{
+    segmentSize = other.segmentSize;
+    for (int i = 0; i < other.segments.getSize(); i++)
+    {
+        const Segment *source = other.segments.unsafeGet(i);
+        Segment *segment = createSegment(source->begin);
+        segment->length = source->length;
+        for (int j = 0; j < Layout::fieldCount * segmentSize; j++)
+        {
+            segment->storage[j] = source->storage[j];
+        }
+        segments.append(segment);
+    }
+    totalSize = other.totalSize;
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::release()
+{
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        delete[] segments.unsafeGet(i)->storage;
+        delete segments.unsafeGet(i);
+    }
+    segments.clear();
+    totalSize = 0;
+}
+
+// Only the first segment may be partially filled at its front and only the
+// last one at its back, so every other position follows from the first length.
+template <typename T>
+void SoASegmentedDeque<T>::locate(const int index, int &segment, int &position) const
+{
+    const Segment *first = segments.unsafeGet(0);
+    if (index < first->length)
+    {
+        segment = 0;
+        position = first->begin + index;
+        return;
+    }
+
+    int rest = index - first->length;
+    segment = 1 + rest / segmentSize;
+    position = rest % segmentSize;
+}
+
+template <typename T>
+T SoASegmentedDeque<T>::getFirst() const
+{
+    if (totalSize == 0)
+    {
+        throw std::out_of_range("Deque is empty");
+    }
+    return get(0);
+}
+
+template <typename T>
+T SoASegmentedDeque<T>::getLast() const
+{
+    if (totalSize == 0)
+    {
+        throw std::out_of_range("Deque is empty");
+    }
+    return get(totalSize - 1);
+}
+
+template <typename T>
+T SoASegmentedDeque<T>::get(const int index) const
+{
+    if (index < 0 || index >= totalSize)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    int segment, position;
+    locate(index, segment, position);
+    return Layout::gather(segments.unsafeGet(segment)->columns, position);
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::Field SoASegmentedDeque<T>::getField(const int index, const int field) const
+{
+    if (index < 0 || index >= totalSize)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+    if (field < 0 || field >= Layout::fieldCount)
+    {
+        throw std::out_of_range("Field out of range");
+    }
+
+    int segment, position;
+    locate(index, segment, position);
+    return segments.unsafeGet(segment)->columns[field][position];
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::append(const T &item)
+{
+    if (segments.getSize() == 0 || segments.getLast()->begin + segments.getLast()->length == segmentSize)
+    {
+        segments.append(createSegment(0));
+    }
+
+    Segment *last = segments.getLast();
+    Layout::scatter(item, last->columns, last->begin + last->length);
+    last->length++;
+    totalSize++;
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::prepend(const T &item)
+{
+    if (segments.getSize() == 0 || segments.getFirst()->begin == 0)
+    {
+        segments.prepend(createSegment(segmentSize));
+    }
+
+    Segment *first = segments.getFirst();
+    first->begin--;
+    first->length++;
+    Layout::scatter(item, first->columns, first->begin);
+    totalSize++;
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::set(const int index, const T &item)
+{
+    if (index < 0 || index >= totalSize)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    int segment, position;
+    locate(index, segment, position);
+    Layout::scatter(item, segments.unsafeGet(segment)->columns, position);
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::setField(const int index, const int field, const Field value)
+{
+    if (index < 0 || index >= totalSize)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+    if (field < 0 || field >= Layout::fieldCount)
+    {
+        throw std::out_of_range("Field out of range");
+    }
+
+    int segment, position;
+    locate(index, segment, position);
+    segments.unsafeGet(segment)->columns[field][position] = value;
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::concat(const Sequence<T> *other)
+{
+    if (!other)
+    {
+        return;
+    }
+
+    auto appender = makeBlockVisitor<T>([this](const T *items, const int count)
+                                        {
+        for (int i = 0; i < count; i++)
+        {
+            append(items[i]);
+        } });
+    other->visitBlocks(0, other->getLength(), appender);
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::clear()
+{
+    release();
+}
+
+template <typename T>
+int SoASegmentedDeque<T>::getLength() const
+{
+    return totalSize;
+}
+
+template <typename T>
+int SoASegmentedDeque<T>::getSegmentSize() const
+{
+    return segmentSize;
+}
+
+template <typename T>
+int SoASegmentedDeque<T>::getSegmentCount() const
+{
+    return segments.getSize();
+}
+
+template <typename T>
+int SoASegmentedDeque<T>::getSegmentLength(const int segment) const
+{
+    return segments.get(segment)->length;
+}
+
+template <typename T>
+const typename SoASegmentedDeque<T>::Field *SoASegmentedDeque<T>::getColumn(const int segment, const int field) const
+{
+    if (field < 0 || field >= Layout::fieldCount)
+    {
+        throw std::out_of_range("Field out of range");
+    }
+    const Segment *source = segments.get(segment);
+    return source->columns[field] + source->begin;
+}
+
+template <typename T>
+void SoASegmentedDeque<T>::print() const
+{
+    if (totalSize == 0)
+    {
+        std::cout << "Empty";
+        return;
+    }
+
+    std::cout << "Total segments: " << segments.getSize() << ", Total size: " << totalSize << std::endl;
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const Segment *segment = segments.unsafeGet(i);
+        std::cout << "Segment " << i << " (length: " << segment->length << "): ";
+        for (int j = 0; j < segment->length; j++)
+        {
+            std::cout << "[" << Layout::gather(segment->columns, segment->begin + j) << "]";
+            if (j < segment->length - 1)
+            {
+                std::cout << ", ";
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::Reference SoASegmentedDeque<T>::operator[](const int index)
+{
+    return Reference(this, index);
+}
+
+template <typename T>
+T SoASegmentedDeque<T>::operator[](const int index) const
+{
+    return get(index);
+}
+
+template <typename T>
+SoASegmentedDeque<T> &SoASegmentedDeque<T>::operator=(const SoASegmentedDeque<T> &other)
+{
+    if (this != &other)
+    {
+        release();
+        copyFrom(other);
+    }
+    return *this;
+}
+
+//* { Kernels
+// Compacts the items of segment whose mask byte is 1 into the scratch columns,
+// one column at a time: every item is stored and the output position advances
+// by its mask byte, so the loop has no branch on the data. The survivors are
+// then appended in runs of whole columns.
+template <typename T>
+void SoASegmentedDeque<T>::appendMasked(const Segment *segment, const unsigned char *mask, Field *const *scratch)
+{
+    int kept = 0;
+    for (int field = 0; field < Layout::fieldCount; field++)
+    {
+        const Field *column = segment->columns[field] + segment->begin;
+        Field *out = scratch[field];
+        int k = 0;
+        for (int j = 0; j < segment->length; j++)
+        {
+            out[k] = column[j];
+            k += mask[j];
+        }
+        kept = k;
+    }
+
+    int done = 0;
+    while (done < kept)
+    {
+        if (segments.getSize() == 0 || segments.getLast()->begin + segments.getLast()->length == segmentSize)
+        {
+            segments.append(createSegment(0));
+        }
+
+        Segment *last = segments.getLast();
+        int end = last->begin + last->length;
+        int run = std::min(kept - done, segmentSize - end);
+        for (int field = 0; field < Layout::fieldCount; field++)
+        {
+            std::copy(scratch[field] + done, scratch[field] + done + run, last->columns[field] + end);
+        }
+        last->length += run;
+        totalSize += run;
+        done += run;
+    }
+}
+
+// Filters evaluate the predicate over a whole segment into a mask first, then
+// compact the segment with appendMasked.
+template <typename T>
+template <typename Predicate>
+SoASegmentedDeque<T> *SoASegmentedDeque<T>::where(const Predicate &pred) const
+{
+    auto *result = new SoASegmentedDeque<T>(segmentSize);
+    std::vector<unsigned char> mask(segmentSize);
+    std::vector<Field> buffer(Layout::fieldCount * segmentSize);
+    Field *scratch[Layout::fieldCount];
+    for (int field = 0; field < Layout::fieldCount; field++)
+    {
+        scratch[field] = buffer.data() + field * segmentSize;
+    }
+
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const Segment *segment = segments.unsafeGet(i);
+        for (int j = 0; j < segment->length; j++)
+        {
+            mask[j] = pred(Layout::gather(segment->columns, segment->begin + j)) ? 1 : 0;
+        }
+        result->appendMasked(segment, mask.data(), scratch);
+    }
+    return result;
+}
+
+template <typename T>
+template <typename Predicate>
+SoASegmentedDeque<T> *SoASegmentedDeque<T>::whereField(const int field, const Predicate &pred) const
+{
+    if (field < 0 || field >= Layout::fieldCount)
+    {
+        throw std::out_of_range("Field out of range");
+    }
+
+    auto *result = new SoASegmentedDeque<T>(segmentSize);
+    std::vector<unsigned char> mask(segmentSize);
+    std::vector<Field> buffer(Layout::fieldCount * segmentSize);
+    Field *scratch[Layout::fieldCount];
+    for (int index = 0; index < Layout::fieldCount; index++)
+    {
+        scratch[index] = buffer.data() + index * segmentSize;
+    }
+
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const Segment *segment = segments.unsafeGet(i);
+        const Field *column = segment->columns[field] + segment->begin;
+        for (int j = 0; j < segment->length; j++)
+        {
+            mask[j] = pred(column[j]) ? 1 : 0;
+        }
+        result->appendMasked(segment, mask.data(), scratch);
+    }
+    return result;
+}
+
+template <typename T>
+template <typename R, typename BinaryOp>
+R SoASegmentedDeque<T>::reduce(const BinaryOp &op, R init) const
+{
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const Segment *segment = segments.unsafeGet(i);
+        for (int j = 0; j < segment->length; j++)
+        {
+            init = op(init, Layout::gather(segment->columns, segment->begin + j));
+        }
+    }
+    return init;
+}
+
+template <typename T>
+template <typename R, typename BinaryOp>
+R SoASegmentedDeque<T>::reduceField(const int field, const BinaryOp &op, R init) const
+{
+    if (field < 0 || field >= Layout::fieldCount)
+    {
+        throw std::out_of_range("Field out of range");
+    }
+
+    for (int i = 0; i < segments.getSize(); i++)
+    {
+        const Segment *segment = segments.unsafeGet(i);
+        const Field *column = segment->columns[field] + segment->begin;
+        for (int j = 0; j < segment->length; j++)
+        {
+            init = op(init, column[j]);
+        }
+    }
+    return init;
+}
+//* } Kernels
+
+//* { ConstIterator
+template <typename T>
+SoASegmentedDeque<T>::ConstIterator::ConstIterator(const SoASegmentedDeque<T> *deque, const int segment, const int position)
+    : deque(deque), segment(segment), position(position) {}
+
+template <typename T>
+T SoASegmentedDeque<T>::ConstIterator::operator*() const
+{
+    if (!notEnd())
+    {
+        throw std::runtime_error("Iterator out of range");
+    }
+    const Segment *current = deque->segments.unsafeGet(segment);
+    return Layout::gather(current->columns, current->begin + position);
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::ConstIterator &SoASegmentedDeque<T>::ConstIterator::operator++()
+{
+    if (notEnd() && ++position == deque->segments.unsafeGet(segment)->length)
+    {
+        segment++;
+        position = 0;
+    }
+    return *this;
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::ConstIterator SoASegmentedDeque<T>::ConstIterator::operator++(int)
+{
+    ConstIterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <typename T>
+bool SoASegmentedDeque<T>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    return deque == other.deque && segment == other.segment && position == other.position;
+}
+
+template <typename T>
+bool SoASegmentedDeque<T>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
+
+template <typename T>
+bool SoASegmentedDeque<T>::ConstIterator::notEnd() const
+{
+    return segment < deque->segments.getSize();
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::ConstIterator SoASegmentedDeque<T>::cbegin() const
+{
+    return ConstIterator(this, 0, 0);
+}
+
+template <typename T>
+typename SoASegmentedDeque<T>::ConstIterator SoASegmentedDeque<T>::cend() const
+{
+    return ConstIterator(this, segments.getSize(), 0);
+}
+//* } ConstIterator
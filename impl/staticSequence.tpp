@@ -0,0 +1,77 @@
+#include "../inc/staticSequence.hpp"
+
+template <class Derived, class T>
+const Derived &StaticSequence<Derived, T>::derived() const
+{
+    return static_cast<const Derived &>(*this);
+}
+
+template <class Derived, class T>
+Derived &StaticSequence<Derived, T>::derived()
+{
+    return static_cast<Derived &>(*this);
+}
+
+template <class Derived, class T>
+template <class UnaryFn>
+void StaticSequence<Derived, T>::forEach(const UnaryFn &fn) const
+{
+    derived().forEachBlock([&fn](const T *items, const int count)
+                           {
+        for (int i = 0; i < count; i++)
+        {
+            fn(items[i]);
+        } });
+}
+
+template <class Derived, class T>
+template <class UnaryOp>
+void StaticSequence<Derived, T>::transform(const UnaryOp &op)
+{
+    derived().forEachBlock([&op](T *items, const int count)
+                           {
+        for (int i = 0; i < count; i++)
+        {
+            items[i] = op(items[i]);
+        } });
+}
+
+template <class Derived, class T>
+template <typename R, typename BinaryOp>
+R StaticSequence<Derived, T>::reduce(const BinaryOp &op, R init) const
+{
+    derived().forEachBlock([&op, &init](const T *items, const int count)
+                           {
+        for (int i = 0; i < count; i++)
+        {
+            init = op(init, items[i]);
+        } });
+    return init;
+}
+
+template <class Derived, class T>
+template <class Predicate>
+int StaticSequence<Derived, T>::countIf(const Predicate &pred) const
+{
+    int result = 0;
+    derived().forEachBlock([&pred, &result](const T *items, const int count)
+                           {
+        for (int i = 0; i < count; i++)
+        {
+            result += pred(items[i]) ? 1 : 0;
+        } });
+    return result;
+}
+
+template <class Derived, class T>
+bool StaticSequence<Derived, T>::contains(const T &value) const
+{
+    bool found = false;
+    derived().forEachBlock([&value, &found](const T *items, const int count)
+                           {
+        for (int i = 0; i < count && !found; i++)
+        {
+            found = items[i] == value;
+        } });
+    return found;
+}
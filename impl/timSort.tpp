@@ -0,0 +1,565 @@
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "../inc/timSort.hpp"
+
+template <class T, class Compare>
+TimSort<T, Compare>::TimSort(T *items, const int length, const Compare &compare)
+    : items(items), length(length), compare(compare), minGallop(TIM_SORT_MIN_GALLOP) {}
+
+template <class T, class Compare>
+void timSort(T *items, const int length, Compare compare)
+{
+    TimSort<T, Compare>(items, length, compare).sort();
+}
+
+template <class T, class Compare>
+void TimSort<T, Compare>::sort()
+{
+    if (length < 2)
+    {
+        return;
+    }
+
+    if (length < TIM_SORT_MIN_MERGE)
+    {
+        int runLength = countRunAndMakeAscending(0, length);
+        binaryInsertionSort(0, length, runLength);
+        return;
+    }
+
+    int minRun = minRunLength(length);
+    int lo = 0;
+    int remaining = length;
+    do
+    {
+        int runLength = countRunAndMakeAscending(lo, length);
+        if (runLength < minRun)
+        {
+            int forced = std::min(remaining, minRun);
+            binaryInsertionSort(lo, lo + forced, lo + runLength);
+            runLength = forced;
+        }
+
+        runs.push_back(Run{lo, runLength});
+        mergeCollapse();
+
+        lo += runLength;
+        remaining -= runLength;
+    } while (remaining != 0);
+
+    mergeForceCollapse();
+}
+
+// The smallest k >= TIM_SORT_MIN_MERGE / 2 for which n / k is close to, but not
+// above, a power of two, so the final merges are balanced.
+template <class T, class Compare>
+int TimSort<T, Compare>::minRunLength(int n)
+{
+    int odd = 0;
+    while (n >= TIM_SORT_MIN_MERGE)
+    {
+        odd |= n & 1;
+        n >>= 1;
+    }
+    return n + odd;
+}
+
+// Length of the run starting at lo; a strictly descending run is reversed in
+// place, which keeps the sort stable.
+template <class T, class Compare>
+int TimSort<T, Compare>::countRunAndMakeAscending(const int lo, const int hi)
+{
+    int runHi = lo + 1;
+    if (runHi == hi)
+    {
+        return 1;
+    }
+
+    if (compare(items[runHi++], items[lo]))
+    {
+        while (runHi < hi && compare(items[runHi], items[runHi - 1]))
+        {
+            runHi++;
+        }
+        std::reverse(items + lo, items + runHi);
+    }
+    else
+    {
+        while (runHi < hi && !compare(items[runHi], items[runHi - 1]))
+        {
+            runHi++;
+        }
+    }
+    return runHi - lo;
+}
+
+// Sorts [lo, hi) given that [lo, start) is already sorted.
+template <class T, class Compare>
+void TimSort<T, Compare>::binaryInsertionSort(const int lo, const int hi, int start)
+{
+    if (start == lo)
+    {
+        start++;
+    }
+
+    for (; start < hi; start++)
+    {
+        T pivot = std::move(items[start]);
+        int left = lo;
+        int right = start;
+        while (left < right)
+        {
+            int mid = left + (right - left) / 2;
+            if (compare(pivot, items[mid]))
+            {
+                right = mid;
+            }
+            else
+            {
+                left = mid + 1;
+            }
+        }
+        std::move_backward(items + left, items + start, items + start + 1);
+        items[left] = std::move(pivot);
+    }
+}
+
+// Merges runs until every run is longer than the next one and longer than the
+// next two together, so run lengths grow at least like Fibonacci numbers.
+template <class T, class Compare>
+void TimSort<T, Compare>::mergeCollapse()
+{
+    while (runs.size() > 1)
+    {
+        int n = static_cast<int>(runs.size()) - 2;
+        if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+            (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length))
+        {
+            if (runs[n - 1].length < runs[n + 1].length)
+            {
+                n--;
+            }
+        }
+        else if (runs[n].length > runs[n + 1].length)
+        {
+            break;
+        }
+        mergeAt(n);
+    }
+}
+
+template <class T, class Compare>
+void TimSort<T, Compare>::mergeForceCollapse()
+{
+    while (runs.size() > 1)
+    {
+        int n = static_cast<int>(runs.size()) - 2;
+        if (n > 0 && runs[n - 1].length < runs[n + 1].length)
+        {
+            n--;
+        }
+        mergeAt(n);
+    }
+}
+
+// Merges runs i and i + 1. Items of the first run that are not greater than the
+// second run's first item, and items of the second run that are not less than
+// the first run's last item, are already in place and left out of the merge.
+template <class T, class Compare>
+void TimSort<T, Compare>::mergeAt(const int i)
+{
+    int base1 = runs[i].base;
+    int len1 = runs[i].length;
+    int base2 = runs[i + 1].base;
+    int len2 = runs[i + 1].length;
+
+    runs[i].length = len1 + len2;
+    runs.erase(runs.begin() + i + 1);
+
+    int skipped = gallopRight(items[base2], items + base1, len1, 0);
+    base1 += skipped;
+    len1 -= skipped;
+    if (len1 == 0)
+    {
+        return;
+    }
+
+    len2 = gallopLeft(items[base1 + len1 - 1], items + base2, len2, len2 - 1);
+    if (len2 == 0)
+    {
+        return;
+    }
+
+    if (len1 <= len2)
+    {
+        mergeLo(base1, len1, base2, len2);
+    }
+    else
+    {
+        mergeHi(base1, len1, base2, len2);
+    }
+}
+
+// Position at which key would be inserted into the sorted base[0, len) before
+// any equal items. The search starts at hint and gallops outwards.
+template <class T, class Compare>
+int TimSort<T, Compare>::gallopLeft(const T &key, const T *base, const int len, const int hint) const
+{
+    int lastOffset = 0;
+    int offset = 1;
+    if (compare(base[hint], key))
+    {
+        int maxOffset = len - hint;
+        while (offset < maxOffset && compare(base[hint + offset], key))
+        {
+            lastOffset = offset;
+            offset = offset * 2 + 1;
+            if (offset <= 0)
+            {
+                offset = maxOffset;
+            }
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    }
+    else
+    {
+        int maxOffset = hint + 1;
+        while (offset < maxOffset && !compare(base[hint - offset], key))
+        {
+            lastOffset = offset;
+            offset = offset * 2 + 1;
+            if (offset <= 0)
+            {
+                offset = maxOffset;
+            }
+        }
+        offset = std::min(offset, maxOffset);
+        int previous = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - previous;
+    }
+
+    lastOffset++;
+    while (lastOffset < offset)
+    {
+        int mid = lastOffset + (offset - lastOffset) / 2;
+        if (compare(base[mid], key))
+        {
+            lastOffset = mid + 1;
+        }
+        else
+        {
+            offset = mid;
+        }
+    }
+    return offset;
+}
+
+// Like gallopLeft, but the position is after any items equal to key.
+template <class T, class Compare>
+int TimSort<T, Compare>::gallopRight(const T &key, const T *base, const int len, const int hint) const
+{
+    int lastOffset = 0;
+    int offset = 1;
+    if (compare(key, base[hint]))
+    {
+        int maxOffset = hint + 1;
+        while (offset < maxOffset && compare(key, base[hint - offset]))
+        {
+            lastOffset = offset;
+            offset = offset * 2 + 1;
+            if (offset <= 0)
+            {
+                offset = maxOffset;
+            }
+        }
+        offset = std::min(offset, maxOffset);
+        int previous = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - previous;
+    }
+    else
+    {
+        int maxOffset = len - hint;
+        while (offset < maxOffset && !compare(key, base[hint + offset]))
+        {
+            lastOffset = offset;
+            offset = offset * 2 + 1;
+            if (offset <= 0)
+            {
+                offset = maxOffset;
+            }
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    }
+
+    lastOffset++;
+    while (lastOffset < offset)
+    {
+        int mid = lastOffset + (offset - lastOffset) / 2;
+        if (compare(key, base[mid]))
+        {
+            offset = mid;
+        }
+        else
+        {
+            lastOffset = mid + 1;
+        }
+    }
+    return offset;
+}
+
+// Merges adjacent runs front to back with the shorter first run moved to temp.
+// Requires that the first item of run 2 goes before run 1's first item and the
+// last item of run 1 goes after all of run 2, which mergeAt guarantees.
+template <class T, class Compare>
+void TimSort<T, Compare>::mergeLo(const int base1, int len1, const int base2, int len2)
+{
+    temp.clear();
+    temp.insert(temp.end(), std::make_move_iterator(items + base1), std::make_move_iterator(items + base1 + len1));
+    T *buffer = temp.data();
+
+    int cursor1 = 0;
+    int cursor2 = base2;
+    int dest = base1;
+
+    items[dest++] = std::move(items[cursor2++]);
+    if (--len2 == 0)
+    {
+        std::move(buffer + cursor1, buffer + cursor1 + len1, items + dest);
+        return;
+    }
+    if (len1 == 1)
+    {
+        std::move(items + cursor2, items + cursor2 + len2, items + dest);
+        items[dest + len2] = std::move(buffer[cursor1]);
+        return;
+    }
+
+    int gallop = minGallop;
+    bool done = false;
+    while (!done)
+    {
+        int count1 = 0;
+        int count2 = 0;
+
+        // One item at a time until a run wins gallop times in a row.
+        while (!done && (count1 | count2) < gallop)
+        {
+            if (compare(items[cursor2], buffer[cursor1]))
+            {
+                items[dest++] = std::move(items[cursor2++]);
+                count2++;
+                count1 = 0;
+                done = --len2 == 0;
+            }
+            else
+            {
+                items[dest++] = std::move(buffer[cursor1++]);
+                count1++;
+                count2 = 0;
+                done = --len1 == 1;
+            }
+        }
+
+        // Galloping while it keeps paying off.
+        while (!done)
+        {
+            count1 = gallopRight(items[cursor2], buffer + cursor1, len1, 0);
+            if (count1 != 0)
+            {
+                std::move(buffer + cursor1, buffer + cursor1 + count1, items + dest);
+                dest += count1;
+                cursor1 += count1;
+                len1 -= count1;
+                if (len1 <= 1)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            items[dest++] = std::move(items[cursor2++]);
+            if (--len2 == 0)
+            {
+                done = true;
+                break;
+            }
+
+            count2 = gallopLeft(buffer[cursor1], items + cursor2, len2, 0);
+            if (count2 != 0)
+            {
+                std::move(items + cursor2, items + cursor2 + count2, items + dest);
+                dest += count2;
+                cursor2 += count2;
+                len2 -= count2;
+                if (len2 == 0)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            items[dest++] = std::move(buffer[cursor1++]);
+            if (--len1 == 1)
+            {
+                done = true;
+                break;
+            }
+
+            gallop--;
+            if (count1 < TIM_SORT_MIN_GALLOP && count2 < TIM_SORT_MIN_GALLOP)
+            {
+                break;
+            }
+        }
+        if (!done)
+        {
+            gallop = std::max(gallop, 0) + 2;
+        }
+    }
+    minGallop = std::max(gallop, 1);
+
+    if (len1 == 1)
+    {
+        std::move(items + cursor2, items + cursor2 + len2, items + dest);
+        items[dest + len2] = std::move(buffer[cursor1]);
+    }
+    else if (len1 == 0)
+    {
+        throw std::invalid_argument("Comparator is not a strict weak ordering");
+    }
+    else
+    {
+        std::move(buffer + cursor1, buffer + cursor1 + len1, items + dest);
+    }
+}
+
+// Mirror image of mergeLo: merges back to front with the shorter second run
+// moved to temp.
+template <class T, class Compare>
+void TimSort<T, Compare>::mergeHi(const int base1, int len1, const int base2, int len2)
+{
+    temp.clear();
+    temp.insert(temp.end(), std::make_move_iterator(items + base2), std::make_move_iterator(items + base2 + len2));
+    T *buffer = temp.data();
+
+    int cursor1 = base1 + len1 - 1;
+    int cursor2 = len2 - 1;
+    int dest = base2 + len2 - 1;
+
+    items[dest--] = std::move(items[cursor1--]);
+    if (--len1 == 0)
+    {
+        std::move(buffer, buffer + len2, items + dest - (len2 - 1));
+        return;
+    }
+    if (len2 == 1)
+    {
+        dest -= len1;
+        cursor1 -= len1;
+        std::move_backward(items + cursor1 + 1, items + cursor1 + 1 + len1, items + dest + 1 + len1);
+        items[dest] = std::move(buffer[cursor2]);
+        return;
+    }
+
+    int gallop = minGallop;
+    bool done = false;
+    while (!done)
+    {
+        int count1 = 0;
+        int count2 = 0;
+
+        while (!done && (count1 | count2) < gallop)
+        {
+            if (compare(buffer[cursor2], items[cursor1]))
+            {
+                items[dest--] = std::move(items[cursor1--]);
+                count1++;
+                count2 = 0;
+                done = --len1 == 0;
+            }
+            else
+            {
+                items[dest--] = std::move(buffer[cursor2--]);
+                count2++;
+                count1 = 0;
+                done = --len2 == 1;
+            }
+        }
+
+        while (!done)
+        {
+            count1 = len1 - gallopRight(buffer[cursor2], items + base1, len1, len1 - 1);
+            if (count1 != 0)
+            {
+                dest -= count1;
+                cursor1 -= count1;
+                len1 -= count1;
+                std::move_backward(items + cursor1 + 1, items + cursor1 + 1 + count1, items + dest + 1 + count1);
+                if (len1 == 0)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            items[dest--] = std::move(buffer[cursor2--]);
+            if (--len2 == 1)
+            {
+                done = true;
+                break;
+            }
+
+            count2 = len2 - gallopLeft(items[cursor1], buffer, len2, len2 - 1);
+            if (count2 != 0)
+            {
+                dest -= count2;
+                cursor2 -= count2;
+                len2 -= count2;
+                std::move(buffer + cursor2 + 1, buffer + cursor2 + 1 + count2, items + dest + 1);
+                if (len2 <= 1)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            items[dest--] = std::move(items[cursor1--]);
+            if (--len1 == 0)
+            {
+                done = true;
+                break;
+            }
+
+            gallop--;
+            if (count1 < TIM_SORT_MIN_GALLOP && count2 < TIM_SORT_MIN_GALLOP)
+            {
+                break;
+            }
+        }
+        if (!done)
+        {
+            gallop = std::max(gallop, 0) + 2;
+        }
+    }
+    minGallop = std::max(gallop, 1);
+
+    if (len2 == 1)
+    {
+        dest -= len1;
+        cursor1 -= len1;
+        std::move_backward(items + cursor1 + 1, items + cursor1 + 1 + len1, items + dest + 1 + len1);
+        items[dest] = std::move(buffer[cursor2]);
+    }
+    else if (len2 == 0)
+    {
+        throw std::invalid_argument("Comparator is not a strict weak ordering");
+    }
+    else
+    {
+        std::move(buffer, buffer + len2, items + dest - (len2 - 1));
+    }
+}
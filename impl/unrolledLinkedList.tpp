@@ -0,0 +1,749 @@
+#include <iostream>
+#include "../inc/unrolledLinkedList.hpp"
+
+//* Iterator {
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::Iterator::Iterator(UnrolledLinkedList<T, NodeCapacity> *list, Node *node, const int offset)
+    : list(list), node(node), offset(offset) {}
+
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::Iterator &UnrolledLinkedList<T, NodeCapacity>::Iterator::operator++()
+{
+    if (node && ++offset == node->count)
+    {
+        node = node->next;
+        offset = 0;
+    }
+    return *this;
+}
+
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::Iterator UnrolledLinkedList<T, NodeCapacity>::Iterator::operator++(int)
+{
+    Iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+// Stepping back from end() lands on the last item.
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::Iterator &UnrolledLinkedList<T, NodeCapacity>::Iterator::operator--()
+{
+    if (!node)
+    {
+        node = list->tail;
+        offset = node ? node->count - 1 : 0;
+    }
+    else if (offset > 0)
+    {
+        offset--;
+    }
+    else
+    {
+        node = node->prev;
+        offset = node ? node->count - 1 : 0;
+    }
+    return *this;
+}
+
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::Iterator UnrolledLinkedList<T, NodeCapacity>::Iterator::operator--(int)
+{
+    Iterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template <typename T, int NodeCapacity>
+T &UnrolledLinkedList<T, NodeCapacity>::Iterator::operator*() const
+{
+    if (!node)
+    {
+        throw std::runtime_error("Invalid iterator");
+    }
+    return node->items[offset];
+}
+
+template <typename T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::Iterator::operator==(const Iterator &other) const
+{
+    return node == other.node && offset == other.offset;
+}
+
+template <typename T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::Iterator::operator!=(const Iterator &other) const
+{
+    return !(*this == other);
+}
+
+// Inserts item before the current position and leaves the iterator on it.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::Iterator::insert(const T &item)
+{
+    if (!node)
+    {
+        list->append(item);
+        node = list->tail;
+        offset = node->count - 1;
+        return;
+    }
+    list->insertInto(node, offset, item);
+}
+
+// Removes the current item and moves the iterator to the one after it.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::Iterator::erase()
+{
+    if (!node)
+    {
+        throw std::runtime_error("Invalid iterator");
+    }
+    list->eraseFrom(node, offset);
+}
+
+template <typename T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::Iterator::notEnd() const
+{
+    return node != nullptr;
+}
+
+//* } End of Iterator section
+
+//* ConstIterator {
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::ConstIterator::ConstIterator(const UnrolledLinkedList<T, NodeCapacity> *list, const Node *node, const int offset)
+    : list(list), node(node), offset(offset) {}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::ConstIterator::ConstIterator(const Iterator &it)
+    : list(it.list), node(it.node), offset(it.offset) {}
+
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::ConstIterator &UnrolledLinkedList<T, NodeCapacity>::ConstIterator::operator++()
+{
+    if (node && ++offset == node->count)
+    {
+        node = node->next;
+        offset = 0;
+    }
+    return *this;
+}
+
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::ConstIterator UnrolledLinkedList<T, NodeCapacity>::ConstIterator::operator++(int)
+{
+    ConstIterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::ConstIterator &UnrolledLinkedList<T, NodeCapacity>::ConstIterator::operator--()
+{
+    if (!node)
+    {
+        node = list->tail;
+        offset = node ? node->count - 1 : 0;
+    }
+    else if (offset > 0)
+    {
+        offset--;
+    }
+    else
+    {
+        node = node->prev;
+        offset = node ? node->count - 1 : 0;
+    }
+    return *this;
+}
+
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::ConstIterator UnrolledLinkedList<T, NodeCapacity>::ConstIterator::operator--(int)
+{
+    ConstIterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template <typename T, int NodeCapacity>
+const T &UnrolledLinkedList<T, NodeCapacity>::ConstIterator::operator*() const
+{
+    if (!node)
+    {
+        throw std::runtime_error("Dereferencing invalid iterator");
+    }
+    return node->items[offset];
+}
+
+template <typename T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    return node == other.node && offset == other.offset;
+}
+
+template <typename T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
+
+template <typename T, int NodeCapacity>
+bool UnrolledLinkedList<T, NodeCapacity>::ConstIterator::notEnd() const
+{
+    return node != nullptr;
+}
+
+//* } end of ConstIterator section
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::UnrolledLinkedList() : head(nullptr), tail(nullptr), length(0) {}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::UnrolledLinkedList(const int count) : head(nullptr), tail(nullptr), length(0)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Count cannot be negative");
+    }
+
+    T defaultValue = T();
+    for (int i = 0; i < count; i++)
+    {
+        append(defaultValue);
+    }
+}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::UnrolledLinkedList(const T *items, const int count) : head(nullptr), tail(nullptr), length(0)
+{
+    if (!items)
+    {
+        throw std::invalid_argument("Count must be greater than 0");
+    }
+    appendRange(items, count);
+}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::UnrolledLinkedList(const UnrolledLinkedList<T, NodeCapacity> &list)
+    : head(nullptr), tail(nullptr), length(0)
+{
+    list.forEachBlock([this](const T *items, const int count)
+                      { appendRange(items, count); });
+}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity>::~UnrolledLinkedList()
+{
+    clear();
+}
+
+// Links newNode right after node, or in front of the list when node is null.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::linkAfter(Node *node, Node *newNode)
+{
+    newNode->prev = node;
+    newNode->next = node ? node->next : head;
+
+    if (newNode->next)
+    {
+        newNode->next->prev = newNode;
+    }
+    else
+    {
+        tail = newNode;
+    }
+
+    if (node)
+    {
+        node->next = newNode;
+    }
+    else
+    {
+        head = newNode;
+    }
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::unlink(Node *node)
+{
+    if (node->prev)
+    {
+        node->prev->next = node->next;
+    }
+    else
+    {
+        head = node->next;
+    }
+
+    if (node->next)
+    {
+        node->next->prev = node->prev;
+    }
+    else
+    {
+        tail = node->prev;
+    }
+}
+
+// Finds the node holding index, walking from whichever end is closer.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::locate(int index, Node *&node, int &offset) const
+{
+    if (index < length / 2)
+    {
+        node = head;
+        while (index >= node->count)
+        {
+            index -= node->count;
+            node = node->next;
+        }
+        offset = index;
+        return;
+    }
+
+    int rest = length - 1 - index;
+    node = tail;
+    while (rest >= node->count)
+    {
+        rest -= node->count;
+        node = node->prev;
+    }
+    offset = node->count - 1 - rest;
+}
+
+// Moves the back half of node into a new node linked right after it.
+template <typename T, int NodeCapacity>
+typename UnrolledLinkedList<T, NodeCapacity>::Node *UnrolledLinkedList<T, NodeCapacity>::splitNode(Node *node)
+{
+    Node *back = new Node();
+    int half = node->count / 2;
+    for (int i = half; i < node->count; i++)
+    {
+        back->items[back->count++] = node->items[i];
+    }
+    node->count = half;
+    linkAfter(node, back);
+    return back;
+}
+
+// Inserts item at offset inside node, splitting a full node first. On return
+// node and offset point at the inserted item.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::insertInto(Node *&node, int &offset, const T &item)
+{
+    if (node->count == NodeCapacity)
+    {
+        Node *back = splitNode(node);
+        if (offset > node->count)
+        {
+            offset -= node->count;
+            node = back;
+        }
+    }
+
+    for (int i = node->count; i > offset; i--)
+    {
+        node->items[i] = node->items[i - 1];
+    }
+    node->items[offset] = item;
+    node->count++;
+    length++;
+}
+
+// Removes the item at offset inside node. An emptied node is freed and a node
+// that drops below half full absorbs its successor when both fit in one node.
+// On return node and offset point at the item that followed the removed one.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::eraseFrom(Node *&node, int &offset)
+{
+    for (int i = offset; i < node->count - 1; i++)
+    {
+        node->items[i] = node->items[i + 1];
+    }
+    node->count--;
+    length--;
+
+    if (node->count == 0)
+    {
+        Node *next = node->next;
+        unlink(node);
+        delete node;
+        node = next;
+        offset = 0;
+        return;
+    }
+
+    Node *next = node->next;
+    if (next && node->count < NodeCapacity / 2 && node->count + next->count <= NodeCapacity)
+    {
+        for (int i = 0; i < next->count; i++)
+        {
+            node->items[node->count++] = next->items[i];
+        }
+        unlink(next);
+        delete next;
+    }
+
+    if (offset == node->count)
+    {
+        node = node->next;
+        offset = 0;
+    }
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::clear()
+{
+    Node *current = head;
+    while (current != nullptr)
+    {
+        Node *next = current->next;
+        delete current;
+        current = next;
+    }
+    head = nullptr;
+    tail = nullptr;
+    length = 0;
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::append(const T &item)
+{
+    if (!tail || tail->count == NodeCapacity)
+    {
+        linkAfter(tail, new Node());
+    }
+
+    tail->items[tail->count++] = item;
+    length++;
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::prepend(const T &item)
+{
+    if (!head || head->count == NodeCapacity)
+    {
+        linkAfter(nullptr, new Node());
+    }
+
+    Node *node = head;
+    int offset = 0;
+    insertInto(node, offset, item);
+}
+
+template <typename T, int NodeCapacity>
+template <class InputIt>
+void UnrolledLinkedList<T, NodeCapacity>::assign(InputIt first, InputIt last)
+{
+    clear();
+    appendRange(first, last);
+}
+
+template <typename T, int NodeCapacity>
+template <class InputIt>
+void UnrolledLinkedList<T, NodeCapacity>::appendRange(InputIt first, InputIt last)
+{
+    for (; first != last; ++first)
+    {
+        append(*first);
+    }
+}
+
+// Fills the tail node, then whole new nodes, without re-checking per item.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::appendRange(const T *items, const int count)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Negative count");
+    }
+    if (count > 0 && !items)
+    {
+        throw std::invalid_argument("Null array with non-zero count");
+    }
+
+    int copied = 0;
+    while (copied < count)
+    {
+        if (!tail || tail->count == NodeCapacity)
+        {
+            linkAfter(tail, new Node());
+        }
+
+        int chunk = NodeCapacity - tail->count;
+        if (chunk > count - copied)
+        {
+            chunk = count - copied;
+        }
+        for (int i = 0; i < chunk; i++)
+        {
+            tail->items[tail->count++] = items[copied + i];
+        }
+        copied += chunk;
+        length += chunk;
+    }
+}
+
+// Nodes are allocated as the list grows, so there is nothing to set aside in advance.
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::reserve(const int count)
+{
+    if (count < 0)
+    {
+        throw std::invalid_argument("Invalid capacity");
+    }
+}
+
+template <typename T, int NodeCapacity>
+template <class Visitor>
+void UnrolledLinkedList<T, NodeCapacity>::forEachBlock(const Visitor &visit) const
+{
+    for (const Node *node = head; node; node = node->next)
+    {
+        visit(static_cast<const T *>(node->items), node->count);
+    }
+}
+
+template <typename T, int NodeCapacity>
+template <class Visitor>
+void UnrolledLinkedList<T, NodeCapacity>::forEachBlock(const Visitor &visit)
+{
+    for (Node *node = head; node; node = node->next)
+    {
+        visit(static_cast<T *>(node->items), node->count);
+    }
+}
+
+template <typename T, int NodeCapacity>
+template <class Visitor>
+void UnrolledLinkedList<T, NodeCapacity>::forEachBlock(const int startIndex, const int count, const Visitor &visit) const
+{
+    if (startIndex < 0 || count < 0 || startIndex > length - count)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+    if (count == 0)
+    {
+        return;
+    }
+
+    Node *node;
+    int offset;
+    locate(startIndex, node, offset);
+
+    int remaining = count;
+    while (remaining > 0)
+    {
+        int chunk = node->count - offset;
+        if (chunk > remaining)
+        {
+            chunk = remaining;
+        }
+        visit(static_cast<const T *>(node->items) + offset, chunk);
+        remaining -= chunk;
+        node = node->next;
+        offset = 0;
+    }
+}
+
+template <typename T, int NodeCapacity>
+T &UnrolledLinkedList<T, NodeCapacity>::getFirst()
+{
+    if (!head)
+    {
+        throw std::out_of_range("List is empty");
+    }
+    return head->items[0];
+}
+
+template <typename T, int NodeCapacity>
+const T &UnrolledLinkedList<T, NodeCapacity>::getFirst() const
+{
+    if (!head)
+    {
+        throw std::out_of_range("List is empty");
+    }
+    return head->items[0];
+}
+
+template <typename T, int NodeCapacity>
+T &UnrolledLinkedList<T, NodeCapacity>::getLast()
+{
+    if (!head)
+    {
+        throw std::out_of_range("List is empty");
+    }
+    return tail->items[tail->count - 1];
+}
+
+template <typename T, int NodeCapacity>
+const T &UnrolledLinkedList<T, NodeCapacity>::getLast() const
+{
+    if (!head)
+    {
+        throw std::out_of_range("List is empty");
+    }
+    return tail->items[tail->count - 1];
+}
+
+template <typename T, int NodeCapacity>
+T &UnrolledLinkedList<T, NodeCapacity>::get(const int index)
+{
+    if (index < 0 || index >= length)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    Node *node;
+    int offset;
+    locate(index, node, offset);
+    return node->items[offset];
+}
+
+template <typename T, int NodeCapacity>
+const T &UnrolledLinkedList<T, NodeCapacity>::get(const int index) const
+{
+    if (index < 0 || index >= length)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    Node *node;
+    int offset;
+    locate(index, node, offset);
+    return node->items[offset];
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::set(const int index, const T &value)
+{
+    get(index) = value;
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::insertAt(const T &value, const int index)
+{
+    if (index < 0 || index > length)
+    {
+        throw std::out_of_range("Index out of range");
+    }
+
+    if (index == length)
+    {
+        append(value);
+        return;
+    }
+
+    Node *node;
+    int offset;
+    locate(index, node, offset);
+    insertInto(node, offset, value);
+}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity> *UnrolledLinkedList<T, NodeCapacity>::getSubList(const int startIndex, const int endIndex) const
+{
+    int size = getLength();
+    if (startIndex < 0 || startIndex >= size ||
+        endIndex < 0 || endIndex >= size ||
+        startIndex > endIndex)
+    {
+        throw std::out_of_range("Invalid index range");
+    }
+
+    UnrolledLinkedList<T, NodeCapacity> *subList = new UnrolledLinkedList<T, NodeCapacity>();
+
+    Node *node;
+    int offset;
+    locate(startIndex, node, offset);
+
+    int remaining = endIndex - startIndex + 1;
+    while (remaining > 0)
+    {
+        int chunk = node->count - offset;
+        if (chunk > remaining)
+        {
+            chunk = remaining;
+        }
+        subList->appendRange(node->items + offset, chunk);
+        remaining -= chunk;
+        node = node->next;
+        offset = 0;
+    }
+
+    return subList;
+}
+
+template <typename T, int NodeCapacity>
+int UnrolledLinkedList<T, NodeCapacity>::getLength() const
+{
+    return length;
+}
+
+template <typename T, int NodeCapacity>
+int UnrolledLinkedList<T, NodeCapacity>::getNodeCount() const
+{
+    int count = 0;
+    for (const Node *node = head; node; node = node->next)
+    {
+        count++;
+    }
+    return count;
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::print() const
+{
+    if (length == 0)
+    {
+        std::cout << "Empty list";
+        return;
+    }
+
+    for (ConstIterator it = cbegin(); it != cend(); ++it)
+    {
+        std::cout << *it << " ";
+    }
+}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity> *UnrolledLinkedList<T, NodeCapacity>::concatImmutable(const UnrolledLinkedList<T, NodeCapacity> &list) const
+{
+    if (&list == this)
+    {
+        throw std::invalid_argument("Cannot concatenate with itself");
+    }
+
+    UnrolledLinkedList<T, NodeCapacity> *result = new UnrolledLinkedList<T, NodeCapacity>(*this);
+    result->concat(list);
+    return result;
+}
+
+template <typename T, int NodeCapacity>
+void UnrolledLinkedList<T, NodeCapacity>::concat(const UnrolledLinkedList<T, NodeCapacity> &list)
+{
+    if (&list == this)
+    {
+        throw std::invalid_argument("Cannot concatenate with itself");
+    }
+
+    list.forEachBlock([this](const T *items, const int count)
+                      { appendRange(items, count); });
+}
+
+template <typename T, int NodeCapacity>
+UnrolledLinkedList<T, NodeCapacity> &UnrolledLinkedList<T, NodeCapacity>::operator=(const UnrolledLinkedList<T, NodeCapacity> &other)
+{
+    if (&other == this)
+    {
+        return *this;
+    }
+
+    clear();
+    other.forEachBlock([this](const T *items, const int count)
+                       { appendRange(items, count); });
+
+    return *this;
+}
@@ -0,0 +1,240 @@
+#include <stdexcept>
+#include "../inc/zoneMap.hpp"
+
+template <typename T, class KeyFn>
+ZoneMap<T, KeyFn>::ZoneMap(SegmentedDeque<T> &deque, const KeyFn &keyFn)
+    : deque(&deque), keyFn(keyFn), reshaped(true)
+{
+    deque.addObserver(this);
+}
+
+template <typename T, class KeyFn>
+ZoneMap<T, KeyFn>::~ZoneMap()
+{
+    if (deque)
+    {
+        deque->removeObserver(this);
+    }
+}
+
+template <typename T, class KeyFn>
+void ZoneMap<T, KeyFn>::summarize(Zone &zone, const T *items, const int count) const
+{
+    if (count == 0)
+    {
+        zone.state = ZONE_EMPTY;
+        return;
+    }
+
+    zone.min = keyFn(items[0]);
+    zone.max = zone.min;
+    for (int i = 1; i < count; i++)
+    {
+        Key key = keyFn(items[i]);
+        if (key < zone.min)
+        {
+            zone.min = key;
+        }
+        else if (zone.max < key)
+        {
+            zone.max = key;
+        }
+    }
+    zone.state = ZONE_VALID;
+}
+
+template <typename T, class KeyFn>
+bool ZoneMap<T, KeyFn>::inRange(const Key &key, const Key &lo, const Key &hi) const
+{
+    return !(key < lo) && !(hi < key);
+}
+
+// Walks the segments, refreshing stale summaries on the way, and passes every
+// segment that may hold keys in [lo, hi] to full (all keys inside) or partial.
+template <typename T, class KeyFn>
+template <class FullFn, class PartialFn>
+void ZoneMap<T, KeyFn>::scan(const Key &lo, const Key &hi, const FullFn &full, const PartialFn &partial) const
+{
+    if (!deque)
+    {
+        throw std::logic_error("Zone map outlived its deque");
+    }
+
+    if (reshaped)
+    {
+        zones.clear();
+    }
+
+    int segment = 0;
+    const SegmentedDeque<T> &source = *deque;
+    source.forEachBlock([&](const T *items, const int count)
+                        {
+        if (segment == zones.getSize())
+        {
+            zones.append(Zone{Key(), Key(), ZONE_STALE});
+        }
+        Zone &zone = zones.unsafeGet(segment++);
+        if (zone.state == ZONE_STALE)
+        {
+            summarize(zone, items, count);
+        }
+
+        if (zone.state == ZONE_EMPTY || count == 0 || zone.max < lo || hi < zone.min)
+        {
+            return;
+        }
+        if (!(zone.min < lo) && !(hi < zone.max))
+        {
+            full(items, count);
+        }
+        else
+        {
+            partial(items, count);
+        } });
+
+    zones.resize(segment);
+    reshaped = false;
+}
+
+template <typename T, class KeyFn>
+SegmentedDeque<T> *ZoneMap<T, KeyFn>::whereRange(const Key &lo, const Key &hi) const
+{
+    auto *result = new SegmentedDeque<T>(deque ? deque->getSegmentSize() : 32);
+    try
+    {
+        scan(
+            lo, hi, [result](const T *items, const int count)
+            { result->appendRange(items, count); },
+            [this, result, &lo, &hi](const T *items, const int count)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    if (inRange(keyFn(items[i]), lo, hi))
+                    {
+                        result->append(items[i]);
+                    }
+                }
+            });
+    }
+    catch (...)
+    {
+        delete result;
+        throw;
+    }
+    return result;
+}
+
+template <typename T, class KeyFn>
+int ZoneMap<T, KeyFn>::count(const Key &lo, const Key &hi) const
+{
+    int result = 0;
+    scan(
+        lo, hi, [&result](const T *, const int count)
+        { result += count; },
+        [this, &result, &lo, &hi](const T *items, const int count)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (inRange(keyFn(items[i]), lo, hi))
+                {
+                    result++;
+                }
+            }
+        });
+    return result;
+}
+
+template <typename T, class KeyFn>
+bool ZoneMap<T, KeyFn>::contains(const Key &lo, const Key &hi) const
+{
+    bool found = false;
+    scan(
+        lo, hi, [&found](const T *, const int)
+        { found = true; },
+        [this, &found, &lo, &hi](const T *items, const int count)
+        {
+            for (int i = 0; i < count && !found; i++)
+            {
+                found = inRange(keyFn(items[i]), lo, hi);
+            }
+        });
+    return found;
+}
+
+template <typename T, class KeyFn>
+bool ZoneMap<T, KeyFn>::contains(const Key &key) const
+{
+    return contains(key, key);
+}
+
+template <typename T, class KeyFn>
+void ZoneMap<T, KeyFn>::invalidate()
+{
+    reshaped = true;
+}
+
+//* { DequeObserver
+template <typename T, class KeyFn>
+void ZoneMap<T, KeyFn>::itemStored(const int segment, const T &item)
+{
+    if (reshaped)
+    {
+        return;
+    }
+    while (segment > zones.getSize())
+    {
+        zones.append(Zone{Key(), Key(), ZONE_STALE});
+    }
+    if (segment == zones.getSize())
+    {
+        zones.append(Zone{Key(), Key(), ZONE_EMPTY});
+    }
+
+    Zone &zone = zones.get(segment);
+    Key key = keyFn(item);
+    if (zone.state == ZONE_EMPTY)
+    {
+        zone.min = key;
+        zone.max = key;
+        zone.state = ZONE_VALID;
+    }
+    else if (zone.state == ZONE_VALID)
+    {
+        if (key < zone.min)
+        {
+            zone.min = key;
+        }
+        if (zone.max < key)
+        {
+            zone.max = key;
+        }
+    }
+}
+
+template <typename T, class KeyFn>
+void ZoneMap<T, KeyFn>::segmentTouched(const int segment)
+{
+    if (reshaped)
+    {
+        return;
+    }
+    while (segment >= zones.getSize())
+    {
+        zones.append(Zone{Key(), Key(), ZONE_STALE});
+    }
+    zones.get(segment).state = ZONE_STALE;
+}
+
+template <typename T, class KeyFn>
+void ZoneMap<T, KeyFn>::segmentsReshaped()
+{
+    reshaped = true;
+}
+
+template <typename T, class KeyFn>
+void ZoneMap<T, KeyFn>::dequeDestroyed()
+{
+    deque = nullptr;
+    zones.clear();
+}
+//* } DequeObserver
@@ -1,9 +1,10 @@
 #pragma once
 #include "sequence.hpp"
 #include "dynamicArray.hpp"
+#include "staticSequence.hpp"
 
 template <class T>
-class ArraySequence : public Sequence<T>
+class ArraySequence final : public Sequence<T>, public StaticSequence<ArraySequence<T>, T>
 {
 private:
     DynamicArray<T> array;
@@ -23,7 +24,14 @@ public:
     const T &getLast() const override;
     const T &get(const int index) const override;
 
+    T &at(const int index);
+    const T &at(const int index) const;
+    T &unsafeGet(const int index);
+    const T &unsafeGet(const int index) const;
+
     int getLength() const override;
+    T *getData();
+    const T *getData() const;
 
     void append(const T &item) override;
     void prepend(const T &item) override;
@@ -39,6 +47,20 @@ public:
     Sequence<T> *concatImmutable(const Sequence<T> *other) const override;
 
     void print() const override;
+    void visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const override;
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit);
+
+    template <class InputIt>
+    void assign(InputIt first, InputIt last);
+    template <class InputIt>
+    void appendRange(InputIt first, InputIt last);
+    void appendRange(const T *items, const int count);
+    void reserve(const int count);
+    void resize(const int count);
 
     void clear();
     ArraySequence<T> &operator=(const ArraySequence<T> &other);
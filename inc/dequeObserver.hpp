@@ -0,0 +1,47 @@
+#pragma once
+
+// Key extractor that uses the item itself as the key; the default of the
+// observers that index items by a key.
+struct IdentityKey
+{
+    template <typename T>
+    const T &operator()(const T &item) const { return item; }
+};
+
+// Receives change notifications from a SegmentedDeque it was registered with
+// through addObserver. Segments are identified by their position in the deque,
+// items by their index. The segment hooks describe where data lives and must
+// be handled; the index hooks describe which items came and went, and
+// observers that do not track items by index can leave them alone. Every
+// change to the items is reported by an index hook or by segmentTouched.
+template <typename T>
+class DequeObserver
+{
+public:
+    virtual ~DequeObserver() = default;
+
+    // item was written into segment, which is either an existing segment or a
+    // new one right after the last.
+    virtual void itemStored(const int segment, const T &item) = 0;
+
+    // Items of segment may have changed in any way, for instance through a
+    // reference handed out by get() or an iterator.
+    virtual void segmentTouched(const int segment) = 0;
+
+    // Segments were added, removed, split or refilled.
+    virtual void segmentsReshaped() = 0;
+
+    // The deque is being destroyed; it will not send anything after this.
+    virtual void dequeDestroyed() = 0;
+
+    // count items were inserted at index; the items after them moved up.
+    virtual void itemsInserted(const int /* index */, const int /* count */) {}
+
+    // count items starting at index are about to be removed; they can still be
+    // read.
+    virtual void itemsErasing(const int /* index */, const int /* count */) {}
+
+    // set() is about to overwrite the item at index, and has overwritten it.
+    virtual void itemReplacing(const int /* index */) {}
+    virtual void itemReplaced(const int /* index */) {}
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "sequence.hpp"
+#include "dynamicArray.hpp"
+#include "staticSequence.hpp"
+
+template <typename T>
+class SegmentedDeque;
+
+template <typename T>
+class DequeSlice;
+template <class Source, class Predicate>
+class FilterView;
+template <class Source, class Fn>
+class MapView;
+template <class First, class Second>
+class ZipView;
+
+// Views that compute their items (map, zip) hand them out in batches of this size.
+const int VIEW_BATCH = 64;
+
+// Non-owning, lazily evaluated views over a SegmentedDeque. A view stores only
+// its source and the function it applies, so building a chain such as
+// deque.filterView(p).mapView(f) allocates nothing; items are produced while
+// the chain is iterated or consumed through the StaticSequence algorithms, and
+// copied only by toDeque(). Views hold a pointer to the deque, so they must not
+// outlive it, and changing the deque's structure invalidates them.
+template <class Derived, class T>
+class DequeView : public StaticSequence<Derived, T>
+{
+public:
+    using value_type = T;
+
+    template <class Predicate>
+    FilterView<Derived, Predicate> filterView(const Predicate &pred) const;
+
+    template <class Fn>
+    MapView<Derived, Fn> mapView(const Fn &fn) const;
+
+    template <class Other>
+    ZipView<Derived, Other> zipView(const Other &other) const;
+    template <typename U>
+    ZipView<Derived, DequeSlice<U>> zipView(const SegmentedDeque<U> &other) const;
+
+    int count() const;
+    SegmentedDeque<T> *toDeque(const int segmentSize = 32) const;
+};
+
+// A contiguous range of a deque. Blocks are the deque's own segments, so
+// consuming a slice copies nothing.
+template <typename T>
+class DequeSlice : public DequeView<DequeSlice<T>, T>
+{
+private:
+    const SegmentedDeque<T> *deque;
+    int startIndex;
+    int length;
+
+public:
+    using ConstIterator = typename SegmentedDeque<T>::ConstIterator;
+
+    DequeSlice(const SegmentedDeque<T> *deque, const int startIndex, const int count);
+
+    int getLength() const;
+    const T &get(const int index) const;
+    DequeSlice<T> slice(const int startIndex, const int endIndex) const;
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+// Items of the source for which the predicate holds. Runs of accepted items are
+// passed on in place, without copying.
+template <class Source, class Predicate>
+class FilterView : public DequeView<FilterView<Source, Predicate>, typename Source::value_type>
+{
+private:
+    using T = typename Source::value_type;
+    using SourceIterator = decltype(std::declval<const Source &>().begin());
+
+    Source source;
+    Predicate pred;
+
+public:
+    FilterView(const Source &source, const Predicate &pred);
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = decltype(*std::declval<const SourceIterator &>());
+        using pointer = const T *;
+
+    private:
+        const FilterView<Source, Predicate> *view;
+        SourceIterator current;
+        SourceIterator last;
+
+        void skip();
+
+    public:
+        ConstIterator(const FilterView<Source, Predicate> *view, const SourceIterator &current, const SourceIterator &last);
+        reference operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator &other) const;
+        bool operator!=(const ConstIterator &other) const;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+template <class Source, class Fn>
+using MappedType = typename std::decay<decltype(std::declval<const Fn &>()(std::declval<const typename Source::value_type &>()))>::type;
+
+// fn applied to every item of the source. Results are computed into a small
+// buffer of VIEW_BATCH items and handed on from there.
+template <class Source, class Fn>
+class MapView : public DequeView<MapView<Source, Fn>, MappedType<Source, Fn>>
+{
+private:
+    using R = MappedType<Source, Fn>;
+    using SourceIterator = decltype(std::declval<const Source &>().begin());
+
+    Source source;
+    Fn fn;
+
+public:
+    MapView(const Source &source, const Fn &fn);
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = R;
+        using difference_type = std::ptrdiff_t;
+        using reference = R;
+        using pointer = const R *;
+
+    private:
+        const MapView<Source, Fn> *view;
+        SourceIterator current;
+
+    public:
+        ConstIterator(const MapView<Source, Fn> *view, const SourceIterator &current);
+        R operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator &other) const;
+        bool operator!=(const ConstIterator &other) const;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+// Pairs of items taken from two views in step, as long as the shorter one.
+template <class First, class Second>
+class ZipView : public DequeView<ZipView<First, Second>, std::pair<typename First::value_type, typename Second::value_type>>
+{
+private:
+    using T = std::pair<typename First::value_type, typename Second::value_type>;
+    using FirstIterator = decltype(std::declval<const First &>().begin());
+    using SecondIterator = decltype(std::declval<const Second &>().begin());
+
+    First first;
+    Second second;
+
+public:
+    ZipView(const First &first, const Second &second);
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+
+    // Iterators compare equal when both sides are at the same positions; once
+    // either side is exhausted an iterator stands for end() and equals it.
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = T;
+        using pointer = const T *;
+
+    private:
+        FirstIterator firstCurrent;
+        FirstIterator firstEnd;
+        SecondIterator secondCurrent;
+        SecondIterator secondEnd;
+
+        bool isExhausted() const;
+
+    public:
+        ConstIterator(const FirstIterator &firstCurrent, const FirstIterator &firstEnd,
+                      const SecondIterator &secondCurrent, const SecondIterator &secondEnd);
+        T operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator &other) const;
+        bool operator!=(const ConstIterator &other) const;
+    };
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+};
+
+#include "../impl/dequeView.tpp"
@@ -1,18 +1,58 @@
 #pragma once
 
-template <typename T>
-class DynamicArray
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "growthPolicy.hpp"
+
+// at() and get() always check the index and unsafeGet() never does. operator[]
+// checks unless the build defines SEQUENCE_BOUNDS_CHECK to 0.
+#ifndef SEQUENCE_BOUNDS_CHECK
+#define SEQUENCE_BOUNDS_CHECK 1
+#endif
+
+// DynamicArray<T> keeps its items on the heap and allocates nothing until the
+// first item arrives. DynamicArray<T, N> adds an inline buffer of N items that
+// is used until the array outgrows it; it converts to DynamicArray<T> & and
+// shares all of its operations. Growth picks the capacity of each reallocation
+// (see growthPolicy.hpp); clear() keeps the capacity and shrinkToFit() drops
+// whatever is unused.
+template <typename T, int InlineCapacity = 0, class Growth = DoublingGrowth>
+class DynamicArray;
+
+template <typename T, class Growth>
+class DynamicArray<T, 0, Growth>
 {
 private:
     T *data;
     int size;
     int capacity;
+    T *inlineData;
+    int inlineCapacity;
+
+    void release();
+    int grownCapacity(const int required) const;
+    void reallocate(const int newCapacity);
+    void resetItems(const int from, const int to);
+
+    static void copyItems(T *dest, const T *source, const int count);
+    static void copyItems(T *dest, const T *source, const int count, std::true_type);
+    static void copyItems(T *dest, const T *source, const int count, std::false_type);
+
+    template <class InputIt>
+    void appendRange(InputIt first, InputIt last, std::input_iterator_tag);
+    template <class ForwardIt>
+    void appendRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+
+protected:
+    // Starts empty on a caller-owned buffer that is never freed by the array.
+    DynamicArray(const int inlineCapacity, T *inlineData);
 
 public:
     DynamicArray();
     DynamicArray(const int size);
     DynamicArray(const T *items, const int count);
-    DynamicArray(const DynamicArray<T> &dynamicArray);
+    DynamicArray(const DynamicArray<T, 0, Growth> &dynamicArray);
     ~DynamicArray();
 
     T &getFirst();
@@ -23,23 +63,60 @@ public:
     const T &getLast() const;
     const T &get(const int index) const;
 
+    T &at(const int index);
+    const T &at(const int index) const;
+    T &unsafeGet(const int index);
+    const T &unsafeGet(const int index) const;
+
     int getSize() const;
+    int getCapacity() const;
+    size_t getMemoryUsage() const;
+    T *getData();
+    const T *getData() const;
 
     void append(const T &item);
     void prepend(const T &item);
     void set(const int index, const T &value);
     void insertAt(const T &item, const int index);
+    void removeAt(const int index);
     void resize(const int newSize);
+    void reserve(const int newCapacity);
+    void shrinkToFit();
     void print() const;
     void clear();
 
-    void concat(DynamicArray<T> *dynamicArray);
-    DynamicArray<T> *concatImmutable(DynamicArray<T> *dynamicArray);
-    DynamicArray<T> *getSubArray(const int startIndex, const int endIndex);
+    template <class InputIt>
+    void assign(InputIt first, InputIt last);
+    template <class InputIt>
+    void appendRange(InputIt first, InputIt last);
+    void appendRange(const T *items, const int count);
+
+    void concat(DynamicArray<T, 0, Growth> *dynamicArray);
+    DynamicArray<T, 0, Growth> *concatImmutable(DynamicArray<T, 0, Growth> *dynamicArray);
+    DynamicArray<T, 0, Growth> *getSubArray(const int startIndex, const int endIndex);
 
     T &operator[](int index);
     const T &operator[](int index) const;
-    DynamicArray<T> &operator=(const DynamicArray<T> &other);
+    DynamicArray<T, 0, Growth> &operator=(const DynamicArray<T, 0, Growth> &other);
+};
+
+template <typename T, int InlineCapacity, class Growth>
+class DynamicArray : public DynamicArray<T, 0, Growth>
+{
+    static_assert(InlineCapacity > 0, "Inline capacity must be positive");
+
+private:
+    T buffer[InlineCapacity];
+
+public:
+    DynamicArray();
+    DynamicArray(const int size);
+    DynamicArray(const T *items, const int count);
+    DynamicArray(const DynamicArray<T, InlineCapacity, Growth> &other);
+    DynamicArray(const DynamicArray<T, 0, Growth> &other);
+
+    DynamicArray<T, InlineCapacity, Growth> &operator=(const DynamicArray<T, InlineCapacity, Growth> &other);
+    DynamicArray<T, InlineCapacity, Growth> &operator=(const DynamicArray<T, 0, Growth> &other);
 };
 
 #include "../impl/dynamicArray.tpp"
\ No newline at end of file
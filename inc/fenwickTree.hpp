@@ -0,0 +1,29 @@
+#pragma once
+#include "dynamicArray.hpp"
+
+// Binary indexed tree over a sequence of counts. Point updates, prefix sums and
+// "which entry holds position p" lookups all cost O(log n).
+template <typename T>
+class FenwickTree
+{
+private:
+    DynamicArray<T, 8> tree;
+    int count;
+
+public:
+    FenwickTree();
+
+    void rebuild(const T *values, const int count);
+    template <class ValueAt>
+    void rebuild(const int count, const ValueAt &valueAt);
+    void push(const T &value);
+    void add(const int index, const T &delta);
+    void clear();
+
+    T prefixSum(const int length) const;
+    T get(const int index) const;
+    int find(const T &position, T &offset) const;
+    int getSize() const;
+};
+
+#include "../impl/fenwickTree.tpp"
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+#include "dynamicArray.hpp"
+#include "hashing.hpp"
+#include "parallel.hpp"
+#include "sequence.hpp"
+
+template <typename T>
+class SegmentedDeque;
+
+// One row of a group-by result.
+template <class Key, class R>
+struct Group
+{
+    Key key;
+    R value;
+};
+
+template <class Key, class R>
+std::ostream &operator<<(std::ostream &os, const Group<Key, R> &group);
+
+// Aggregates. Each one starts the state of a group from its first item, folds
+// further items into it and merges two states of the same group built from
+// different parts of the input. Result<T> is the state for items of type T.
+struct CountAggregate
+{
+    template <class T>
+    using Result = int;
+
+    template <class T>
+    int first(const T &item) const;
+    template <class T>
+    void add(int &state, const T &item) const;
+    void merge(int &into, const int &from) const;
+};
+
+template <class ValueFn>
+struct SumAggregate
+{
+    ValueFn value;
+
+    template <class T>
+    using Result = typename std::decay<decltype(std::declval<const ValueFn &>()(std::declval<const T &>()))>::type;
+
+    template <class T>
+    Result<T> first(const T &item) const;
+    template <class T>
+    void add(Result<T> &state, const T &item) const;
+    template <class R>
+    void merge(R &into, const R &from) const;
+};
+
+// Keeps the least value under Compare; std::greater<> turns it into a maximum.
+template <class ValueFn, class Compare>
+struct ExtremeAggregate
+{
+    ValueFn value;
+    Compare compare;
+
+    template <class T>
+    using Result = typename std::decay<decltype(std::declval<const ValueFn &>()(std::declval<const T &>()))>::type;
+
+    template <class T>
+    Result<T> first(const T &item) const;
+    template <class T>
+    void add(Result<T> &state, const T &item) const;
+    template <class R>
+    void merge(R &into, const R &from) const;
+};
+
+// state = step(state, item) starting from init; combine(a, b) joins the states
+// of two parts, with a from the earlier one.
+template <class R, class StepFn, class CombineFn>
+struct CustomAggregate
+{
+    R init;
+    StepFn step;
+    CombineFn combine;
+
+    template <class T>
+    using Result = R;
+
+    template <class T>
+    R first(const T &item) const;
+    template <class T>
+    void add(R &state, const T &item) const;
+    void merge(R &into, const R &from) const;
+};
+
+CountAggregate countAggregate();
+
+template <class ValueFn>
+SumAggregate<ValueFn> sumAggregate(const ValueFn &value);
+
+template <class ValueFn>
+ExtremeAggregate<ValueFn, std::less<>> minAggregate(const ValueFn &value);
+
+template <class ValueFn>
+ExtremeAggregate<ValueFn, std::greater<>> maxAggregate(const ValueFn &value);
+
+template <class R, class StepFn, class CombineFn>
+CustomAggregate<R, StepFn, CombineFn> customAggregate(const R &init, const StepFn &step, const CombineFn &combine);
+
+// Hash table from group keys to aggregate states. Groups live in one dense
+// array in the order their keys were first seen, key next to state, and the
+// open-addressing slot array in front of it holds only entry numbers, so
+// probing stays within a few cache lines and iterating the groups is a linear
+// walk. Hashes are kept to skip key comparisons and to grow without rehashing
+// keys.
+template <class Key, class R>
+class GroupTable
+{
+private:
+    DynamicArray<int> slots;
+    std::vector<Group<Key, R>> entries;
+    std::vector<uint64_t> hashes;
+    std::hash<Key> hasher;
+    uint64_t mask;
+
+    uint64_t firstSlot(const uint64_t hash) const;
+    int freeSlot(const uint64_t hash) const;
+    void add(Group<Key, R> &&group, const uint64_t hash, int slot);
+    void grow();
+
+public:
+    GroupTable();
+
+    // Calls update(state) for an existing group, otherwise adds the group with
+    // state make().
+    template <class Make, class Update>
+    void upsert(const Key &key, const Make &make, const Update &update);
+
+    // State of key's group, or nullptr.
+    const R *find(const Key &key) const;
+
+    // Folds the groups of other into this table, appending new ones in their
+    // order, and leaves other empty.
+    template <class Merge>
+    void merge(GroupTable<Key, R> &other, const Merge &mergeStates);
+
+    int getSize() const;
+    const Group<Key, R> &groupAt(const int entry) const;
+};
+
+// Single-pass grouping of a sequence by keyFn(item), built with groupBy() or
+// deque.groupBy(). aggregate() folds every item into the state of its group
+// and returns one Group per key in a new deque, in the order the keys first
+// appear in the sequence. With several threads each aggregates a contiguous
+// range into its own table and the tables are merged in order, so the result
+// is the same; keyFn and the aggregate are then called concurrently. Keys need
+// operator== and std::hash.
+template <typename T, class KeyFn>
+class GroupBy
+{
+public:
+    using Key = typename std::decay<decltype(std::declval<const KeyFn &>()(std::declval<const T &>()))>::type;
+
+    template <class Aggregate>
+    using Result = SegmentedDeque<Group<Key, typename Aggregate::template Result<T>>>;
+
+private:
+    const Sequence<T> *source;
+    KeyFn keyFn;
+    int segmentSize;
+
+    template <class Aggregate>
+    void aggregateRange(GroupTable<Key, typename Aggregate::template Result<T>> &table, const Aggregate &aggregate,
+                        const int startIndex, const int count) const;
+
+public:
+    GroupBy(const Sequence<T> *source, const KeyFn &keyFn, const int segmentSize = 32);
+
+    template <class Aggregate>
+    Result<Aggregate> *aggregate(const Aggregate &aggregate, const int threadCount = 1) const;
+
+    Result<CountAggregate> *count(const int threadCount = 1) const;
+    template <class ValueFn>
+    Result<SumAggregate<ValueFn>> *sum(const ValueFn &value, const int threadCount = 1) const;
+    template <class ValueFn>
+    Result<ExtremeAggregate<ValueFn, std::less<>>> *min(const ValueFn &value, const int threadCount = 1) const;
+    template <class ValueFn>
+    Result<ExtremeAggregate<ValueFn, std::greater<>>> *max(const ValueFn &value, const int threadCount = 1) const;
+};
+
+template <typename T, class KeyFn>
+GroupBy<T, KeyFn> groupBy(const Sequence<T> &source, const KeyFn &keyFn);
+
+#include "../impl/groupBy.tpp"
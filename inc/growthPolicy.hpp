@@ -0,0 +1,47 @@
+#pragma once
+
+// Growth policies for DynamicArray. grow(capacity, required) returns the
+// capacity to reallocate to when capacity cannot hold required items; the
+// result is always at least required.
+
+// Doubles the capacity: fewest reallocations, up to half the buffer unused.
+struct DoublingGrowth
+{
+    static int grow(const int capacity, const int required)
+    {
+        int newCapacity = capacity > 0 ? capacity : 1;
+        while (newCapacity < required)
+        {
+            newCapacity *= 2;
+        }
+        return newCapacity;
+    }
+};
+
+// Grows by half the capacity: more reallocations, at most a third unused.
+struct HalfGrowth
+{
+    static int grow(const int capacity, const int required)
+    {
+        int newCapacity = capacity > 0 ? capacity : 1;
+        while (newCapacity < required)
+        {
+            newCapacity += newCapacity / 2 + 1;
+        }
+        return newCapacity;
+    }
+};
+
+// Grows in steps of Increment items: at most Increment - 1 unused, but
+// appending n items costs O(n / Increment) reallocations.
+template <int Increment>
+struct FixedGrowth
+{
+    static_assert(Increment > 0, "Growth increment must be positive");
+
+    static int grow(const int capacity, const int required)
+    {
+        int steps = (required - capacity + Increment - 1) / Increment;
+        return capacity + (steps > 0 ? steps : 1) * Increment;
+    }
+};
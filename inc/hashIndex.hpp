@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "dequeObserver.hpp"
+#include "dynamicArray.hpp"
+#include "hashing.hpp"
+#include "segmentedDeque.hpp"
+
+// Control bytes are probed this many at a time, with one SSE2 compare when the
+// target has it.
+const int HASH_INDEX_GROUP_SIZE = 16;
+
+// Maps keyFn(item) to the indices of the items of a SegmentedDeque that have
+// that key. Keys need operator== and std::hash. The table uses open addressing:
+// one control byte per slot holds seven bits of the key's hash, or marks the
+// slot empty or deleted, and a lookup compares a whole group of control bytes
+// at once before reading any item. Slots store positions relative to a base
+// that moves with prepends and erases at the front, so changes at either end
+// of the deque and set() are applied to the table directly. A segment handed
+// out for writing, through get(), operator[], an iterator or forEachBlock on a
+// non-const deque, has its entries taken out of the table the first time; the
+// next lookup puts back the entries of just those items, so reading a
+// non-const deque costs O(segment size) per segment touched, not a rebuild.
+// Inserting or erasing in the middle, outgrowing the table, and reshaping the
+// segments while some are touched mark the whole index stale; the next lookup
+// then rebuilds it in one pass. Destroy the index before the deque, or lookups
+// throw once the deque is gone.
+template <typename T, class KeyFn = IdentityKey>
+class HashIndex final : public DequeObserver<T>
+{
+public:
+    using Key = typename std::decay<decltype(std::declval<const KeyFn &>()(std::declval<const T &>()))>::type;
+
+private:
+    static const int8_t CONTROL_EMPTY = -128;
+    static const int8_t CONTROL_DELETED = -2;
+
+    SegmentedDeque<T> *deque;
+    KeyFn keyFn;
+    std::hash<Key> hasher;
+    mutable DynamicArray<int8_t> control;
+    mutable DynamicArray<int> positions;
+    mutable int groupMask;
+    mutable int live;
+    mutable int used;
+    mutable int base;
+    mutable bool stale;
+    // touched[segment] is set once the segment's entries are out of the table;
+    // pending holds the [first, end) positions of those items.
+    mutable DynamicArray<bool> touched;
+    mutable DynamicArray<int> pending;
+    // set() is replacing an item whose entry is already out of the table.
+    bool replacingPending;
+
+    HashIndex(const HashIndex<T, KeyFn> &other) = delete;
+    HashIndex<T, KeyFn> &operator=(const HashIndex<T, KeyFn> &other) = delete;
+
+    static unsigned matchTag(const int8_t *group, const int8_t tag);
+    static unsigned matchFree(const int8_t *group);
+    static int lowestBit(const unsigned mask);
+
+    const T &itemAt(const int index) const;
+    void hashOf(const Key &key, int &group, int8_t &tag) const;
+    bool hasRoomFor(const int count) const;
+    void insertEntry(const Key &key, const int index) const;
+    bool eraseEntry(const Key &key, const int index) const;
+    void eraseRange(const int index, const int count);
+    void dropPending(const int index, const int count);
+    void reinsertPending() const;
+    void rebuild() const;
+    void refresh() const;
+
+    // Calls visit(index) for every item whose key equals key, in no particular
+    // order, until visit returns false.
+    template <class Visitor>
+    void probe(const Key &key, const Visitor &visit) const;
+
+public:
+    HashIndex(SegmentedDeque<T> &deque, const KeyFn &keyFn = KeyFn());
+    ~HashIndex();
+
+    int findFirst(const Key &key) const;
+    SegmentedDeque<int> *findAll(const Key &key) const;
+    bool contains(const Key &key) const;
+
+    void invalidate();
+
+    void itemStored(const int segment, const T &item) override;
+    void segmentTouched(const int segment) override;
+    void segmentsReshaped() override;
+    void dequeDestroyed() override;
+    void itemsInserted(const int index, const int count) override;
+    void itemsErasing(const int index, const int count) override;
+    void itemReplacing(const int index) override;
+    void itemReplaced(const int index) override;
+};
+
+#include "../impl/hashIndex.tpp"
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Spreads the bits of a std::hash value, which for integers is often the value
+// itself, over the whole word by multiplying with 2^64 divided by the golden
+// ratio. Hash tables take their tags from the high bits and fold the high half
+// into the low one to pick a slot.
+inline uint64_t mixHash(const std::size_t hash);
+
+#include "../impl/hashing.tpp"
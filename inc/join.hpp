@@ -0,0 +1,103 @@
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+#include "groupBy.hpp"
+#include "parallel.hpp"
+
+template <typename T>
+class SegmentedDeque;
+
+// One row of a join result: copies of the matching left and right items.
+template <class L, class R>
+struct Joined
+{
+    L left;
+    R right;
+};
+
+template <class L, class R>
+std::ostream &operator<<(std::ostream &os, const Joined<L, R> &joined);
+
+// Equi-join of two deques on leftKey(left) == rightKey(right), built with
+// deque.hashJoin(). The smaller deque is loaded into a hash table that chains
+// the items of each key in their order, without copying them, and the larger
+// one is then streamed segment by segment, each item looking up its key once.
+// Pairs therefore come in the order of the larger side, and for each of its
+// items in the order of the smaller side. With several threads the probe side
+// is split into contiguous ranges probed at the same time against the shared
+// table; the callback is then called concurrently, while the deque result is
+// assembled in range order and equals the serial one. Keys of both sides are
+// converted to their common type, which needs operator== and std::hash.
+template <typename L, typename R, class LeftKey, class RightKey>
+class HashJoin
+{
+public:
+    using Key = typename std::common_type<
+        typename std::decay<decltype(std::declval<const LeftKey &>()(std::declval<const L &>()))>::type,
+        typename std::decay<decltype(std::declval<const RightKey &>()(std::declval<const R &>()))>::type>::type;
+
+private:
+    struct Chain
+    {
+        int first;
+        int last;
+    };
+
+    const SegmentedDeque<L> *left;
+    const SegmentedDeque<R> *right;
+    LeftKey leftKey;
+    RightKey rightKey;
+
+    // Calls prepare(parts) with the number of probe ranges it chose, then
+    // emit(part, buildItem, probeItem) for every match.
+    template <typename B, typename P, class BuildKey, class ProbeKey, class Prepare, class Emit>
+    static void join(const SegmentedDeque<B> &build, const SegmentedDeque<P> &probe,
+                     const BuildKey &buildKey, const ProbeKey &probeKey,
+                     const Prepare &prepare, const Emit &emit, const int threadCount);
+
+    // Calls prepare(parts), then emit(part, leftItem, rightItem), building on
+    // the smaller side.
+    template <class Prepare, class Emit>
+    void run(const Prepare &prepare, const Emit &emit, const int threadCount) const;
+
+public:
+    HashJoin(const SegmentedDeque<L> *left, const SegmentedDeque<R> *right, const LeftKey &leftKey, const RightKey &rightKey);
+
+    // Calls visit(leftItem, rightItem) for every matching pair.
+    template <class Visitor>
+    void forEach(const Visitor &visit, const int threadCount = 1) const;
+
+    SegmentedDeque<Joined<L, R>> *toDeque(const int segmentSize = 32, const int threadCount = 1) const;
+};
+
+// Equi-join of two deques that are both sorted ascending by their keys, built
+// with deque.mergeJoin(). Both are walked once, in step; each run of equal
+// keys on the right is paired with every left item of that key, so pairs come
+// ordered by key, then by left item, then by right item. Keys need operator<
+// and are computed once per item. An input found out of order throws
+// std::invalid_argument, possibly after some pairs were already visited.
+template <typename L, typename R, class LeftKey, class RightKey>
+class MergeJoin
+{
+public:
+    using Key = typename HashJoin<L, R, LeftKey, RightKey>::Key;
+
+private:
+    const SegmentedDeque<L> *left;
+    const SegmentedDeque<R> *right;
+    LeftKey leftKey;
+    RightKey rightKey;
+
+public:
+    MergeJoin(const SegmentedDeque<L> *left, const SegmentedDeque<R> *right, const LeftKey &leftKey, const RightKey &rightKey);
+
+    template <class Visitor>
+    void forEach(const Visitor &visit) const;
+
+    SegmentedDeque<Joined<L, R>> *toDeque(const int segmentSize = 32) const;
+};
+
+#include "../impl/join.tpp"
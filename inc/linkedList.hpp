@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <iterator>
+#include "nodePool.hpp"
 
 template <typename T>
 class LinkedList
@@ -14,7 +16,24 @@ private:
         Node(const T &value) : value(value), next(nullptr), prev(nullptr) {}
     };
     Node *head;
+    Node *tail;
     int length;
+    NodePool<Node> pool;
+
+    // Last node reached by index and its index. Lookups start from here when it
+    // is closer than either end, so walking the list by index is O(1) per step.
+    // A lookup reads and moves the finger only while it holds fingerBusy; one
+    // that finds it taken walks from the nearer end, so concurrent const
+    // lookups are safe.
+    mutable Node *finger;
+    mutable int fingerIndex;
+    mutable std::atomic<bool> fingerBusy;
+
+    Node *createNode(const T &value);
+    void destroyNode(Node *node);
+    Node *walk(const int index, Node *from, const int fromIndex) const;
+    Node *seek(const int index);
+    Node *seek(const int index) const;
 
 public:
     LinkedList();
@@ -38,8 +57,23 @@ public:
     void set(int index, const T &value);
     void insertAt(const T &value, const int index);
 
+    template <class InputIt>
+    void assign(InputIt first, InputIt last);
+    template <class InputIt>
+    void appendRange(InputIt first, InputIt last);
+    void appendRange(const T *items, const int count);
+    void reserve(const int count);
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit);
+    template <class Visitor>
+    void forEachBlock(const int startIndex, const int count, const Visitor &visit) const;
+
     void print() const;
     void clear();
+    void compact();
 
     void concat(const LinkedList<T> &list);
     LinkedList<T> *concatImmutable(const LinkedList<T> &list) const;
@@ -1,16 +1,20 @@
 #pragma once
 #include "sequence.hpp"
 #include "linkedList.hpp"
+#include "unrolledLinkedList.hpp"
+#include "staticSequence.hpp"
 
-template <class T>
-class ListSequence : public Sequence<T>
+// List is the storage: LinkedList<T> (one item per node) by default, or any
+// list with the same interface such as UnrolledLinkedList<T>.
+template <class T, class List = LinkedList<T>>
+class ListSequence final : public Sequence<T>, public StaticSequence<ListSequence<T, List>, T>
 {
 private:
-    LinkedList<T> list;
+    List list;
 
 public:
-    using Iterator = typename LinkedList<T>::Iterator;
-    using ConstIterator = typename LinkedList<T>::ConstIterator;
+    using Iterator = typename List::Iterator;
+    using ConstIterator = typename List::ConstIterator;
 
     Iterator begin() { return list.begin(); }
     Iterator end() { return list.end(); }
@@ -22,7 +26,7 @@ public:
     ListSequence();
     ListSequence(const T *items, const int count);
     ListSequence(const int count);
-    ListSequence(const LinkedList<T> &list);
+    ListSequence(const List &list);
     virtual ~ListSequence() override;
 
     T &getFirst() override;
@@ -49,9 +53,25 @@ public:
     Sequence<T> *concatImmutable(const Sequence<T> *other) const override;
 
     void print() const override;
+    void visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const override;
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit);
+
+    template <class InputIt>
+    void assign(InputIt first, InputIt last);
+    template <class InputIt>
+    void appendRange(InputIt first, InputIt last);
+    void appendRange(const T *items, const int count);
+    void reserve(const int count);
 
     void clear();
-    ListSequence<T> &operator=(const ListSequence<T> &other);
+    ListSequence<T, List> &operator=(const ListSequence<T, List> &other);
 };
 
+template <class T>
+using UnrolledListSequence = ListSequence<T, UnrolledLinkedList<T>>;
+
 #include "../impl/listSequence.tpp"
\ No newline at end of file
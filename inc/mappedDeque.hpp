@@ -0,0 +1,106 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SEQUENCE_HAS_MMAP 1
+
+#include <string>
+#include <type_traits>
+#include "sequence.hpp"
+#include "dynamicArray.hpp"
+#include "segmentedDeque.hpp"
+#include "serializer.hpp"
+
+// Read-only view over a file written by SegmentedDeque<T>::save(). The file is
+// mapped with mmap and segments point straight into the mapping, so opening
+// costs one pass over the segment headers and no element is copied. Instances
+// are only handed out as const; the non-const accessors throw std::logic_error.
+template <typename T>
+class MappedDeque final : public Sequence<T>
+{
+    static_assert(std::is_trivially_copyable<T>::value, "MappedDeque requires a trivially copyable element type");
+    static_assert(alignof(T) <= DEQUE_FILE_ALIGNMENT, "Element alignment exceeds the file alignment");
+
+private:
+    void *mapping;
+    size_t mappingSize;
+    DynamicArray<const T *> segmentData;
+    DynamicArray<int> segmentStarts;
+    int segmentSize;
+    int totalSize;
+
+    MappedDeque(const std::string &path);
+    MappedDeque(const MappedDeque<T> &other) = delete;
+    MappedDeque<T> &operator=(const MappedDeque<T> &other) = delete;
+
+    int findSegment(const int index) const;
+    void advise(const int advice) const;
+
+public:
+    static const MappedDeque<T> *open(const std::string &path);
+    ~MappedDeque();
+
+    T &getFirst() override;
+    T &getLast() override;
+    T &get(const int index) override;
+
+    const T &getFirst() const override;
+    const T &getLast() const override;
+    const T &get(const int index) const override;
+
+    void append(const T &item) override;
+    void prepend(const T &item) override;
+    void insertAt(const T &item, const int index) override;
+    void set(const int index, const T &data) override;
+    void concat(const Sequence<T> *other) override;
+
+    int getLength() const override;
+    int getSegmentSize() const;
+    int getSegmentCount() const;
+
+    Sequence<T> *getSubsequence(const int startIndex, const int endIndex) const override;
+    Sequence<T> *appendImmutable(const T &item) const override;
+    Sequence<T> *prependImmutable(const T &item) const override;
+    Sequence<T> *insertAtImmutable(const T &item, const int index) const override;
+    Sequence<T> *setImmutable(const int index, const T &data) const override;
+    Sequence<T> *concatImmutable(const Sequence<T> *other) const override;
+
+    void print() const override;
+    void visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const override;
+
+    SegmentedDeque<T> *toDeque() const;
+    void adviseSequential() const;
+    void adviseRandom() const;
+
+    template <typename Predicate>
+    SegmentedDeque<T> *where(const Predicate &pred) const;
+
+    template <typename R, typename BinaryOp>
+    R reduce(const BinaryOp &op, R init) const;
+
+public:
+    class ConstIterator
+    {
+    private:
+        const MappedDeque<T> *deque;
+        int segment;
+        int offset;
+
+    public:
+        ConstIterator(const MappedDeque<T> *deque, const int segment, const int offset);
+        const T &operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator &other) const;
+        bool operator!=(const ConstIterator &other) const;
+        bool notEnd() const;
+    };
+
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+};
+
+#include "../impl/mappedDeque.tpp"
+
+#endif
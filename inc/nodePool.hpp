@@ -0,0 +1,53 @@
+#pragma once
+
+#include <type_traits>
+#include "dynamicArray.hpp"
+
+const int NODE_POOL_FIRST_SLAB = 16;
+const int NODE_POOL_MAX_SLAB = 4096;
+
+// Slab allocator for fixed-size nodes. Slots are handed out in address order
+// from slabs that double in size up to NODE_POOL_MAX_SLAB, so nodes allocated
+// one after another are contiguous; freed slots go onto a free list and are
+// reused first. allocate() and release() are O(1). The pool only manages
+// memory: callers construct and destroy the Item in the slot themselves.
+template <typename Item>
+class NodePool
+{
+private:
+    union Slot
+    {
+        Slot *next;
+        typename std::aligned_storage<sizeof(Item), alignof(Item)>::type storage;
+    };
+
+    struct Slab
+    {
+        Slot *slots;
+        int size;
+    };
+
+    DynamicArray<Slab> slabs;
+    int activeSlab;
+    Slot *cursor;
+    Slot *slabEnd;
+    Slot *freeList;
+
+    void nextSlab();
+
+public:
+    NodePool();
+    NodePool(const NodePool<Item> &other) = delete;
+    NodePool<Item> &operator=(const NodePool<Item> &other) = delete;
+    ~NodePool();
+
+    void *allocate();
+    void release(void *item);
+    void reset();
+    void swap(NodePool<Item> &other);
+
+    int getSlabCount() const;
+    int getCapacity() const;
+};
+
+#include "../impl/nodePool.tpp"
@@ -0,0 +1,20 @@
+#pragma once
+
+// Below this many items per thread a parallel operation runs on fewer threads.
+const int PARALLEL_MIN_ITEMS_PER_THREAD = 4096;
+
+// Number of contiguous parts a parallel pass over length items is split into:
+// at most threadCount, and fewer when a part would get less than minPerThread
+// items. Throws std::invalid_argument unless threadCount is positive.
+inline int parallelPartCount(const int length, const int threadCount,
+                             const int minPerThread = PARALLEL_MIN_ITEMS_PER_THREAD);
+
+// Splits [0, length) into parts contiguous ranges and calls fn(part, start, end)
+// for each, part 0 on the calling thread and every other part on a thread of
+// its own. Returns once all parts are done; if any threw, the exception of the
+// lowest such part is rethrown then. Should starting a thread fail, the threads
+// already running are joined before that error propagates.
+template <class Fn>
+void parallelRanges(const int length, const int parts, const Fn &fn);
+
+#include "../impl/parallel.tpp"
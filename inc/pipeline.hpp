@@ -0,0 +1,75 @@
+#pragma once
+
+#include "parallel.hpp"
+#include "sequence.hpp"
+
+template <typename T>
+class SegmentedDeque;
+
+// Stages of a pipeline. Each one receives an item and a sink and forwards what
+// it produces to the sink, so a chain of stages compiles into nested calls
+// that run once per item with no intermediate storage.
+struct IdentityStage
+{
+    template <class Item, class Sink>
+    void operator()(const Item &item, const Sink &sink) const;
+};
+
+template <class Inner, class Predicate>
+struct FilterStage
+{
+    Inner inner;
+    Predicate pred;
+
+    template <class Item, class Sink>
+    void operator()(const Item &item, const Sink &sink) const;
+};
+
+template <class Inner, class Fn>
+struct MapStage
+{
+    Inner inner;
+    Fn fn;
+
+    template <class Item, class Sink>
+    void operator()(const Item &item, const Sink &sink) const;
+};
+
+// Fused filter/map/reduce over a SegmentedDeque, built with deque.pipeline().
+// Stages are recorded by filter() and map() and executed only by a terminal
+// operation, in a single pass over each segment's storage. The parallel reduce
+// splits the deque into contiguous ranges, reduces each on its own thread
+// starting from init and combines the partial results in order, so init must
+// be an identity of combine.
+template <typename T, class Stage = IdentityStage>
+class Pipeline
+{
+private:
+    const SegmentedDeque<T> *deque;
+    Stage stage;
+
+    template <typename R, class BinaryOp>
+    R reduceRange(const BinaryOp &op, R init, const int startIndex, const int count) const;
+
+public:
+    Pipeline(const SegmentedDeque<T> *deque, const Stage &stage = Stage());
+
+    template <class Predicate>
+    Pipeline<T, FilterStage<Stage, Predicate>> filter(const Predicate &pred) const;
+
+    template <class Fn>
+    Pipeline<T, MapStage<Stage, Fn>> map(const Fn &fn) const;
+
+    template <typename R, class BinaryOp>
+    R reduce(const BinaryOp &op, R init) const;
+
+    template <typename R, class BinaryOp, class CombineOp>
+    R reduce(const BinaryOp &op, const CombineOp &combine, R init, const int threadCount) const;
+
+    template <class UnaryFn>
+    void forEach(const UnaryFn &fn) const;
+
+    int count() const;
+};
+
+#include "../impl/pipeline.tpp"
@@ -1,22 +1,72 @@
 #pragma once
 
+#include <functional>
 #include "sequence.hpp"
+#include "dequeView.hpp"
+#include "parallel.hpp"
+#include "pipeline.hpp"
+#include "groupBy.hpp"
+#include "join.hpp"
+#include "dequeObserver.hpp"
+#include "zoneMap.hpp"
+#include "timSort.hpp"
+#include "selection.hpp"
 #include "arraySequence.hpp"
 #include "listSequence.hpp"
+#include "fenwickTree.hpp"
+#include "serializer.hpp"
+#include "staticSequence.hpp"
+
+// Defined in hashIndex.hpp, included at the end: its lookups return deques.
+template <typename T, class KeyFn>
+class HashIndex;
+
+// A deque keeps its first segment and a short segment directory inside the
+// object, so one holding up to DEQUE_INLINE_CAPACITY items never allocates.
+const int DEQUE_INLINE_CAPACITY = 8;
+const int DEQUE_INLINE_SEGMENTS = 4;
 
 template <typename T>
-class SegmentedDeque : public Sequence<T>
+class SegmentedDeque final : public Sequence<T>, public StaticSequence<SegmentedDeque<T>, T>
 {
 private:
-    ListSequence<ArraySequence<T> *> *segments;
+    DynamicArray<DynamicArray<T> *, DEQUE_INLINE_SEGMENTS> segments;
+    DynamicArray<T, DEQUE_INLINE_CAPACITY> inlineSegment;
+    bool inlineSegmentInUse;
+    FenwickTree<int> segmentIndex;
     int segmentSize;
     int totalSize;
+    DynamicArray<DequeObserver<T> *> observers;
+
+    DynamicArray<T> *createSegment();
+    void releaseSegment(DynamicArray<T> *segment);
+    DynamicArray<T> *adoptSegment(SegmentedDeque<T> &owner, DynamicArray<T> *segment);
+
+    void locate(const int index, int &segment, int &position) const;
+    void rebuildIndex();
+    void splitSegment(const int segment);
+
+    void notifyStored(const int segment, const T &item);
+    void notifyTouched(const int segment);
+    void notifyReshaped();
+    void notifyInserted(const int index, const int count);
+    void notifyErasing(const int index, const int count);
+    void notifyReplacing(const int index);
+    void notifyReplaced(const int index);
+
+    template <class Predicate>
+    void partitionPoint(const Predicate &before, int &segment, int &position) const;
+    template <class Visitor>
+    void forEachBlockIn(const int startIndex, const int count, const Visitor &visit);
 
 public:
     SegmentedDeque(int segmentSize = 32);
+    SegmentedDeque(const T *items, const int count, int segmentSize = 32);
     SegmentedDeque(const SegmentedDeque<T> &other);
     ~SegmentedDeque();
 
+    SegmentedDeque<T> &operator=(const SegmentedDeque<T> &other);
+
     T &getFirst() override;
     T &getLast() override;
     T &get(const int index) override;
@@ -25,14 +75,34 @@ public:
     const T &getLast() const override;
     const T &get(const int index) const override;
 
+    T &at(const int index);
+    const T &at(const int index) const;
+    T &unsafeGet(const int index);
+    const T &unsafeGet(const int index) const;
+
     void append(const T &item) override;
     void prepend(const T &item) override;
     void insertAt(const T &item, const int index) override;
     void set(const int index, const T &data) override;
+    void erase(const int index);
+    void eraseFront(const int count);
     void concat(const Sequence<T> *other) override;
+    void concat(SegmentedDeque<T> &&other);
+    void splice(SegmentedDeque<T> &other);
+    SegmentedDeque<T> *splitAt(const int index);
+
+    template <class InputIt>
+    void assign(InputIt first, InputIt last);
+    template <class InputIt>
+    void appendRange(InputIt first, InputIt last);
+    void appendRange(const T *items, const int count);
+    void reserve(const int count);
+    void clear();
 
     int getLength() const override;
     int getSegmentSize() const;
+    int getSegmentStart(const int segment) const;
+    int getSegmentLength(const int segment) const;
     void rebalanceSegments();
 
     Sequence<T> *getSubsequence(const int startIndex, const int endIndex) const override;
@@ -43,6 +113,18 @@ public:
     Sequence<T> *concatImmutable(const Sequence<T> *other) const override;
 
     void print() const override;
+    void visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const override;
+
+    T &operator[](const int index);
+    const T &operator[](const int index) const;
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit);
+
+    void save(std::ostream &os) const;
+    static SegmentedDeque<T> *load(std::istream &is);
 
 public:
     //* { Sort
@@ -58,10 +140,44 @@ public:
     template <class RandomIt, class Compare>
     SegmentedDeque<T> *sortImmutable(RandomIt first, RandomIt last, Compare compare);
 
-    template <class Compare>
-    void mergeSort(int left, int right, Compare compare);
+    template <class Compare = std::less<>>
+    bool isSorted(Compare compare = Compare()) const;
+
+    template <class KeyFn, class Compare = std::less<>>
+    void sortByKey(const KeyFn &keyFn, Compare compare = Compare());
+
+    template <class KeyFn, class Compare = std::less<>>
+    SegmentedDeque<T> *sortByKeyImmutable(const KeyFn &keyFn, Compare compare = Compare()) const;
     //* } Sort
 
+    //* { Selection
+    template <class Compare = std::less<>>
+    void nthElement(const int k, Compare compare = Compare());
+
+    template <class Compare = std::less<>>
+    void partialSort(const int k, Compare compare = Compare());
+
+    template <class KeyFn, class Compare = std::less<>>
+    SegmentedDeque<T> *topK(const int k, const KeyFn &keyFn, Compare compare = Compare(), const int threadCount = 1) const;
+    //* } Selection
+
+    //* { Sorted
+    template <class Compare = std::less<>>
+    int lowerBound(const T &value, Compare compare = Compare()) const;
+
+    template <class Compare = std::less<>>
+    int upperBound(const T &value, Compare compare = Compare()) const;
+
+    template <class Compare = std::less<>>
+    std::pair<int, int> equalRange(const T &value, Compare compare = Compare()) const;
+
+    template <class Compare = std::less<>>
+    int insertSorted(const T &item, Compare compare = Compare());
+
+    template <class Compare = std::less<>>
+    SegmentedDeque<T> *mergeSorted(const SegmentedDeque<T> &other, Compare compare = Compare()) const;
+    //* } Sorted
+
     //* { Map
     template <class InputIt, class OutputIt, class UnaryOp>
     OutputIt apply(InputIt first1, InputIt last1, OutputIt destFirst, UnaryOp unaryOp);
@@ -73,42 +189,138 @@ public:
     template <typename Predicate>
     SegmentedDeque<T> *where(const Predicate &pred) const;
 
-    template <typename R, typename BinaryOp>
-    R reduce(const BinaryOp &op, R init) const;
+    //* { Views
+    DequeSlice<T> view() const;
+    DequeSlice<T> slice(const int startIndex, const int endIndex) const;
+
+    template <class Predicate>
+    FilterView<DequeSlice<T>, Predicate> filterView(const Predicate &pred) const;
+
+    template <class Fn>
+    MapView<DequeSlice<T>, Fn> mapView(const Fn &fn) const;
+
+    template <class Other>
+    ZipView<DequeSlice<T>, Other> zipView(const Other &other) const;
+    template <typename U>
+    ZipView<DequeSlice<T>, DequeSlice<U>> zipView(const SegmentedDeque<U> &other) const;
+    //* } Views
+
+    Pipeline<T> pipeline() const;
+    template <class KeyFn>
+    GroupBy<T, KeyFn> groupBy(const KeyFn &keyFn) const;
+
+    //* { Joins
+    template <typename U, class LeftKey, class RightKey, class Visitor>
+    void hashJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey, const RightKey &rightKey,
+                  const Visitor &visit, const int threadCount = 1) const;
+    template <typename U, class LeftKey, class RightKey>
+    SegmentedDeque<Joined<T, U>> *hashJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey,
+                                           const RightKey &rightKey, const int threadCount = 1) const;
+
+    template <typename U, class LeftKey, class RightKey, class Visitor>
+    void mergeJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey, const RightKey &rightKey,
+                   const Visitor &visit) const;
+    template <typename U, class LeftKey, class RightKey>
+    SegmentedDeque<Joined<T, U>> *mergeJoin(const SegmentedDeque<U> &other, const LeftKey &leftKey,
+                                            const RightKey &rightKey) const;
+    //* } Joins
+
+    //* { Observers
+    void addObserver(DequeObserver<T> *observer);
+    void removeObserver(DequeObserver<T> *observer);
+
+    ZoneMap<T> *zoneMap();
+    template <class KeyFn>
+    ZoneMap<T, KeyFn> *zoneMap(const KeyFn &keyFn);
+
+    HashIndex<T, IdentityKey> *hashIndex();
+    template <class KeyFn>
+    HashIndex<T, KeyFn> *hashIndex(const KeyFn &keyFn);
+    //* } Observers
 
     template <class ForwardIt1, class ForwardIt2>
     bool searchSubsequence(ForwardIt1 first, ForwardIt1 last, ForwardIt2 searchFirst, ForwardIt2 searchLast) const;
 
 public:
+    // Iterators remember their segment and position, so stepping through the
+    // deque touches the segment index only once, when the iterator is created.
+    // Random jumps that stay inside the current segment are just as cheap;
+    // only jumps that leave it look the target up in the segment index.
     class Iterator
     {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
     private:
         SegmentedDeque<T> *deque;
         int index;
+        int segment;
+        int position;
+
+        void moveBy(const difference_type offset);
 
     public:
         Iterator(SegmentedDeque<T> *deque, const int index);
-        T &operator*();
+        T &operator*() const;
         Iterator &operator++();
         Iterator operator++(int);
+        Iterator &operator--();
+        Iterator operator--(int);
+        Iterator &operator+=(const difference_type offset);
+        Iterator &operator-=(const difference_type offset);
+        Iterator operator+(const difference_type offset) const;
+        Iterator operator-(const difference_type offset) const;
+        difference_type operator-(const Iterator &other) const;
+        T &operator[](const difference_type offset) const;
         bool operator==(const Iterator &other) const;
         bool operator!=(const Iterator &other) const;
+        bool operator<(const Iterator &other) const;
+        bool operator>(const Iterator &other) const;
+        bool operator<=(const Iterator &other) const;
+        bool operator>=(const Iterator &other) const;
         bool notEnd() const;
     };
 
     class ConstIterator
     {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
     private:
         const SegmentedDeque<T> *deque;
         int index;
+        int segment;
+        int position;
+
+        void moveBy(const difference_type offset);
 
     public:
         ConstIterator(const SegmentedDeque<T> *deque, const int index);
         const T &operator*() const;
         ConstIterator &operator++();
         ConstIterator operator++(int);
+        ConstIterator &operator--();
+        ConstIterator operator--(int);
+        ConstIterator &operator+=(const difference_type offset);
+        ConstIterator &operator-=(const difference_type offset);
+        ConstIterator operator+(const difference_type offset) const;
+        ConstIterator operator-(const difference_type offset) const;
+        difference_type operator-(const ConstIterator &other) const;
+        const T &operator[](const difference_type offset) const;
         bool operator==(const ConstIterator &other) const;
         bool operator!=(const ConstIterator &other) const;
+        bool operator<(const ConstIterator &other) const;
+        bool operator>(const ConstIterator &other) const;
+        bool operator<=(const ConstIterator &other) const;
+        bool operator>=(const ConstIterator &other) const;
         bool notEnd() const;
     };
 
@@ -119,3 +331,4 @@ public:
 };
 
 #include "../impl/segmentedDeque.tpp"
+#include "hashIndex.hpp"
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+// Ranges this short are finished by insertion sort instead of partitioning.
+const int SELECTION_INSERTION_THRESHOLD = 16;
+
+// Introselect over random access iterators: quickselect with a median of three
+// pivot that only descends into the side holding nth, falling back to heap
+// selection once the partitions stop shrinking, so the worst case stays
+// O(n log n) and the expected cost is O(n). Afterwards *nth is the item a full
+// sort would put there, nothing before it is greater and nothing after it is
+// less. Only iterator steps and swaps are used, so it works in place on
+// iterators that are not plain pointers.
+template <class RandomIt, class Compare>
+class IntroSelect
+{
+private:
+    Compare compare;
+
+    void moveMedianToFirst(RandomIt result, RandomIt a, RandomIt b, RandomIt c);
+    RandomIt partition(RandomIt first, RandomIt last);
+    void heapSelect(RandomIt first, RandomIt nth, RandomIt last);
+    void insertionSort(RandomIt first, RandomIt last);
+
+public:
+    IntroSelect(const Compare &compare);
+    void select(RandomIt first, RandomIt nth, RandomIt last);
+};
+
+template <class RandomIt, class Compare>
+void introSelect(RandomIt first, RandomIt nth, RandomIt last, Compare compare);
+
+// The k best items offered so far, by a key computed once per item: the worst
+// kept entry sits on top of a heap, so each further item costs one comparison
+// unless it displaces that entry. "Best" means greatest under compare, and of
+// equal keys the one with the lower index wins, which makes the result
+// independent of the order items were offered in. Heaps filled from disjoint
+// parts of a sequence can be merged into the top k of the whole.
+template <class T, class Key, class Compare>
+class TopKHeap
+{
+private:
+    struct Entry
+    {
+        Key key;
+        int index;
+        const T *item;
+    };
+
+    int capacity;
+    Compare compare;
+    std::vector<Entry> entries;
+
+    bool better(const Entry &a, const Entry &b) const;
+    void push(Entry &&entry);
+
+public:
+    TopKHeap(const int capacity, const Compare &compare);
+
+    void offer(Key key, const int index, const T *item);
+    void merge(TopKHeap<T, Key, Compare> &&other);
+    int getSize() const;
+
+    // Visits the kept items best first and keeps them.
+    template <class Visitor>
+    void forEachBest(const Visitor &visit);
+};
+
+#include "../impl/selection.tpp"
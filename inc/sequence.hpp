@@ -1,8 +1,45 @@
 #pragma once
 
+#include <stdexcept>
+
+// Receives consecutive runs of a sequence's items from Sequence::visitBlocks.
+template <class T>
+class BlockVisitor
+{
+public:
+    virtual ~BlockVisitor() = default;
+    virtual void visit(const T *items, const int count) = 0;
+};
+
+template <class T, class Fn>
+class FunctionBlockVisitor : public BlockVisitor<T>
+{
+private:
+    Fn fn;
+
+public:
+    FunctionBlockVisitor(const Fn &fn) : fn(fn) {}
+    void visit(const T *items, const int count) override { fn(items, count); }
+};
+
+template <class T, class Fn>
+FunctionBlockVisitor<T, Fn> makeBlockVisitor(const Fn &fn)
+{
+    return FunctionBlockVisitor<T, Fn>(fn);
+}
+
 template <class T>
 class Sequence
 {
+protected:
+    void checkBlockRange(const int startIndex, const int count) const
+    {
+        if (startIndex < 0 || count < 0 || startIndex > getLength() - count)
+        {
+            throw std::out_of_range("Invalid index range");
+        }
+    }
+
 public:
     virtual ~Sequence() = default;
 
@@ -30,4 +67,17 @@ public:
     virtual Sequence<T> *concatImmutable(const Sequence<T> *list) const = 0;
 
     virtual void print() const = 0;
+
+    // Hands items [startIndex, startIndex + count) to visitor in order, as few
+    // contiguous runs as the storage allows. concat and getSubsequence read
+    // their sources through it, so each container copies from the others block
+    // by block. The default visits one item at a time through get().
+    virtual void visitBlocks(const int startIndex, const int count, BlockVisitor<T> &visitor) const
+    {
+        checkBlockRange(startIndex, count);
+        for (int i = startIndex; i < startIndex + count; i++)
+        {
+            visitor.visit(&get(i), 1);
+        }
+    }
 };
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+//* { File layout
+// A serialized deque is a DequeFileHeader followed by segmentCount records.
+// Each record is a DequeSegmentHeader and the segment payload. Raw payloads
+// are padded to an 8-byte boundary so the file can be mapped and used in place.
+// All fields are stored in host byte order.
+
+const uint32_t DEQUE_FILE_MAGIC = 0x31514453; // "SDQ1"
+const uint32_t DEQUE_FILE_VERSION = 1;
+const int DEQUE_FILE_ALIGNMENT = 8;
+
+struct DequeFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t typeTag;
+    uint32_t elementSize;
+    uint32_t segmentSize;
+    uint32_t segmentCount;
+    uint64_t totalSize;
+};
+
+struct DequeSegmentHeader
+{
+    uint32_t length;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(DequeFileHeader) == 32, "DequeFileHeader must not be padded");
+static_assert(sizeof(DequeSegmentHeader) == DEQUE_FILE_ALIGNMENT, "DequeSegmentHeader must not be padded");
+
+inline int paddingFor(uint64_t bytes)
+{
+    return static_cast<int>((DEQUE_FILE_ALIGNMENT - bytes % DEQUE_FILE_ALIGNMENT) % DEQUE_FILE_ALIGNMENT);
+}
+//* } File layout
+
+//* { Type tags
+// Tag 0 means the type has no registered tag; only the element size is checked then.
+template <typename T>
+struct TypeTag
+{
+    static const uint32_t value = 0;
+};
+
+template <>
+struct TypeTag<char>
+{
+    static const uint32_t value = 1;
+};
+
+template <>
+struct TypeTag<int>
+{
+    static const uint32_t value = 2;
+};
+
+template <>
+struct TypeTag<long>
+{
+    static const uint32_t value = 3;
+};
+
+template <>
+struct TypeTag<long long>
+{
+    static const uint32_t value = 4;
+};
+
+template <>
+struct TypeTag<float>
+{
+    static const uint32_t value = 5;
+};
+
+template <>
+struct TypeTag<double>
+{
+    static const uint32_t value = 6;
+};
+//* } Type tags
+
+//* { Serializers
+// Serializer<T> writes and reads a block of count items. Trivially copyable
+// types are handled here as raw bytes; any other type must provide its own
+// specialization (see types/person.hpp).
+template <typename T, typename Enable = void>
+struct Serializer;
+
+template <typename T>
+struct Serializer<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+{
+    static const bool isRaw = true;
+
+    static void write(std::ostream &os, const T *items, const int count)
+    {
+        os.write(reinterpret_cast<const char *>(items), static_cast<std::streamsize>(sizeof(T)) * count);
+    }
+
+    static void read(std::istream &is, T *items, const int count)
+    {
+        is.read(reinterpret_cast<char *>(items), static_cast<std::streamsize>(sizeof(T)) * count);
+    }
+};
+
+template <typename T>
+void writeBinary(std::ostream &os, const T &value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+void readBinary(std::istream &is, T &value)
+{
+    is.read(reinterpret_cast<char *>(&value), sizeof(T));
+    if (!is)
+    {
+        throw std::runtime_error("Unexpected end of stream");
+    }
+}
+//* } Serializers
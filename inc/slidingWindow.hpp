@@ -0,0 +1,134 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include "dynamicArray.hpp"
+#include "segmentedDeque.hpp"
+
+// The lesser and the greater of two items under Compare. As the op of a
+// SlidingWindow they select a monotonic queue instead of two stacks.
+template <class Compare = std::less<>>
+struct MinOp
+{
+    Compare compare;
+
+    template <typename T>
+    const T &operator()(const T &a, const T &b) const;
+    // a is strictly better than b.
+    template <typename T>
+    bool prefers(const T &a, const T &b) const;
+};
+
+template <class Compare = std::less<>>
+struct MaxOp
+{
+    Compare compare;
+
+    template <typename T>
+    const T &operator()(const T &a, const T &b) const;
+    template <typename T>
+    bool prefers(const T &a, const T &b) const;
+};
+
+template <class Op>
+struct IsSelectingOp : std::false_type
+{
+};
+
+template <class Compare>
+struct IsSelectingOp<MinOp<Compare>> : std::true_type
+{
+};
+
+template <class Compare>
+struct IsSelectingOp<MaxOp<Compare>> : std::true_type
+{
+};
+
+// Aggregate of a FIFO under any associative op. Items enter the back stack,
+// which keeps only its running aggregate; when the front stack runs dry the
+// back stack's items are turned into suffix aggregates in one pass. Each item
+// is combined a constant number of times, so push and evict are amortized
+// O(1) and the op does not need an identity or an inverse.
+template <typename T, class Op>
+class TwoStacksAggregator
+{
+private:
+    Op op;
+    std::vector<T> front;
+    int frontStart;
+    T back;
+    int backCount;
+
+public:
+    TwoStacksAggregator(const Op &op, const int capacity);
+
+    void push(const T &item);
+    // Drops the oldest of the live items, which are items[first...].
+    void evict(const SegmentedDeque<T> &items, const int first);
+    T query() const;
+};
+
+// Running minimum or maximum of a FIFO: a queue of the items that can still
+// become the answer, best first, so a new item removes the worse ones before
+// it and the oldest entry is dropped when its item leaves. Holds at most
+// capacity entries in a ring.
+template <typename T, class Op>
+class MonotonicAggregator
+{
+private:
+    struct Entry
+    {
+        T item;
+        long long sequence;
+    };
+
+    Op op;
+    DynamicArray<Entry> ring;
+    int head;
+    int count;
+    long long pushed;
+    long long evicted;
+
+public:
+    MonotonicAggregator(const Op &op, const int capacity);
+
+    void push(const T &item);
+    void evict(const SegmentedDeque<T> &items, const int first);
+    T query() const;
+};
+
+// The last width items of a stream and op folded over them, oldest first.
+// push() appends an item and evicts the oldest once the window is full; query()
+// costs O(1). Associative ops are aggregated with two stacks, MinOp and MaxOp
+// with a monotonic queue. Items live in a SegmentedDeque: evicted items stay
+// in place until a whole segment has left the window, which is then released
+// with eraseFront in one step.
+template <typename T, class Op>
+class SlidingWindow
+{
+private:
+    using Aggregator = typename std::conditional<IsSelectingOp<Op>::value,
+                                                 MonotonicAggregator<T, Op>,
+                                                 TwoStacksAggregator<T, Op>>::type;
+
+    SegmentedDeque<T> items;
+    int start;
+    int width;
+    Aggregator aggregator;
+
+public:
+    SlidingWindow(const int width, const Op &op = Op(), const int segmentSize = 32);
+
+    void push(const T &item);
+    void evict();
+    T query() const;
+
+    const T &get(const int index) const;
+    int getLength() const;
+    int getWidth() const;
+    bool isFull() const;
+};
+
+#include "../impl/slidingWindow.tpp"
@@ -0,0 +1,7 @@
+#pragma once
+
+// SoALayout<T> describes how an aggregate is split into fieldCount columns of
+// a single Field type. Specializations provide scatter(), which stores an item
+// at position i of every column, and gather(), which rebuilds it.
+template <typename T>
+struct SoALayout;
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "sequence.hpp"
+#include "dynamicArray.hpp"
+#include "soaLayout.hpp"
+
+// Segmented deque that stores each field of T in its own contiguous column
+// inside every segment (structure of arrays). Elements are rebuilt on access,
+// so get() returns by value and operator[] returns a proxy Reference.
+template <typename T>
+class SoASegmentedDeque
+{
+public:
+    using Layout = SoALayout<T>;
+    using Field = typename Layout::Field;
+
+private:
+    struct Segment
+    {
+        Field *storage;
+        Field *columns[Layout::fieldCount];
+        int begin;
+        int length;
+    };
+
+    DynamicArray<Segment *> segments;
+    int segmentSize;
+    int totalSize;
+
+    Segment *createSegment(const int begin);
+    void locate(const int index, int &segment, int &position) const;
+    void copyFrom(const SoASegmentedDeque<T> &other);
+    void release();
+    void appendMasked(const Segment *segment, const unsigned char *mask, Field *const *scratch);
+
+public:
+    class Reference
+    {
+    private:
+        SoASegmentedDeque<T> *deque;
+        int index;
+
+    public:
+        Reference(SoASegmentedDeque<T> *deque, const int index);
+        operator T() const;
+        Reference &operator=(const T &item);
+        Reference &operator=(const Reference &other);
+        Field getField(const int field) const;
+        void setField(const int field, const Field value);
+    };
+
+    SoASegmentedDeque(int segmentSize = 32);
+    SoASegmentedDeque(const SoASegmentedDeque<T> &other);
+    ~SoASegmentedDeque();
+
+    T getFirst() const;
+    T getLast() const;
+    T get(const int index) const;
+    Field getField(const int index, const int field) const;
+
+    void append(const T &item);
+    void prepend(const T &item);
+    void set(const int index, const T &item);
+    void setField(const int index, const int field, const Field value);
+    void concat(const Sequence<T> *other);
+    void clear();
+
+    int getLength() const;
+    int getSegmentSize() const;
+    int getSegmentCount() const;
+    int getSegmentLength(const int segment) const;
+    const Field *getColumn(const int segment, const int field) const;
+
+    void print() const;
+
+    Reference operator[](const int index);
+    T operator[](const int index) const;
+    SoASegmentedDeque<T> &operator=(const SoASegmentedDeque<T> &other);
+
+    //* { Kernels
+    template <typename Predicate>
+    SoASegmentedDeque<T> *where(const Predicate &pred) const;
+
+    template <typename Predicate>
+    SoASegmentedDeque<T> *whereField(const int field, const Predicate &pred) const;
+
+    template <typename R, typename BinaryOp>
+    R reduce(const BinaryOp &op, R init) const;
+
+    template <typename R, typename BinaryOp>
+    R reduceField(const int field, const BinaryOp &op, R init) const;
+    //* } Kernels
+
+public:
+    class ConstIterator
+    {
+    private:
+        const SoASegmentedDeque<T> *deque;
+        int segment;
+        int position;
+
+    public:
+        ConstIterator(const SoASegmentedDeque<T> *deque, const int segment, const int position);
+        T operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator &other) const;
+        bool operator!=(const ConstIterator &other) const;
+        bool notEnd() const;
+    };
+
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+    ConstIterator begin() const { return cbegin(); }
+    ConstIterator end() const { return cend(); }
+};
+
+#include "../impl/soaSegmentedDeque.tpp"
@@ -0,0 +1,31 @@
+#pragma once
+
+// CRTP base with algorithms that are resolved at compile time. Derived classes
+// provide forEachBlock(visit), calling visit(items, count) for every contiguous
+// run of elements in order; everything here is built on top of that hook, so a
+// call on a concrete container inlines down to plain loops over its storage.
+// Code that needs runtime polymorphism keeps using the virtual Sequence<T>.
+template <class Derived, class T>
+class StaticSequence
+{
+protected:
+    const Derived &derived() const;
+    Derived &derived();
+
+public:
+    template <class UnaryFn>
+    void forEach(const UnaryFn &fn) const;
+
+    template <class UnaryOp>
+    void transform(const UnaryOp &op);
+
+    template <typename R, typename BinaryOp>
+    R reduce(const BinaryOp &op, R init) const;
+
+    template <class Predicate>
+    int countIf(const Predicate &pred) const;
+
+    bool contains(const T &value) const;
+};
+
+#include "../impl/staticSequence.tpp"
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+// Runs shorter than this are extended with binary insertion sort.
+const int TIM_SORT_MIN_MERGE = 32;
+// Consecutive wins of one run after which a merge switches to galloping.
+const int TIM_SORT_MIN_GALLOP = 7;
+
+// Stable, adaptive merge sort over a contiguous array (TimSort). Existing
+// ascending and strictly descending runs are found and kept, short runs are
+// extended by binary insertion, and runs are merged in an order that keeps the
+// run stack balanced. Merges gallop, copying whole stretches of one run found
+// by exponential search, when one side keeps winning. Sorted input costs n - 1
+// comparisons and no moves. compare must be a strict weak ordering.
+template <class T, class Compare>
+class TimSort
+{
+private:
+    struct Run
+    {
+        int base;
+        int length;
+    };
+
+    T *items;
+    int length;
+    Compare compare;
+    int minGallop;
+    std::vector<T> temp;
+    std::vector<Run> runs;
+
+    static int minRunLength(int n);
+
+    int countRunAndMakeAscending(const int lo, const int hi);
+    void binaryInsertionSort(const int lo, const int hi, int start);
+
+    void mergeCollapse();
+    void mergeForceCollapse();
+    void mergeAt(const int i);
+    void mergeLo(const int base1, int len1, const int base2, int len2);
+    void mergeHi(const int base1, int len1, const int base2, int len2);
+
+    int gallopLeft(const T &key, const T *base, const int len, const int hint) const;
+    int gallopRight(const T &key, const T *base, const int len, const int hint) const;
+
+public:
+    TimSort(T *items, const int length, const Compare &compare);
+    void sort();
+};
+
+template <class T, class Compare>
+void timSort(T *items, const int length, Compare compare);
+
+#include "../impl/timSort.tpp"
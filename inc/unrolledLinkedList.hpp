@@ -0,0 +1,147 @@
+#pragma once
+
+#include <iterator>
+
+// Nodes of an unrolled list are sized to roughly this many bytes of items.
+const int UNROLLED_NODE_BYTES = 128;
+
+template <typename T>
+constexpr int unrolledNodeCapacity()
+{
+    return sizeof(T) * 4 >= UNROLLED_NODE_BYTES ? 4 : static_cast<int>(UNROLLED_NODE_BYTES / sizeof(T));
+}
+
+// Doubly linked list whose nodes each hold up to NodeCapacity items in a small
+// array, so small types pay the two link pointers once per node instead of once
+// per item and iteration runs over contiguous memory inside each node. It has
+// the interface of LinkedList, and its iterators can also insert and erase.
+template <typename T, int NodeCapacity = unrolledNodeCapacity<T>()>
+class UnrolledLinkedList
+{
+    static_assert(NodeCapacity >= 2, "Unrolled list nodes must hold at least two items");
+
+private:
+    struct Node
+    {
+        T items[NodeCapacity];
+        int count;
+        Node *next;
+        Node *prev;
+        Node() : count(0), next(nullptr), prev(nullptr) {}
+    };
+    Node *head;
+    Node *tail;
+    int length;
+
+    void linkAfter(Node *node, Node *newNode);
+    void unlink(Node *node);
+    void locate(int index, Node *&node, int &offset) const;
+    Node *splitNode(Node *node);
+    void insertInto(Node *&node, int &offset, const T &item);
+    void eraseFrom(Node *&node, int &offset);
+
+public:
+    UnrolledLinkedList();
+    UnrolledLinkedList(const int count);
+    UnrolledLinkedList(const T *items, const int count);
+    UnrolledLinkedList(const UnrolledLinkedList<T, NodeCapacity> &list);
+    ~UnrolledLinkedList();
+
+    const T &getFirst() const;
+    const T &getLast() const;
+    const T &get(const int index) const;
+
+    T &getFirst();
+    T &getLast();
+    T &get(const int index);
+
+    int getLength() const;
+    int getNodeCount() const;
+
+    void append(const T &item);
+    void prepend(const T &item);
+    void set(int index, const T &value);
+    void insertAt(const T &value, const int index);
+
+    template <class InputIt>
+    void assign(InputIt first, InputIt last);
+    template <class InputIt>
+    void appendRange(InputIt first, InputIt last);
+    void appendRange(const T *items, const int count);
+    void reserve(const int count);
+
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit) const;
+    template <class Visitor>
+    void forEachBlock(const Visitor &visit);
+    template <class Visitor>
+    void forEachBlock(const int startIndex, const int count, const Visitor &visit) const;
+
+    void print() const;
+    void clear();
+
+    void concat(const UnrolledLinkedList<T, NodeCapacity> &list);
+    UnrolledLinkedList<T, NodeCapacity> *concatImmutable(const UnrolledLinkedList<T, NodeCapacity> &list) const;
+    UnrolledLinkedList<T, NodeCapacity> *getSubList(const int startIndex, const int endIndex) const;
+
+    UnrolledLinkedList<T, NodeCapacity> &operator=(const UnrolledLinkedList<T, NodeCapacity> &other);
+
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        UnrolledLinkedList<T, NodeCapacity> *list;
+        Node *node;
+        int offset;
+
+        Iterator(UnrolledLinkedList<T, NodeCapacity> *list, Node *node, const int offset);
+        Iterator &operator++();
+        Iterator operator++(int);
+        Iterator &operator--();
+        Iterator operator--(int);
+        T &operator*() const;
+        bool operator!=(const Iterator &other) const;
+        bool operator==(const Iterator &other) const;
+        void insert(const T &item);
+        void erase();
+        bool notEnd() const;
+    };
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const UnrolledLinkedList<T, NodeCapacity> *list;
+        const Node *node;
+        int offset;
+
+        ConstIterator(const UnrolledLinkedList<T, NodeCapacity> *list, const Node *node, const int offset);
+        ConstIterator(const Iterator &it);
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        ConstIterator &operator--();
+        ConstIterator operator--(int);
+        const T &operator*() const;
+        bool operator!=(const ConstIterator &other) const;
+        bool operator==(const ConstIterator &other) const;
+        bool notEnd() const;
+    };
+
+    Iterator begin() { return Iterator(this, head, 0); };
+    Iterator end() { return Iterator(this, nullptr, 0); };
+
+    ConstIterator cbegin() const { return ConstIterator(this, head, 0); };
+    ConstIterator cend() const { return ConstIterator(this, nullptr, 0); };
+};
+
+#include "../impl/unrolledLinkedList.tpp"
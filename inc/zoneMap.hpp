@@ -0,0 +1,72 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include "dequeObserver.hpp"
+#include "dynamicArray.hpp"
+
+template <typename T>
+class SegmentedDeque;
+
+// Per-segment minimum and maximum of keyFn(item) over a SegmentedDeque, used to
+// skip segments that cannot hold keys in [lo, hi] and to take segments whose
+// keys all fall inside it without testing each item. Keys only need operator<.
+// The map registers itself as an observer of the deque: writes of single items
+// widen the bounds of their segment right away, while anything that may shrink
+// or move them only marks the affected summaries stale, and those are rebuilt
+// by the next query. Bounds may therefore be wider than the data, never
+// narrower. Destroy the map before the deque, or queries throw once the deque
+// is gone.
+template <typename T, class KeyFn = IdentityKey>
+class ZoneMap final : public DequeObserver<T>
+{
+public:
+    using Key = typename std::decay<decltype(std::declval<const KeyFn &>()(std::declval<const T &>()))>::type;
+
+private:
+    enum ZoneState
+    {
+        ZONE_EMPTY,
+        ZONE_VALID,
+        ZONE_STALE
+    };
+
+    struct Zone
+    {
+        Key min;
+        Key max;
+        ZoneState state;
+    };
+
+    SegmentedDeque<T> *deque;
+    KeyFn keyFn;
+    mutable DynamicArray<Zone> zones;
+    mutable bool reshaped;
+
+    ZoneMap(const ZoneMap<T, KeyFn> &other) = delete;
+    ZoneMap<T, KeyFn> &operator=(const ZoneMap<T, KeyFn> &other) = delete;
+
+    void summarize(Zone &zone, const T *items, const int count) const;
+    bool inRange(const Key &key, const Key &lo, const Key &hi) const;
+
+    template <class FullFn, class PartialFn>
+    void scan(const Key &lo, const Key &hi, const FullFn &full, const PartialFn &partial) const;
+
+public:
+    ZoneMap(SegmentedDeque<T> &deque, const KeyFn &keyFn = KeyFn());
+    ~ZoneMap();
+
+    SegmentedDeque<T> *whereRange(const Key &lo, const Key &hi) const;
+    int count(const Key &lo, const Key &hi) const;
+    bool contains(const Key &lo, const Key &hi) const;
+    bool contains(const Key &key) const;
+
+    void invalidate();
+
+    void itemStored(const int segment, const T &item) override;
+    void segmentTouched(const int segment) override;
+    void segmentsReshaped() override;
+    void dequeDestroyed() override;
+};
+
+#include "../impl/zoneMap.tpp"
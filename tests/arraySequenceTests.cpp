@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../inc/arraySequence.hpp"
+#include <list>
+#include <vector>
 
 TEST(ArraySequenceTest, DefaultConstructorCreatesEmptySequence)
 {
@@ -256,7 +258,21 @@ TEST(ArraySequenceTest, ClearResetsSequence)
     seq.append(2);
     seq.clear();
     EXPECT_EQ(seq.getLength(), 0);
+#if SEQUENCE_BOUNDS_CHECK
     EXPECT_THROW(seq[0], std::out_of_range);
+#endif
+}
+
+TEST(ArraySequenceTest, ResizeAfterClearGivesDefaults)
+{
+    ArraySequence<int> seq;
+    seq.append(1);
+    seq.append(2);
+    seq.clear();
+    seq.resize(2);
+    EXPECT_EQ(seq.getLength(), 2);
+    EXPECT_EQ(seq[0], 0);
+    EXPECT_EQ(seq[1], 0);
 }
 
 TEST(ArraySequenceTest, OperatorBracketsAllowsAccessAndModification)
@@ -271,7 +287,9 @@ TEST(ArraySequenceTest, OperatorBracketsAllowsAccessAndModification)
     seq[0] = 10;
     EXPECT_EQ(seq[0], 10);
 
+#if SEQUENCE_BOUNDS_CHECK
     EXPECT_THROW(seq[2], std::out_of_range);
+#endif
 }
 
 TEST(ArraySequenceTest, PrintDoesNotCrash)
@@ -309,4 +327,62 @@ TEST(ArraySequenceTest, ConcatImmutableWithNullDoesNotThrow)
 {
     ArraySequence<int> seq;
     EXPECT_NO_THROW(seq.concatImmutable(nullptr));
-}
\ No newline at end of file
+}
+
+TEST(ArraySequenceTest, BulkAppendAndAssign)
+{
+    ArraySequence<int> seq;
+    seq.reserve(8);
+
+    int items[] = {1, 2, 3};
+    seq.appendRange(items, 3);
+
+    std::list<int> more = {4, 5};
+    seq.appendRange(more.begin(), more.end());
+    EXPECT_EQ(seq.getLength(), 5);
+    EXPECT_EQ(seq[3], 4);
+
+    std::vector<int> replacement = {9, 8};
+    seq.assign(replacement.begin(), replacement.end());
+    EXPECT_EQ(seq.getLength(), 2);
+    EXPECT_EQ(seq[0], 9);
+    EXPECT_EQ(seq[1], 8);
+}
+
+TEST(ArraySequenceTest, AtChecksAndUnsafeGetDoesNot)
+{
+    int items[] = {1, 2, 3};
+    ArraySequence<int> seq(items, 3);
+
+    EXPECT_EQ(seq.at(0), 1);
+    EXPECT_THROW(seq.at(3), std::out_of_range);
+
+    seq.unsafeGet(1) = 20;
+    EXPECT_EQ(seq.get(1), 20);
+    seq.set(2, 30);
+    EXPECT_EQ(seq.unsafeGet(2), 30);
+    EXPECT_THROW(seq.set(3, 0), std::out_of_range);
+    EXPECT_THROW(seq.insertAt(0, 4), std::out_of_range);
+}
+
+TEST(ArraySequenceTest, ConcatReadsWholeBlocks)
+{
+    int items[] = {1, 2, 3};
+    ArraySequence<int> seq(items, 3);
+    seq.concat(&seq);
+    ASSERT_EQ(seq.getLength(), 6);
+    EXPECT_EQ(seq.get(3), 1);
+    EXPECT_EQ(seq.get(5), 3);
+
+    int blocks = 0;
+    int sum = 0;
+    auto visitor = makeBlockVisitor<int>([&](const int *data, const int count)
+                                         {
+        blocks++;
+        for (int i = 0; i < count; i++) sum += data[i]; });
+    seq.visitBlocks(1, 4, visitor);
+    EXPECT_EQ(blocks, 1);
+    EXPECT_EQ(sum, 2 + 3 + 1 + 2);
+    seq.visitBlocks(6, 0, visitor);
+    EXPECT_EQ(blocks, 1);
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include "../inc/dynamicArray.hpp"
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
 
 TEST(DynamicArrayTest, DefaultConstructorCreatesEmptyArray)
 {
@@ -130,6 +135,26 @@ TEST(DynamicArrayTest, InsertAtThrowsForInvalidIndices)
     EXPECT_THROW(arr.insertAt(1, 1), std::out_of_range);
 }
 
+TEST(DynamicArrayTest, RemoveAtShiftsLaterElements)
+{
+    DynamicArray<int, 4> arr;
+    for (int i = 0; i < 6; i++)
+    {
+        arr.append(i);
+    }
+
+    arr.removeAt(0);
+    arr.removeAt(2);
+    arr.removeAt(3);
+    ASSERT_EQ(arr.getSize(), 3);
+    EXPECT_EQ(arr[0], 1);
+    EXPECT_EQ(arr[1], 2);
+    EXPECT_EQ(arr[2], 4);
+
+    EXPECT_THROW(arr.removeAt(3), std::out_of_range);
+    EXPECT_THROW(arr.removeAt(-1), std::out_of_range);
+}
+
 TEST(DynamicArrayTest, SetModifiesExistingElements)
 {
     DynamicArray<int> arr;
@@ -241,7 +266,9 @@ TEST(DynamicArrayTest, ClearResetsArray)
     arr.append(2);
     arr.clear();
     EXPECT_EQ(arr.getSize(), 0);
+#if SEQUENCE_BOUNDS_CHECK
     EXPECT_THROW(arr[0], std::out_of_range);
+#endif
 }
 
 TEST(DynamicArrayTest, OperatorBracketsAllowsAccessAndModification)
@@ -256,7 +283,9 @@ TEST(DynamicArrayTest, OperatorBracketsAllowsAccessAndModification)
     arr[0] = 10;
     EXPECT_EQ(arr[0], 10);
 
+#if SEQUENCE_BOUNDS_CHECK
     EXPECT_THROW(arr[2], std::out_of_range);
+#endif
 }
 
 TEST(DynamicArrayTest, ConstOperatorBracketsWorks)
@@ -268,7 +297,9 @@ TEST(DynamicArrayTest, ConstOperatorBracketsWorks)
     const DynamicArray<int> &constArr = arr;
     EXPECT_EQ(constArr[0], 1);
     EXPECT_EQ(constArr[1], 2);
+#if SEQUENCE_BOUNDS_CHECK
     EXPECT_THROW(constArr[2], std::out_of_range);
+#endif
 }
 
 TEST(DynamicArrayTest, PrintDoesNotCrash)
@@ -278,4 +309,247 @@ TEST(DynamicArrayTest, PrintDoesNotCrash)
     arr.append(2);
 
     arr.print();
-}
\ No newline at end of file
+}
+
+TEST(DynamicArrayTest, AppendRangeFromPointerAndIterators)
+{
+    int items[] = {1, 2, 3, 4, 5};
+    DynamicArray<int> arr;
+    arr.appendRange(items, 5);
+    EXPECT_EQ(arr.getSize(), 5);
+    EXPECT_EQ(arr[4], 5);
+
+    std::list<int> more = {6, 7};
+    arr.appendRange(more.begin(), more.end());
+    EXPECT_EQ(arr.getSize(), 7);
+    EXPECT_EQ(arr[5], 6);
+    EXPECT_EQ(arr[6], 7);
+
+    std::istringstream input("8 9");
+    arr.appendRange(std::istream_iterator<int>(input), std::istream_iterator<int>());
+    EXPECT_EQ(arr.getSize(), 9);
+    EXPECT_EQ(arr[8], 9);
+
+    EXPECT_THROW(arr.appendRange(nullptr, 1), std::invalid_argument);
+    EXPECT_THROW(arr.appendRange(items, -1), std::invalid_argument);
+}
+
+TEST(DynamicArrayTest, AssignReplacesContents)
+{
+    DynamicArray<std::string> arr;
+    arr.append("old");
+
+    std::vector<std::string> items = {"a", "b", "c"};
+    arr.assign(items.begin(), items.end());
+    EXPECT_EQ(arr.getSize(), 3);
+    EXPECT_EQ(arr[0], "a");
+    EXPECT_EQ(arr[2], "c");
+}
+
+TEST(DynamicArrayTest, ReserveKeepsElements)
+{
+    DynamicArray<int> arr;
+    arr.append(1);
+    arr.reserve(100);
+    int *before = arr.getData();
+    for (int i = 2; i <= 100; i++)
+    {
+        arr.append(i);
+    }
+    EXPECT_EQ(arr.getData(), before);
+    EXPECT_EQ(arr[0], 1);
+    EXPECT_EQ(arr[99], 100);
+    EXPECT_THROW(arr.reserve(-1), std::invalid_argument);
+}
+
+TEST(DynamicArrayTest, ConcatWithItselfDoublesContents)
+{
+    DynamicArray<int> arr;
+    arr.append(1);
+    arr.append(2);
+    arr.concat(&arr);
+    EXPECT_EQ(arr.getSize(), 4);
+    EXPECT_EQ(arr[2], 1);
+    EXPECT_EQ(arr[3], 2);
+}
+
+TEST(DynamicArrayTest, AssignmentIntoSmallerBufferStaysUsable)
+{
+    DynamicArray<int> big;
+    for (int i = 0; i < 10; i++)
+    {
+        big.append(i);
+    }
+
+    DynamicArray<int> small;
+    small.append(0);
+    small = big;
+    small.append(10);
+    EXPECT_EQ(small.getSize(), 11);
+    EXPECT_EQ(small[10], 10);
+    EXPECT_EQ(small[9], 9);
+}
+
+TEST(DynamicArrayTest, AtChecksAndUnsafeGetDoesNot)
+{
+    int items[] = {4, 5, 6};
+    DynamicArray<int> arr(items, 3);
+
+    EXPECT_EQ(arr.at(1), 5);
+    EXPECT_THROW(arr.at(3), std::out_of_range);
+    EXPECT_THROW(arr.at(-1), std::out_of_range);
+
+    arr.unsafeGet(2) = 60;
+    const DynamicArray<int> &constArr = arr;
+    EXPECT_EQ(constArr.unsafeGet(2), 60);
+    EXPECT_EQ(constArr.at(2), 60);
+}
+
+TEST(DynamicArrayTest, InlineBufferHoldsSmallArrays)
+{
+    DynamicArray<int, 4> arr;
+    for (int i = 0; i < 4; i++)
+    {
+        arr.append(i);
+    }
+
+    const char *object = reinterpret_cast<const char *>(&arr);
+    const char *items = reinterpret_cast<const char *>(arr.getData());
+    EXPECT_TRUE(items >= object && items < object + sizeof(arr));
+
+    arr.append(4);
+    items = reinterpret_cast<const char *>(arr.getData());
+    EXPECT_FALSE(items >= object && items < object + sizeof(arr));
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(arr[i], i);
+    }
+
+    arr.clear();
+    EXPECT_EQ(arr.getSize(), 0);
+    EXPECT_EQ(reinterpret_cast<const char *>(arr.getData()), items);
+
+    arr.append(7);
+    arr.shrinkToFit();
+    items = reinterpret_cast<const char *>(arr.getData());
+    EXPECT_TRUE(items >= object && items < object + sizeof(arr));
+    EXPECT_EQ(arr.getCapacity(), 4);
+    EXPECT_EQ(arr.getMemoryUsage(), 0u);
+    EXPECT_EQ(arr[0], 7);
+}
+
+TEST(DynamicArrayTest, InlineArraysCopyAndShareTheBaseInterface)
+{
+    int items[] = {1, 2, 3, 4, 5, 6};
+    DynamicArray<int, 2> big(items, 6);
+    DynamicArray<int, 2> copy(big);
+    DynamicArray<int> &base = copy;
+
+    base.append(7);
+    EXPECT_EQ(copy.getSize(), 7);
+    EXPECT_EQ(big.getSize(), 6);
+
+    DynamicArray<int, 8> small;
+    small = big;
+    EXPECT_EQ(small.getSize(), 6);
+    EXPECT_EQ(small[5], 6);
+
+    DynamicArray<int> empty;
+    EXPECT_EQ(empty.getData(), nullptr);
+}
+
+TEST(DynamicArrayTest, ClearKeepsCapacityAndShrinkToFitReleasesIt)
+{
+    DynamicArray<int> arr;
+    for (int i = 0; i < 100; i++)
+    {
+        arr.append(i);
+    }
+    EXPECT_EQ(arr.getCapacity(), 128);
+    EXPECT_EQ(arr.getMemoryUsage(), 128 * sizeof(int));
+
+    arr.clear();
+    EXPECT_EQ(arr.getSize(), 0);
+    EXPECT_EQ(arr.getCapacity(), 128);
+
+    arr.append(1);
+    arr.append(2);
+    arr.shrinkToFit();
+    EXPECT_EQ(arr.getCapacity(), 2);
+    EXPECT_EQ(arr[1], 2);
+
+    arr.clear();
+    arr.shrinkToFit();
+    EXPECT_EQ(arr.getCapacity(), 0);
+    EXPECT_EQ(arr.getMemoryUsage(), 0u);
+}
+
+TEST(DynamicArrayTest, SlotsPastTheEndAreResetToDefaults)
+{
+    DynamicArray<std::string> arr;
+    arr.append("one");
+    arr.append("two");
+    arr.append("three");
+    arr.clear();
+    arr.resize(3);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(arr[i], "");
+    }
+
+    std::vector<std::string> letters{"a", "b", "c", "d"};
+    arr.assign(letters.begin(), letters.end());
+    arr.removeAt(1);
+    arr.resize(4);
+    EXPECT_EQ(arr[2], "d");
+    EXPECT_EQ(arr[3], "");
+    arr.resize(1);
+    arr.resize(3);
+    EXPECT_EQ(arr[0], "a");
+    EXPECT_EQ(arr[1], "");
+    EXPECT_EQ(arr[2], "");
+
+    DynamicArray<int, 4> small;
+    small.append(7);
+    small.append(8);
+    small.clear();
+    small.resize(2);
+    EXPECT_EQ(small[0], 0);
+    EXPECT_EQ(small[1], 0);
+
+    DynamicArray<int> longer;
+    longer.append(1);
+    longer.append(2);
+    longer.append(3);
+    DynamicArray<int> shorter;
+    shorter.append(9);
+    longer = shorter;
+    longer.resize(3);
+    EXPECT_EQ(longer[0], 9);
+    EXPECT_EQ(longer[1], 0);
+    EXPECT_EQ(longer[2], 0);
+}
+
+TEST(DynamicArrayTest, GrowthPoliciesPickTheNextCapacity)
+{
+    DynamicArray<int, 0, HalfGrowth> half;
+    DynamicArray<int, 0, FixedGrowth<10>> fixed;
+    for (int i = 0; i < 50; i++)
+    {
+        half.append(i);
+        fixed.append(i);
+        EXPECT_GE(half.getCapacity(), half.getSize());
+        EXPECT_LE(half.getCapacity(), half.getSize() * 3 / 2 + 2);
+        EXPECT_EQ(fixed.getCapacity() % 10, 0);
+        EXPECT_LT(fixed.getCapacity() - fixed.getSize(), 10);
+    }
+
+    int items[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    fixed.appendRange(items, 12);
+    EXPECT_EQ(fixed.getCapacity(), 70);
+    EXPECT_EQ(fixed.getLast(), 12);
+
+    EXPECT_EQ(DoublingGrowth::grow(0, 5), 8);
+    EXPECT_EQ(HalfGrowth::grow(4, 5), 7);
+    EXPECT_EQ(FixedGrowth<16>::grow(16, 17), 32);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../inc/fenwickTree.hpp"
+
+TEST(FenwickTreeTest, RebuildComputesPrefixSums)
+{
+    int values[] = {3, 0, 5, 2, 4};
+    FenwickTree<int> tree;
+    tree.rebuild(values, 5);
+
+    EXPECT_EQ(tree.getSize(), 5);
+    EXPECT_EQ(tree.prefixSum(0), 0);
+    EXPECT_EQ(tree.prefixSum(1), 3);
+    EXPECT_EQ(tree.prefixSum(3), 8);
+    EXPECT_EQ(tree.prefixSum(5), 14);
+    EXPECT_EQ(tree.get(2), 5);
+    EXPECT_THROW(tree.prefixSum(6), std::out_of_range);
+}
+
+TEST(FenwickTreeTest, RebuildFromAFunctionMatchesRebuildFromValues)
+{
+    int values[] = {4, 1, 0, 7, 2, 2, 9};
+    FenwickTree<int> fromValues;
+    FenwickTree<int> fromFunction;
+    fromValues.rebuild(values, 7);
+    fromFunction.rebuild(7, [&values](const int i)
+                         { return values[i]; });
+
+    EXPECT_EQ(fromFunction.getSize(), 7);
+    for (int length = 0; length <= 7; length++)
+    {
+        EXPECT_EQ(fromFunction.prefixSum(length), fromValues.prefixSum(length));
+    }
+    EXPECT_THROW(fromFunction.rebuild(-1, [](const int)
+                                      { return 0; }),
+                 std::invalid_argument);
+}
+
+TEST(FenwickTreeTest, PushAndAddMatchRebuild)
+{
+    FenwickTree<int> pushed;
+    for (int i = 1; i <= 13; i++)
+    {
+        pushed.push(i);
+    }
+    pushed.add(6, 10);
+
+    for (int length = 0; length <= 13; length++)
+    {
+        int expected = length * (length + 1) / 2 + (length > 6 ? 10 : 0);
+        EXPECT_EQ(pushed.prefixSum(length), expected);
+    }
+    EXPECT_THROW(pushed.add(13, 1), std::out_of_range);
+}
+
+TEST(FenwickTreeTest, FindSkipsEmptyEntries)
+{
+    int values[] = {2, 0, 0, 3, 1};
+    FenwickTree<int> tree;
+    tree.rebuild(values, 5);
+
+    int offset = -1;
+    EXPECT_EQ(tree.find(0, offset), 0);
+    EXPECT_EQ(offset, 0);
+    EXPECT_EQ(tree.find(1, offset), 0);
+    EXPECT_EQ(offset, 1);
+    EXPECT_EQ(tree.find(2, offset), 3);
+    EXPECT_EQ(offset, 0);
+    EXPECT_EQ(tree.find(4, offset), 3);
+    EXPECT_EQ(offset, 2);
+    EXPECT_EQ(tree.find(5, offset), 4);
+    EXPECT_EQ(offset, 0);
+
+    tree.clear();
+    EXPECT_EQ(tree.getSize(), 0);
+}
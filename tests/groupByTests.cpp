@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "../inc/segmentedDeque.hpp"
+#include "../inc/listSequence.hpp"
+#include "../types/person.hpp"
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(GroupByTest, CountsKeepTheOrderKeysFirstAppearIn)
+{
+    int items[] = {3, 1, 3, 2, 1, 3};
+    SegmentedDeque<int> deque(items, 6, 4);
+
+    auto *groups = deque.groupBy([](const int x)
+                                 { return x; })
+                       .count();
+
+    ASSERT_EQ(groups->getLength(), 3);
+    EXPECT_EQ(groups->get(0).key, 3);
+    EXPECT_EQ(groups->get(0).value, 3);
+    EXPECT_EQ(groups->get(1).key, 1);
+    EXPECT_EQ(groups->get(1).value, 2);
+    EXPECT_EQ(groups->get(2).key, 2);
+    EXPECT_EQ(groups->get(2).value, 1);
+    delete groups;
+}
+
+TEST(GroupByTest, SumMinAndMaxAggregateValuesPerKey)
+{
+    SegmentedDeque<Person> people(2);
+    people.append(Person("Ann", 30));
+    people.append(Person("Bob", 20));
+    people.append(Person("Ann", 10));
+    people.append(Person("Cid", 40));
+    people.append(Person("Bob", 25));
+
+    auto byName = people.groupBy([](const Person &p)
+                                 { return p.getName(); });
+    auto age = [](const Person &p)
+    { return p.getAge(); };
+
+    auto *sums = byName.sum(age);
+    auto *lows = byName.min(age);
+    auto *highs = byName.max(age);
+
+    ASSERT_EQ(sums->getLength(), 3);
+    EXPECT_EQ(sums->get(0).key, "Ann");
+    EXPECT_EQ(sums->get(0).value, 40);
+    EXPECT_EQ(sums->get(1).value, 45);
+    EXPECT_EQ(sums->get(2).value, 40);
+    EXPECT_EQ(lows->get(0).value, 10);
+    EXPECT_EQ(lows->get(1).value, 20);
+    EXPECT_EQ(highs->get(0).value, 30);
+    EXPECT_EQ(highs->get(1).value, 25);
+    EXPECT_EQ(highs->get(2).key, "Cid");
+
+    delete sums;
+    delete lows;
+    delete highs;
+}
+
+TEST(GroupByTest, CustomAggregateFoldsFromInit)
+{
+    const char *words[] = {"apple", "avocado", "banana", "blueberry", "cherry"};
+    SegmentedDeque<std::string> deque(3);
+    for (const char *word : words)
+    {
+        deque.append(word);
+    }
+
+    auto *joined = deque.groupBy([](const std::string &s)
+                                 { return s[0]; })
+                       .aggregate(customAggregate(
+                           std::string(),
+                           [](const std::string &acc, const std::string &s)
+                           { return acc.empty() ? s : acc + "," + s; },
+                           [](const std::string &a, const std::string &b)
+                           { return a.empty() ? b : a + "," + b; }));
+
+    ASSERT_EQ(joined->getLength(), 3);
+    EXPECT_EQ(joined->get(0).value, "apple,avocado");
+    EXPECT_EQ(joined->get(1).value, "banana,blueberry");
+    EXPECT_EQ(joined->get(2).value, "cherry");
+    delete joined;
+}
+
+TEST(GroupByTest, ParallelResultMatchesSerial)
+{
+    SegmentedDeque<int> deque(64);
+    std::map<int, long long> expected;
+    std::srand(5);
+    for (int i = 0; i < 50000; i++)
+    {
+        int value = std::rand() % 1000;
+        deque.append(value);
+        expected[value % 97] += value;
+    }
+
+    auto byBucket = deque.groupBy([](const int x)
+                                  { return x % 97; });
+    auto value = [](const int x)
+    { return static_cast<long long>(x); };
+    auto *serial = byBucket.sum(value);
+    auto *parallel = byBucket.sum(value, 4);
+
+    ASSERT_EQ(serial->getLength(), 97);
+    ASSERT_EQ(parallel->getLength(), 97);
+    for (int i = 0; i < serial->getLength(); i++)
+    {
+        EXPECT_EQ(parallel->get(i).key, serial->get(i).key);
+        EXPECT_EQ(parallel->get(i).value, serial->get(i).value);
+        EXPECT_EQ(serial->get(i).value, expected[serial->get(i).key]);
+    }
+
+    auto *counts = byBucket.count(3);
+    int total = 0;
+    for (int i = 0; i < counts->getLength(); i++)
+    {
+        total += counts->get(i).value;
+    }
+    EXPECT_EQ(total, 50000);
+
+    delete serial;
+    delete parallel;
+    delete counts;
+}
+
+TEST(GroupByTest, ManyDistinctKeysGrowTheTable)
+{
+    SegmentedDeque<int> deque(32);
+    for (int i = 0; i < 20000; i++)
+    {
+        deque.append(i % 7000);
+    }
+
+    auto *groups = deque.groupBy([](const int x)
+                                 { return x; })
+                       .count(2);
+
+    ASSERT_EQ(groups->getLength(), 7000);
+    for (int i = 0; i < groups->getLength(); i++)
+    {
+        EXPECT_EQ(groups->get(i).key, i);
+        EXPECT_EQ(groups->get(i).value, i < 6000 ? 3 : 2);
+    }
+    delete groups;
+}
+
+TEST(GroupByTest, WorksOverAnySequence)
+{
+    int items[] = {1, 2, 3, 4, 5, 6};
+    ArraySequence<int> array(items, 6);
+
+    auto *groups = groupBy(array, [](const int x)
+                           { return x % 2 == 0; })
+                       .max([](const int x)
+                            { return x; });
+
+    ASSERT_EQ(groups->getLength(), 2);
+    EXPECT_FALSE(groups->get(0).key);
+    EXPECT_EQ(groups->get(0).value, 5);
+    EXPECT_TRUE(groups->get(1).key);
+    EXPECT_EQ(groups->get(1).value, 6);
+
+    std::ostringstream out;
+    out << groups->get(1);
+    EXPECT_EQ(out.str(), "1: 6");
+    delete groups;
+}
+
+TEST(GroupByTest, ParallelOverAListMatchesSerial)
+{
+    ListSequence<int> list;
+    for (int i = 0; i < 40000; i++)
+    {
+        list.append(i % 1000);
+    }
+
+    auto byBucket = groupBy(list, [](const int x)
+                            { return x % 13; });
+    auto value = [](const int x)
+    { return static_cast<long long>(x); };
+    auto *serial = byBucket.sum(value);
+    for (int round = 0; round < 5; round++)
+    {
+        auto *parallel = byBucket.sum(value, 4);
+        ASSERT_EQ(parallel->getLength(), serial->getLength());
+        for (int i = 0; i < serial->getLength(); i++)
+        {
+            EXPECT_EQ(parallel->get(i).key, serial->get(i).key);
+            EXPECT_EQ(parallel->get(i).value, serial->get(i).value);
+        }
+        delete parallel;
+    }
+    delete serial;
+}
+
+TEST(GroupByTest, EmptySourceAndErrors)
+{
+    SegmentedDeque<int> deque;
+    auto byValue = deque.groupBy([](const int x)
+                                 { return x; });
+
+    auto *groups = byValue.count(4);
+    EXPECT_EQ(groups->getLength(), 0);
+    delete groups;
+
+    EXPECT_THROW(byValue.count(0), std::invalid_argument);
+
+    for (int i = 0; i < 10000; i++)
+    {
+        deque.append(i);
+    }
+    auto failing = deque.groupBy([](const int x)
+                                 {
+        if (x == 9000)
+        {
+            throw std::runtime_error("bad key");
+        }
+        return x; });
+    EXPECT_THROW(failing.count(2), std::runtime_error);
+}
@@ -0,0 +1,359 @@
+#include <gtest/gtest.h>
+#include "../inc/segmentedDeque.hpp"
+#include "../types/person.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static std::vector<int> positionsOf(const std::vector<int> &items, const int key)
+{
+    std::vector<int> result;
+    for (int i = 0; i < static_cast<int>(items.size()); i++)
+    {
+        if (items[i] == key)
+        {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+static std::vector<int> toVector(SegmentedDeque<int> *indices)
+{
+    std::vector<int> result;
+    for (int i = 0; i < indices->getLength(); i++)
+    {
+        result.push_back(indices->get(i));
+    }
+    delete indices;
+    return result;
+}
+
+TEST(HashIndexTest, LookupsMatchAScanThroughEveryKindOfChange)
+{
+    SegmentedDeque<int> deque(4);
+    std::vector<int> reference;
+    HashIndex<int> *index = deque.hashIndex();
+    std::srand(13);
+
+    for (int step = 0; step < 2000; step++)
+    {
+        int value = std::rand() % 50;
+        int size = static_cast<int>(reference.size());
+        int at = size > 0 ? std::rand() % size : 0;
+        switch (size == 0 ? 0 : std::rand() % 9)
+        {
+        case 0:
+        case 1:
+            deque.append(value);
+            reference.push_back(value);
+            break;
+        case 2:
+            deque.prepend(value);
+            reference.insert(reference.begin(), value);
+            break;
+        case 3:
+            deque.set(at, value);
+            reference[at] = value;
+            break;
+        case 4:
+            deque.erase(0);
+            reference.erase(reference.begin());
+            break;
+        case 5:
+            deque.erase(size - 1);
+            reference.pop_back();
+            break;
+        case 6:
+            deque.erase(at);
+            reference.erase(reference.begin() + at);
+            break;
+        case 7:
+            deque.insertAt(value, at);
+            reference.insert(reference.begin() + at, value);
+            break;
+        default:
+        {
+            int more[] = {value, value + 1, value};
+            deque.appendRange(more, 3);
+            reference.insert(reference.end(), more, more + 3);
+            break;
+        }
+        }
+
+        int key = std::rand() % 55;
+        std::vector<int> expected = positionsOf(reference, key);
+        ASSERT_EQ(index->findFirst(key), expected.empty() ? -1 : expected[0]) << "step " << step;
+        ASSERT_EQ(index->contains(key), !expected.empty());
+        if (step % 50 == 0)
+        {
+            ASSERT_EQ(toVector(index->findAll(key)), expected);
+        }
+    }
+
+    deque.get(0) = 1000;
+    EXPECT_EQ(index->findFirst(1000), 0);
+    deque.clear();
+    EXPECT_EQ(index->findFirst(1000), -1);
+    delete index;
+}
+
+TEST(HashIndexTest, ChangesAtTheEndsAreAppliedWithoutRebuilding)
+{
+    SegmentedDeque<int> deque(8);
+    for (int i = 0; i < 1000; i++)
+    {
+        deque.append(i);
+    }
+
+    int keyCalls = 0;
+    auto *index = deque.hashIndex([&keyCalls](int x)
+                                  {
+        keyCalls++;
+        return x % 500; });
+    EXPECT_EQ(index->findFirst(7), 7);
+    keyCalls = 0;
+
+    deque.append(1000);
+    deque.prepend(-3);
+    deque.set(10, 4321);
+    deque.erase(0);
+    deque.erase(deque.getLength() - 1);
+    EXPECT_EQ(keyCalls, 6);
+
+    keyCalls = 0;
+    // 9 was overwritten; 4321 sits at index 9 once -3 is gone.
+    EXPECT_EQ(toVector(index->findAll(9)), (std::vector<int>{509}));
+    EXPECT_EQ(index->findFirst(321), 9);
+    EXPECT_LT(keyCalls, 10);
+    delete index;
+}
+
+TEST(HashIndexTest, WritesThroughReferencesMatchAScan)
+{
+    SegmentedDeque<int> deque(4);
+    std::vector<int> reference;
+    HashIndex<int> *index = deque.hashIndex();
+    std::srand(29);
+
+    for (int step = 0; step < 3000; step++)
+    {
+        int value = std::rand() % 40;
+        int size = static_cast<int>(reference.size());
+        int at = size > 0 ? std::rand() % size : 0;
+        switch (size == 0 ? 0 : std::rand() % 10)
+        {
+        case 0:
+        case 1:
+            deque.append(value);
+            reference.push_back(value);
+            break;
+        case 2:
+            deque.prepend(value);
+            reference.insert(reference.begin(), value);
+            break;
+        case 3:
+            deque.get(at) = value;
+            reference[at] = value;
+            break;
+        case 4:
+            deque[at] = value;
+            deque.set(at, value + 1);
+            reference[at] = value + 1;
+            break;
+        case 5:
+            reference[0] = deque.getFirst() = value;
+            deque.erase(0);
+            reference.erase(reference.begin());
+            break;
+        case 6:
+            reference.back() = deque.getLast() = value;
+            deque.erase(size - 1);
+            reference.pop_back();
+            break;
+        case 7:
+            *(deque.begin() + at) = value;
+            reference[at] = value;
+            deque.insertAt(value, at);
+            reference.insert(reference.begin() + at, value);
+            break;
+        case 8:
+        {
+            int seen = deque.get(at);
+            deque.prepend(seen);
+            reference.insert(reference.begin(), seen);
+            break;
+        }
+        default:
+            deque.forEachBlock([value](int *items, const int count)
+                               {
+                if (count > 1)
+                {
+                    items[1] = value;
+                } });
+            reference.assign(deque.cbegin(), deque.cend());
+            break;
+        }
+
+        int key = std::rand() % 45;
+        std::vector<int> expected = positionsOf(reference, key);
+        ASSERT_EQ(toVector(index->findAll(key)), expected) << "step " << step;
+    }
+    delete index;
+}
+
+TEST(HashIndexTest, ReadingANonConstDequeReindexesOnlyTouchedSegments)
+{
+    SegmentedDeque<int> deque(8);
+    for (int i = 0; i < 1000; i++)
+    {
+        deque.append(i);
+    }
+
+    int keyCalls = 0;
+    auto *index = deque.hashIndex([&keyCalls](int x)
+                                  {
+        keyCalls++;
+        return x; });
+    EXPECT_EQ(index->findFirst(500), 500);
+
+    keyCalls = 0;
+    long long sum = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        sum += deque.get(i);
+    }
+    EXPECT_EQ(sum, 120);
+    EXPECT_EQ(index->findFirst(3), 3);
+    // Two segments are taken out and put back, not all 1000 items.
+    EXPECT_LT(keyCalls, 40);
+
+    keyCalls = 0;
+    deque.get(9) = 2000;
+    deque.append(3000);
+    deque.set(10, 4000);
+    EXPECT_EQ(index->findFirst(2000), 9);
+    EXPECT_EQ(index->findFirst(4000), 10);
+    EXPECT_EQ(index->findFirst(3000), 1000);
+    EXPECT_EQ(index->findFirst(9), -1);
+    EXPECT_LT(keyCalls, 40);
+    delete index;
+}
+
+TEST(HashIndexTest, ItemsAddedToATouchedSegmentStayTracked)
+{
+    SegmentedDeque<int> deque(4);
+    deque.append(1);
+    deque.append(2);
+    HashIndex<int> *index = deque.hashIndex();
+    EXPECT_EQ(index->findFirst(2), 1);
+
+    deque.get(0);
+    deque.append(3);
+    deque.get(2) = 7;
+    deque.prepend(5);
+    deque[0] = 8;
+    EXPECT_EQ(index->findFirst(7), 3);
+    EXPECT_EQ(index->findFirst(8), 0);
+    EXPECT_EQ(index->findFirst(3), -1);
+    EXPECT_EQ(index->findFirst(5), -1);
+    delete index;
+}
+
+TEST(HashIndexTest, SparseLookupsMatchAScan)
+{
+    for (int seed = 0; seed < 40; seed++)
+    {
+        SegmentedDeque<int> deque(4);
+        std::vector<int> reference;
+        HashIndex<int> *index = deque.hashIndex();
+        index->findFirst(0);
+        std::srand(seed);
+
+        for (int step = 0; step < 600; step++)
+        {
+            int value = std::rand() % 30;
+            int size = static_cast<int>(reference.size());
+            int at = size > 0 ? std::rand() % size : 0;
+            switch (size == 0 ? 0 : std::rand() % 7)
+            {
+            case 0:
+            case 6:
+                deque.append(value);
+                reference.push_back(value);
+                break;
+            case 1:
+                deque.prepend(value);
+                reference.insert(reference.begin(), value);
+                break;
+            case 2:
+                deque.get(at) = value;
+                reference[at] = value;
+                break;
+            case 3:
+                deque.set(at, value);
+                reference[at] = value;
+                break;
+            case 4:
+                deque.erase(0);
+                reference.erase(reference.begin());
+                break;
+            default:
+                deque.erase(size - 1);
+                reference.pop_back();
+                break;
+            }
+
+            if (step % 97 == 96)
+            {
+                int key = std::rand() % 30;
+                ASSERT_EQ(toVector(index->findAll(key)), positionsOf(reference, key))
+                    << "seed " << seed << " step " << step;
+            }
+        }
+        for (int key = 0; key < 30; key++)
+        {
+            ASSERT_EQ(toVector(index->findAll(key)), positionsOf(reference, key)) << "seed " << seed;
+        }
+        delete index;
+    }
+}
+
+TEST(HashIndexTest, PersonByName)
+{
+    SegmentedDeque<Person> people(2);
+    people.append(Person("Ann", 21));
+    people.append(Person("Bob", 25));
+    people.append(Person("Cid", 30));
+    people.append(Person("Bob", 52));
+
+    auto *byName = people.hashIndex([](const Person &p)
+                                    { return p.getName(); });
+    EXPECT_EQ(byName->findFirst("Bob"), 1);
+    EXPECT_EQ(toVector(byName->findAll("Bob")), (std::vector<int>{1, 3}));
+    EXPECT_EQ(byName->findFirst("Zed"), -1);
+
+    people.set(1, Person("Zed", 25));
+    people.prepend(Person("Bob", 9));
+    EXPECT_EQ(toVector(byName->findAll("Bob")), (std::vector<int>{0, 4}));
+    EXPECT_EQ(byName->findFirst("Zed"), 2);
+
+    people.erase(0);
+    EXPECT_EQ(byName->findFirst("Bob"), 3);
+
+    const SegmentedDeque<Person> &view = people;
+    EXPECT_EQ(view.get(byName->findFirst("Cid")).getAge(), 30);
+    delete byName;
+}
+
+TEST(HashIndexTest, DetachesFromItsDeque)
+{
+    auto *deque = new SegmentedDeque<int>(4);
+    deque->append(5);
+    HashIndex<int> *index = deque->hashIndex();
+    EXPECT_TRUE(index->contains(5));
+
+    delete deque;
+    EXPECT_THROW(index->findFirst(5), std::logic_error);
+    delete index;
+}
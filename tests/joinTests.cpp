@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include "../inc/segmentedDeque.hpp"
+#include "../types/person.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+static std::vector<std::pair<int, int>> nestedLoopJoin(const std::vector<int> &left, const std::vector<int> &right)
+{
+    std::vector<std::pair<int, int>> result;
+    for (int l : left)
+    {
+        for (int r : right)
+        {
+            if (l % 100 == r % 100)
+            {
+                result.emplace_back(l, r);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static std::vector<std::pair<int, int>> toSortedPairs(SegmentedDeque<Joined<int, int>> *joined)
+{
+    std::vector<std::pair<int, int>> result;
+    for (int i = 0; i < joined->getLength(); i++)
+    {
+        result.emplace_back(joined->get(i).left, joined->get(i).right);
+    }
+    delete joined;
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static std::vector<int> randomItems(const int count)
+{
+    std::vector<int> items;
+    for (int i = 0; i < count; i++)
+    {
+        items.push_back(std::rand() % 5000);
+    }
+    return items;
+}
+
+TEST(HashJoinTest, MatchesANestedLoopFromEitherSide)
+{
+    std::srand(21);
+    std::vector<int> small = randomItems(300);
+    std::vector<int> large = randomItems(2000);
+    SegmentedDeque<int> smallDeque(small.data(), static_cast<int>(small.size()), 16);
+    SegmentedDeque<int> largeDeque(large.data(), static_cast<int>(large.size()), 16);
+    auto bucket = [](const int x)
+    { return x % 100; };
+
+    EXPECT_EQ(toSortedPairs(smallDeque.hashJoin(largeDeque, bucket, bucket)), nestedLoopJoin(small, large));
+    EXPECT_EQ(toSortedPairs(largeDeque.hashJoin(smallDeque, bucket, bucket)), nestedLoopJoin(large, small));
+}
+
+TEST(HashJoinTest, PairsFollowTheLargerSideThenTheSmaller)
+{
+    int leftItems[] = {11, 2, 21};
+    int rightItems[] = {12, 31, 3, 41, 22};
+    SegmentedDeque<int> left(leftItems, 3, 2);
+    SegmentedDeque<int> right(rightItems, 5, 2);
+    auto lastDigit = [](const int x)
+    { return x % 10; };
+
+    std::vector<std::pair<int, int>> seen;
+    left.hashJoin(right, lastDigit, lastDigit, [&seen](const int l, const int r)
+                  { seen.emplace_back(l, r); });
+
+    EXPECT_EQ(seen, (std::vector<std::pair<int, int>>{{2, 12}, {11, 31}, {21, 31}, {11, 41}, {21, 41}, {2, 22}}));
+}
+
+TEST(HashJoinTest, JoinsDifferentTypesOnConvertibleKeys)
+{
+    SegmentedDeque<Person> people(4);
+    people.append(Person("Ann", 30));
+    people.append(Person("Bob", 40));
+    people.append(Person("Cid", 30));
+    std::string labelItems[] = {"30s", "40s", "50s"};
+    SegmentedDeque<std::string> labels(labelItems, 3);
+
+    auto *joined = people.hashJoin(labels, [](const Person &p)
+                                   { return static_cast<long long>(p.getAge() / 10); },
+                                   [](const std::string &s)
+                                   { return s[0] - '0'; });
+
+    ASSERT_EQ(joined->getLength(), 3);
+    EXPECT_EQ(joined->get(0).left.getName(), "Ann");
+    EXPECT_EQ(joined->get(0).right, "30s");
+    EXPECT_EQ(joined->get(1).left.getName(), "Cid");
+    EXPECT_EQ(joined->get(2).right, "40s");
+
+    std::ostringstream out;
+    Joined<int, std::string> row{1, "one"};
+    out << row;
+    EXPECT_EQ(out.str(), "(1, one)");
+    delete joined;
+}
+
+TEST(HashJoinTest, ParallelProbeMatchesSerial)
+{
+    std::srand(8);
+    std::vector<int> small = randomItems(500);
+    std::vector<int> large = randomItems(40000);
+    SegmentedDeque<int> smallDeque(small.data(), static_cast<int>(small.size()));
+    SegmentedDeque<int> largeDeque(large.data(), static_cast<int>(large.size()), 256);
+    auto bucket = [](const int x)
+    { return x % 100; };
+
+    auto *serial = smallDeque.hashJoin(largeDeque, bucket, bucket);
+    auto *parallel = smallDeque.hashJoin(largeDeque, bucket, bucket, 4);
+    ASSERT_EQ(parallel->getLength(), serial->getLength());
+    for (int i = 0; i < serial->getLength(); i++)
+    {
+        ASSERT_EQ(parallel->get(i).left, serial->get(i).left);
+        ASSERT_EQ(parallel->get(i).right, serial->get(i).right);
+    }
+    delete serial;
+    delete parallel;
+
+    // With the larger side on the left the probe ranges split the left deque.
+    auto *largeFirst = largeDeque.hashJoin(smallDeque, bucket, bucket);
+    auto *largeFirstParallel = largeDeque.hashJoin(smallDeque, bucket, bucket, 4);
+    ASSERT_EQ(largeFirstParallel->getLength(), largeFirst->getLength());
+    for (int i = 0; i < largeFirst->getLength(); i++)
+    {
+        ASSERT_EQ(largeFirstParallel->get(i).left, largeFirst->get(i).left);
+        ASSERT_EQ(largeFirstParallel->get(i).right, largeFirst->get(i).right);
+    }
+    delete largeFirst;
+    delete largeFirstParallel;
+
+    long long total = 0;
+    std::mutex lock;
+    smallDeque.hashJoin(largeDeque, bucket, bucket, [&](const int l, const int r)
+                        {
+        std::lock_guard<std::mutex> guard(lock);
+        total += l + r; }, 3);
+    long long expected = 0;
+    for (const auto &pair : nestedLoopJoin(small, large))
+    {
+        expected += pair.first + pair.second;
+    }
+    EXPECT_EQ(total, expected);
+}
+
+TEST(HashJoinTest, EmptySidesAndErrors)
+{
+    SegmentedDeque<int> empty;
+    int items[] = {1, 2, 3};
+    SegmentedDeque<int> deque(items, 3);
+    auto identity = [](const int x)
+    { return x; };
+
+    auto *joined = empty.hashJoin(deque, identity, identity);
+    EXPECT_EQ(joined->getLength(), 0);
+    delete joined;
+    joined = deque.hashJoin(empty, identity, identity);
+    EXPECT_EQ(joined->getLength(), 0);
+    delete joined;
+
+    EXPECT_THROW(deque.hashJoin(deque, identity, identity, 0), std::invalid_argument);
+}
+
+TEST(MergeJoinTest, MatchesANestedLoopOnSortedInputs)
+{
+    std::srand(34);
+    std::vector<int> left = randomItems(700);
+    std::vector<int> right = randomItems(900);
+    auto bucket = [](const int x)
+    { return x % 100; };
+    auto byBucket = [](const int a, const int b)
+    { return a % 100 < b % 100; };
+    std::stable_sort(left.begin(), left.end(), byBucket);
+    std::stable_sort(right.begin(), right.end(), byBucket);
+    SegmentedDeque<int> leftDeque(left.data(), static_cast<int>(left.size()), 8);
+    SegmentedDeque<int> rightDeque(right.data(), static_cast<int>(right.size()), 8);
+
+    auto *joined = leftDeque.mergeJoin(rightDeque, bucket, bucket);
+    for (int i = 1; i < joined->getLength(); i++)
+    {
+        ASSERT_LE(joined->get(i - 1).left % 100, joined->get(i).left % 100);
+    }
+    EXPECT_EQ(toSortedPairs(joined), nestedLoopJoin(left, right));
+}
+
+TEST(MergeJoinTest, PairsRunsOfEqualKeys)
+{
+    int leftItems[] = {1, 2, 2, 4, 5, 5};
+    int rightItems[] = {0, 2, 2, 3, 5};
+    SegmentedDeque<int> left(leftItems, 6, 2);
+    SegmentedDeque<int> right(rightItems, 5, 2);
+    auto identity = [](const int x)
+    { return x; };
+
+    std::vector<std::pair<int, int>> seen;
+    left.mergeJoin(right, identity, identity, [&seen](const int l, const int r)
+                   { seen.emplace_back(l, r); });
+
+    EXPECT_EQ(seen, (std::vector<std::pair<int, int>>{{2, 2}, {2, 2}, {2, 2}, {2, 2}, {5, 5}, {5, 5}}));
+}
+
+TEST(MergeJoinTest, RejectsUnsortedInput)
+{
+    int sortedItems[] = {1, 2, 3};
+    int unsortedItems[] = {1, 3, 2};
+    SegmentedDeque<int> sorted(sortedItems, 3);
+    SegmentedDeque<int> unsorted(unsortedItems, 3);
+    SegmentedDeque<int> empty;
+    auto identity = [](const int x)
+    { return x; };
+
+    EXPECT_THROW(delete sorted.mergeJoin(unsorted, identity, identity), std::invalid_argument);
+    EXPECT_THROW(delete unsorted.mergeJoin(sorted, identity, identity), std::invalid_argument);
+
+    auto *joined = sorted.mergeJoin(empty, identity, identity);
+    EXPECT_EQ(joined->getLength(), 0);
+    delete joined;
+}
@@ -322,4 +322,101 @@ TEST(LinkedListTest, IteratorEqualityComparison)
     auto end1 = list.end();
     auto end2 = list.end();
     EXPECT_TRUE(end1 == end2);
-}
\ No newline at end of file
+}
+
+TEST(LinkedListTest, LastElementTrackedAcrossOperations)
+{
+    LinkedList<int> list;
+    list.prepend(2);
+    EXPECT_EQ(list.getLast(), 2);
+
+    list.insertAt(1, 0);
+    list.append(3);
+    EXPECT_EQ(list.getLast(), 3);
+
+    int items[] = {4, 5};
+    list.appendRange(items, 2);
+    EXPECT_EQ(list.getLast(), 5);
+    EXPECT_EQ(list.getLength(), 5);
+
+    list.clear();
+    EXPECT_THROW(list.getLast(), std::out_of_range);
+    list.append(6);
+    EXPECT_EQ(list.getFirst(), 6);
+    EXPECT_EQ(list.getLast(), 6);
+}
+
+TEST(LinkedListTest, CompactLaysNodesOutInListOrder)
+{
+    LinkedList<int> list;
+    for (int i = 0; i < 12; i++)
+    {
+        list.prepend(i);
+    }
+    list.insertAt(100, 5);
+
+    EXPECT_GT(&list.get(0), &list.get(1));
+
+    list.compact();
+    ASSERT_EQ(list.getLength(), 13);
+    EXPECT_EQ(list.get(0), 11);
+    EXPECT_EQ(list.get(5), 100);
+    EXPECT_EQ(list.getLast(), 0);
+    for (int i = 0; i + 1 < list.getLength(); i++)
+    {
+        EXPECT_LT(&list.get(i), &list.get(i + 1));
+    }
+
+    list.append(-1);
+    list.prepend(-2);
+    EXPECT_EQ(list.getFirst(), -2);
+    EXPECT_EQ(list.getLast(), -1);
+}
+
+TEST(LinkedListTest, ClearReusesPooledNodes)
+{
+    LinkedList<int> list;
+    for (int i = 0; i < 5; i++)
+    {
+        list.append(i);
+    }
+    const int *first = &list.getFirst();
+
+    list.clear();
+    list.append(42);
+    EXPECT_EQ(&list.getFirst(), first);
+    EXPECT_EQ(list.getFirst(), 42);
+}
+
+TEST(LinkedListTest, IndexedAccessStaysCorrectAroundTheFinger)
+{
+    LinkedList<int> list;
+    for (int i = 0; i < 50; i++)
+    {
+        list.append(i);
+    }
+
+    EXPECT_EQ(list.get(20), 20);
+    list.prepend(-1);
+    EXPECT_EQ(list.get(21), 20);
+    list.insertAt(100, 10);
+    EXPECT_EQ(list.get(10), 100);
+    EXPECT_EQ(list.get(22), 20);
+    list.insertAt(200, 30);
+    EXPECT_EQ(list.get(22), 20);
+    EXPECT_EQ(list.get(30), 200);
+    list.set(31, 300);
+    EXPECT_EQ(list.get(31), 300);
+
+    for (int i = list.getLength() - 1; i >= 0; i -= 7)
+    {
+        int expected = i == 0 ? -1 : i == 10 ? 100 : i == 30 ? 200 : i == 31 ? 300 : i < 10 ? i - 1 : i < 30 ? i - 2 : i - 3;
+        EXPECT_EQ(list.get(i), expected);
+    }
+
+    list.compact();
+    EXPECT_EQ(list.get(30), 200);
+    list.clear();
+    list.append(7);
+    EXPECT_EQ(list.get(0), 7);
+}
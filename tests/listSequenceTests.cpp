@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../inc/listSequence.hpp"
+#include "../inc/arraySequence.hpp"
+#include <vector>
 
 TEST(ListSequenceTest, DefaultConstructorCreatesEmptySequence)
 {
@@ -315,4 +317,50 @@ TEST(ListSequenceTest, PrintOutputIsCorrect)
     seq.print();
     output = testing::internal::GetCapturedStdout();
     EXPECT_EQ(output, "1 2 3 ");
-}
\ No newline at end of file
+}
+
+TEST(ListSequenceTest, BulkAppendAndAssign)
+{
+    ListSequence<int> seq;
+    seq.append(0);
+
+    int items[] = {1, 2, 3};
+    seq.appendRange(items, 3);
+    EXPECT_EQ(seq.getLength(), 4);
+    EXPECT_EQ(seq.getLast(), 3);
+
+    std::vector<int> replacement = {7, 8, 9};
+    seq.assign(replacement.begin(), replacement.end());
+    EXPECT_EQ(seq.getLength(), 3);
+    EXPECT_EQ(seq.getFirst(), 7);
+    EXPECT_EQ(seq.getLast(), 9);
+
+    EXPECT_NO_THROW(seq.reserve(10));
+    EXPECT_THROW(seq.appendRange(nullptr, 2), std::invalid_argument);
+}
+
+TEST(ListSequenceTest, ConcatCopiesBlocksFromAnySequence)
+{
+    int items[] = {1, 2, 3, 4, 5};
+    ArraySequence<int> array(items, 5);
+    UnrolledListSequence<int> unrolled(items, 5);
+
+    ListSequence<int> seq;
+    seq.concat(&array);
+    seq.concat(&unrolled);
+    seq.concat(&seq);
+    ASSERT_EQ(seq.getLength(), 20);
+    for (int i = 0; i < 20; i++)
+    {
+        EXPECT_EQ(seq.get(i), i % 5 + 1);
+    }
+
+    int blocks = 0;
+    auto counter = makeBlockVisitor<int>([&](const int *, const int)
+                                         { blocks++; });
+    unrolled.visitBlocks(1, 3, counter);
+    EXPECT_EQ(blocks, 1);
+    seq.visitBlocks(1, 3, counter);
+    EXPECT_EQ(blocks, 4);
+    EXPECT_THROW(seq.visitBlocks(-1, 2, counter), std::out_of_range);
+}
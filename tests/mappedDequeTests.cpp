@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "../inc/mappedDeque.hpp"
+#include "../types/complex.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef SEQUENCE_HAS_MMAP
+
+class MappedDequeTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        path = ::testing::TempDir() + "mappedDequeTest.bin";
+
+        SegmentedDeque<int> deque(4);
+        for (int i = 0; i < 10; i++)
+        {
+            deque.append(i);
+        }
+        deque.prepend(-1);
+
+        std::ofstream out(path, std::ios::binary);
+        deque.save(out);
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    std::string path;
+};
+
+TEST_F(MappedDequeTest, OpenExposesSavedElements)
+{
+    const MappedDeque<int> *view = MappedDeque<int>::open(path);
+
+    EXPECT_EQ(view->getLength(), 11);
+    EXPECT_EQ(view->getSegmentSize(), 4);
+    EXPECT_EQ(view->getFirst(), -1);
+    EXPECT_EQ(view->getLast(), 9);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(view->get(i + 1), i);
+    }
+    EXPECT_THROW(view->get(11), std::out_of_range);
+
+    delete view;
+}
+
+TEST_F(MappedDequeTest, IteratesWhereAndReduce)
+{
+    const MappedDeque<int> *view = MappedDeque<int>::open(path);
+
+    int expected = -1;
+    for (auto it = view->cbegin(); it != view->cend(); ++it)
+    {
+        EXPECT_EQ(*it, expected++);
+    }
+    EXPECT_EQ(expected, 10);
+
+    int sum = view->reduce([](int acc, int x)
+                           { return acc + x; }, 0);
+    EXPECT_EQ(sum, 44);
+
+    SegmentedDeque<int> *even = view->where([](int x)
+                                            { return x % 2 == 0; });
+    EXPECT_EQ(even->getLength(), 5);
+    EXPECT_EQ(even->get(4), 8);
+    delete even;
+
+    delete view;
+}
+
+TEST_F(MappedDequeTest, WorksThroughSequenceInterface)
+{
+    const MappedDeque<int> *view = MappedDeque<int>::open(path);
+    const Sequence<int> *sequence = view;
+
+    Sequence<int> *sub = sequence->getSubsequence(2, 6);
+    EXPECT_EQ(sub->getLength(), 5);
+    EXPECT_EQ(sub->get(0), 1);
+    EXPECT_EQ(sub->get(4), 5);
+    delete sub;
+
+    Sequence<int> *appended = sequence->appendImmutable(100);
+    EXPECT_EQ(appended->getLength(), 12);
+    EXPECT_EQ(appended->getLast(), 100);
+    EXPECT_EQ(view->getLength(), 11);
+    delete appended;
+
+    MappedDeque<int> *mutableView = const_cast<MappedDeque<int> *>(view);
+    EXPECT_THROW(mutableView->append(1), std::logic_error);
+    EXPECT_THROW(mutableView->set(0, 1), std::logic_error);
+
+    delete view;
+}
+
+TEST_F(MappedDequeTest, RejectsMismatchedTypesAndMissingFiles)
+{
+    EXPECT_THROW(MappedDeque<double>::open(path), std::runtime_error);
+    EXPECT_THROW(MappedDeque<int>::open(path + ".missing"), std::runtime_error);
+}
+
+TEST_F(MappedDequeTest, RejectsCorruptedSegmentLengths)
+{
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        bytes = contents.str();
+    }
+
+    uint32_t lengths[] = {0, 5};
+    for (uint32_t length : lengths)
+    {
+        std::string corrupted = bytes;
+        std::memcpy(&corrupted[sizeof(DequeFileHeader)], &length, sizeof(length));
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(corrupted.data(), static_cast<std::streamsize>(corrupted.size()));
+        }
+        EXPECT_THROW(MappedDeque<int>::open(path), std::runtime_error);
+    }
+}
+
+TEST(MappedDequeComplexTest, MapsComplexNumbers)
+{
+    std::string path = ::testing::TempDir() + "mappedDequeComplexTest.bin";
+
+    SegmentedDeque<Complex> deque(2);
+    deque.append(Complex(1, 2));
+    deque.append(Complex(3, 4));
+    deque.append(Complex(5, 6));
+    {
+        std::ofstream out(path, std::ios::binary);
+        deque.save(out);
+    }
+
+    const MappedDeque<Complex> *view = MappedDeque<Complex>::open(path);
+    EXPECT_EQ(view->getLength(), 3);
+    EXPECT_EQ(view->get(1), Complex(3, 4));
+
+    double realSum = view->reduce([](double acc, const Complex &c)
+                                  { return acc + c.getReal(); }, 0.0);
+    EXPECT_DOUBLE_EQ(realSum, 9.0);
+
+    delete view;
+    std::remove(path.c_str());
+}
+
+#endif
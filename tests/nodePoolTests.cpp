@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../inc/nodePool.hpp"
+#include <set>
+
+struct PoolItem
+{
+    long long value;
+    PoolItem *next;
+};
+
+TEST(NodePoolTest, SequentialAllocationsAreContiguous)
+{
+    NodePool<PoolItem> pool;
+    char *first = static_cast<char *>(pool.allocate());
+    for (int i = 1; i < NODE_POOL_FIRST_SLAB; i++)
+    {
+        char *slot = static_cast<char *>(pool.allocate());
+        EXPECT_EQ(slot, first + i * sizeof(PoolItem));
+    }
+    EXPECT_EQ(pool.getSlabCount(), 1);
+
+    pool.allocate();
+    EXPECT_EQ(pool.getSlabCount(), 2);
+    EXPECT_EQ(pool.getCapacity(), NODE_POOL_FIRST_SLAB * 3);
+}
+
+TEST(NodePoolTest, ReleasedSlotsAreReusedFirst)
+{
+    NodePool<PoolItem> pool;
+    void *a = pool.allocate();
+    void *b = pool.allocate();
+    pool.allocate();
+
+    pool.release(a);
+    pool.release(b);
+    EXPECT_EQ(pool.allocate(), b);
+    EXPECT_EQ(pool.allocate(), a);
+    pool.release(nullptr);
+}
+
+TEST(NodePoolTest, ResetKeepsSlabsForReuse)
+{
+    NodePool<PoolItem> pool;
+    std::set<void *> slots;
+    for (int i = 0; i < 100; i++)
+    {
+        slots.insert(pool.allocate());
+    }
+    int slabs = pool.getSlabCount();
+
+    pool.reset();
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_TRUE(slots.count(pool.allocate()));
+    }
+    EXPECT_EQ(pool.getSlabCount(), slabs);
+}
+
+TEST(NodePoolTest, SwapExchangesSlabs)
+{
+    NodePool<PoolItem> left;
+    NodePool<PoolItem> right;
+    void *slot = left.allocate();
+
+    left.swap(right);
+    EXPECT_EQ(left.getSlabCount(), 0);
+    EXPECT_EQ(right.getSlabCount(), 1);
+    right.release(slot);
+    EXPECT_EQ(right.allocate(), slot);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "../inc/parallel.hpp"
+#include <stdexcept>
+#include <vector>
+
+TEST(ParallelTest, PartCountFollowsTheItemsPerThread)
+{
+    EXPECT_EQ(parallelPartCount(0, 4), 1);
+    EXPECT_EQ(parallelPartCount(PARALLEL_MIN_ITEMS_PER_THREAD * 2 - 1, 4), 1);
+    EXPECT_EQ(parallelPartCount(PARALLEL_MIN_ITEMS_PER_THREAD * 3, 4), 3);
+    EXPECT_EQ(parallelPartCount(PARALLEL_MIN_ITEMS_PER_THREAD * 100, 4), 4);
+    EXPECT_EQ(parallelPartCount(100, 8, 10), 8);
+    EXPECT_THROW(parallelPartCount(100, 0), std::invalid_argument);
+}
+
+TEST(ParallelTest, RangesCoverTheItemsInOrder)
+{
+    for (int parts = 1; parts <= 5; parts++)
+    {
+        std::vector<int> starts(parts, -1);
+        std::vector<int> ends(parts, -1);
+        parallelRanges(103, parts, [&](const int part, const int start, const int end)
+                       {
+            starts[part] = start;
+            ends[part] = end; });
+
+        EXPECT_EQ(starts[0], 0);
+        EXPECT_EQ(ends[parts - 1], 103);
+        for (int part = 1; part < parts; part++)
+        {
+            EXPECT_EQ(starts[part], ends[part - 1]);
+            EXPECT_LE(ends[part] - starts[part] - (ends[0] - starts[0]), 1);
+        }
+    }
+}
+
+TEST(ParallelTest, RethrowsTheErrorOfTheLowestPart)
+{
+    auto failing = [](const int part, const int, const int)
+    {
+        if (part == 1)
+        {
+            throw std::out_of_range("part 1");
+        }
+        if (part == 3)
+        {
+            throw std::runtime_error("part 3");
+        }
+    };
+    EXPECT_THROW(parallelRanges(100, 4, failing), std::out_of_range);
+    EXPECT_THROW(parallelRanges(100, 1, [](const int, const int, const int)
+                                { throw std::runtime_error("only part"); }),
+                 std::runtime_error);
+}
@@ -1,8 +1,18 @@
 #include <gtest/gtest.h>
 #include "../inc/segmentedDeque.hpp"
+#include "../inc/arraySequence.hpp"
+#include "../inc/listSequence.hpp"
 #include "../types/complex.hpp"
 #include "../types/person.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <sstream>
+#include <string>
+#include <vector>
 
 class SegmentedDequeTest : public ::testing::Test
 {
@@ -431,4 +441,1273 @@ TEST(SegmentedDequeConstIteratorTest, ConstIteratorFunctionsWork)
     
     it = constDeque.cend();
     EXPECT_FALSE(it.notEnd());
-}
\ No newline at end of file
+}
+
+TEST(SegmentedDequeSerializationTest, SaveLoadRoundTripsInts)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 10; i++)
+    {
+        deque.append(i);
+    }
+
+    std::stringstream stream;
+    deque.save(stream);
+
+    SegmentedDeque<int> *loaded = SegmentedDeque<int>::load(stream);
+    EXPECT_EQ(loaded->getLength(), 10);
+    EXPECT_EQ(loaded->getSegmentSize(), 4);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(loaded->get(i), i);
+    }
+    delete loaded;
+}
+
+TEST(SegmentedDequeSerializationTest, RawPayloadIsPaddedPerSegment)
+{
+    SegmentedDeque<int> deque(3);
+    for (int i = 0; i < 5; i++)
+    {
+        deque.append(i);
+    }
+
+    std::stringstream stream;
+    deque.save(stream);
+
+    // header + two segment headers + 3 ints padded to 16 bytes + 2 ints
+    EXPECT_EQ(stream.str().size(), sizeof(DequeFileHeader) + 2 * sizeof(DequeSegmentHeader) + 16 + 8);
+}
+
+TEST(SegmentedDequeSerializationTest, SaveLoadRoundTripsComplexAndPerson)
+{
+    SegmentedDeque<Complex> complexDeque(2);
+    complexDeque.append(Complex(1, 2));
+    complexDeque.append(Complex(3, -4));
+    complexDeque.prepend(Complex(0, 1));
+
+    std::stringstream complexStream;
+    complexDeque.save(complexStream);
+    SegmentedDeque<Complex> *loadedComplex = SegmentedDeque<Complex>::load(complexStream);
+    EXPECT_EQ(loadedComplex->getLength(), 3);
+    EXPECT_EQ(loadedComplex->get(0), Complex(0, 1));
+    EXPECT_EQ(loadedComplex->get(2), Complex(3, -4));
+    delete loadedComplex;
+
+    SegmentedDeque<Person> personDeque(2);
+    personDeque.append(Person("Alice", 30));
+    personDeque.append(Person("", 0));
+    personDeque.append(Person("Charlie", 35));
+
+    std::stringstream personStream;
+    personDeque.save(personStream);
+    SegmentedDeque<Person> *loadedPerson = SegmentedDeque<Person>::load(personStream);
+    EXPECT_EQ(loadedPerson->getLength(), 3);
+    EXPECT_EQ(loadedPerson->get(0), Person("Alice", 30));
+    EXPECT_EQ(loadedPerson->get(1), Person("", 0));
+    EXPECT_EQ(loadedPerson->get(2), Person("Charlie", 35));
+    delete loadedPerson;
+}
+
+TEST(SegmentedDequeSerializationTest, LoadRejectsInvalidStreams)
+{
+    std::stringstream garbage("not a deque at all, definitely not");
+    EXPECT_THROW(SegmentedDeque<int>::load(garbage), std::runtime_error);
+
+    SegmentedDeque<int> deque(2);
+    deque.append(1);
+    deque.append(2);
+    deque.append(3);
+
+    std::stringstream stream;
+    deque.save(stream);
+    std::string bytes = stream.str();
+
+    std::stringstream wrongType(bytes);
+    EXPECT_THROW(SegmentedDeque<double>::load(wrongType), std::runtime_error);
+
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 4));
+    EXPECT_THROW(SegmentedDeque<int>::load(truncated), std::runtime_error);
+}
+
+TEST(SegmentedDequeSerializationTest, LoadRejectsCorruptedNameLengths)
+{
+    SegmentedDeque<Person> deque(2);
+    deque.append(Person("Alice", 30));
+
+    std::stringstream stream;
+    deque.save(stream);
+    std::string bytes = stream.str();
+
+    std::string corrupted = bytes;
+    size_t lengthOffset = sizeof(DequeFileHeader) + sizeof(DequeSegmentHeader);
+    uint32_t hugeLength = 0xFFFFFFF0u;
+    std::memcpy(&corrupted[lengthOffset], &hugeLength, sizeof(hugeLength));
+    std::stringstream corruptedStream(corrupted);
+    EXPECT_THROW(SegmentedDeque<Person>::load(corruptedStream), std::runtime_error);
+
+    std::stringstream truncated(bytes.substr(0, lengthOffset + 2));
+    EXPECT_THROW(SegmentedDeque<Person>::load(truncated), std::runtime_error);
+}
+
+TEST(SegmentedDequeSerializationTest, LoadRejectsCorruptedSegmentHeaders)
+{
+    SegmentedDeque<int> deque(2);
+    deque.append(1);
+    deque.append(2);
+    deque.append(3);
+
+    std::stringstream stream;
+    deque.save(stream);
+    std::string bytes = stream.str();
+
+    // The first segment header follows the file header.
+    auto withFirstLength = [&bytes](const uint32_t length)
+    {
+        std::string corrupted = bytes;
+        std::memcpy(&corrupted[sizeof(DequeFileHeader)], &length, sizeof(length));
+        return corrupted;
+    };
+    auto withSegmentSize = [&bytes](const uint32_t segmentSize)
+    {
+        std::string corrupted = bytes;
+        std::memcpy(&corrupted[offsetof(DequeFileHeader, segmentSize)], &segmentSize, sizeof(segmentSize));
+        return corrupted;
+    };
+
+    std::stringstream emptySegment(withFirstLength(0));
+    EXPECT_THROW(SegmentedDeque<int>::load(emptySegment), std::runtime_error);
+    std::stringstream oversizedSegment(withFirstLength(3));
+    EXPECT_THROW(SegmentedDeque<int>::load(oversizedSegment), std::runtime_error);
+    std::stringstream hugeSegment(withFirstLength(0xffffffffu));
+    EXPECT_THROW(SegmentedDeque<int>::load(hugeSegment), std::runtime_error);
+    std::stringstream zeroSegmentSize(withSegmentSize(0));
+    EXPECT_THROW(SegmentedDeque<int>::load(zeroSegmentSize), std::runtime_error);
+    std::stringstream hugeSegmentSize(withSegmentSize(0xffffffffu));
+    EXPECT_THROW(SegmentedDeque<int>::load(hugeSegmentSize), std::runtime_error);
+}
+
+TEST(SegmentedDequeIndexTest, MixedInsertionsKeepIndexingCorrect)
+{
+    SegmentedDeque<int> deque(4);
+    std::vector<int> expected;
+
+    for (int i = 0; i < 50; i++)
+    {
+        if (i % 3 == 0)
+        {
+            deque.prepend(i);
+            expected.insert(expected.begin(), i);
+        }
+        else if (i % 3 == 1)
+        {
+            deque.append(i);
+            expected.push_back(i);
+        }
+        else
+        {
+            int index = (i * 7) % (static_cast<int>(expected.size()) + 1);
+            deque.insertAt(i, index);
+            expected.insert(expected.begin() + index, i);
+        }
+    }
+
+    ASSERT_EQ(deque.getLength(), static_cast<int>(expected.size()));
+    for (int i = 0; i < deque.getLength(); i++)
+    {
+        EXPECT_EQ(deque.get(i), expected[i]);
+    }
+
+    for (int i = 0; i < deque.getLength(); i += 5)
+    {
+        deque.set(i, -i);
+        expected[i] = -i;
+    }
+    for (int i = 0; i < deque.getLength(); i++)
+    {
+        EXPECT_EQ(deque.get(i), expected[i]);
+    }
+}
+
+TEST(SegmentedDequeIndexTest, RebalancePacksSegmentsInOrder)
+{
+    SegmentedDeque<int> deque(3);
+    for (int i = 4; i >= 0; i--)
+    {
+        deque.prepend(i);
+    }
+    deque.insertAt(100, 2);
+
+    deque.rebalanceSegments();
+
+    int expected[] = {0, 1, 100, 2, 3, 4};
+    ASSERT_EQ(deque.getLength(), 6);
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(deque.get(i), expected[i]);
+    }
+    EXPECT_EQ(deque.getFirst(), 0);
+    EXPECT_EQ(deque.getLast(), 4);
+}
+
+TEST(SegmentedDequeBulkTest, ConstructFromArrayFillsWholeSegments)
+{
+    int items[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    SegmentedDeque<int> deque(items, 10, 4);
+
+    EXPECT_EQ(deque.getLength(), 10);
+    EXPECT_EQ(deque.getSegmentSize(), 4);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(deque.get(i), i);
+    }
+}
+
+TEST(SegmentedDequeBulkTest, AppendRangeContinuesPartialSegment)
+{
+    SegmentedDeque<int> deque(4);
+    deque.append(-1);
+    deque.reserve(20);
+
+    int items[] = {0, 1, 2, 3, 4, 5};
+    deque.appendRange(items, 6);
+
+    std::vector<int> more = {6, 7, 8};
+    deque.appendRange(more.begin(), more.end());
+
+    EXPECT_EQ(deque.getLength(), 10);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(deque.get(i), i - 1);
+    }
+    deque.insertAt(100, 5);
+    EXPECT_EQ(deque.get(5), 100);
+    EXPECT_EQ(deque.get(6), 4);
+}
+
+TEST(SegmentedDequeBulkTest, AssignAndClear)
+{
+    SegmentedDeque<Person> deque(2);
+    deque.append(Person("Old", 99));
+
+    std::vector<Person> people = {Person("Alice", 30), Person("Bob", 25), Person("Charlie", 35)};
+    deque.assign(people.begin(), people.end());
+    EXPECT_EQ(deque.getLength(), 3);
+    EXPECT_EQ(deque.getFirst(), Person("Alice", 30));
+    EXPECT_EQ(deque.getLast(), Person("Charlie", 35));
+
+    SegmentedDeque<Person> copy(2);
+    copy.assign(deque.cbegin(), deque.cend());
+    EXPECT_EQ(copy.get(1), Person("Bob", 25));
+
+    deque.clear();
+    EXPECT_EQ(deque.getLength(), 0);
+    EXPECT_THROW(deque.getFirst(), std::out_of_range);
+    deque.append(Person("New", 1));
+    EXPECT_EQ(deque.get(0), Person("New", 1));
+}
+
+TEST(SegmentedDequeSpliceTest, SpliceMovesSegmentsAndEmptiesSource)
+{
+    SegmentedDeque<int> deque(4);
+    SegmentedDeque<int> other(4);
+    for (int i = 0; i < 6; i++)
+    {
+        deque.append(i);
+    }
+    for (int i = 6; i < 15; i++)
+    {
+        other.append(i);
+    }
+
+    deque.splice(other);
+
+    EXPECT_EQ(other.getLength(), 0);
+    EXPECT_THROW(other.getFirst(), std::out_of_range);
+    ASSERT_EQ(deque.getLength(), 15);
+    for (int i = 0; i < 15; i++)
+    {
+        EXPECT_EQ(deque.get(i), i);
+    }
+
+    other.append(100);
+    EXPECT_EQ(other.getLength(), 1);
+    EXPECT_EQ(other.get(0), 100);
+
+    EXPECT_THROW(deque.splice(deque), std::invalid_argument);
+}
+
+TEST(SegmentedDequeSpliceTest, RvalueConcatMergesSmallBoundarySegments)
+{
+    SegmentedDeque<int> deque(4);
+    deque.append(0);
+
+    SegmentedDeque<int> other(4);
+    other.append(1);
+    other.append(2);
+    other.prepend(-5);
+
+    deque.concat(std::move(other));
+
+    int expected[] = {0, -5, 1, 2};
+    ASSERT_EQ(deque.getLength(), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(deque.get(i), expected[i]);
+    }
+    deque.append(3);
+    EXPECT_EQ(deque.getLast(), 3);
+}
+
+TEST(SegmentedDequeSpliceTest, SplitAtHandsOverTheBackHalf)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 11; i++)
+    {
+        deque.append(i);
+    }
+
+    SegmentedDeque<int> *back = deque.splitAt(6);
+    ASSERT_EQ(deque.getLength(), 6);
+    ASSERT_EQ(back->getLength(), 5);
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(deque.get(i), i);
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(back->get(i), i + 6);
+    }
+    EXPECT_EQ(deque.getLast(), 5);
+    EXPECT_EQ(back->getSegmentSize(), 4);
+
+    SegmentedDeque<int> *onBoundary = deque.splitAt(4);
+    EXPECT_EQ(deque.getLength(), 4);
+    EXPECT_EQ(onBoundary->getFirst(), 4);
+    delete onBoundary;
+
+    SegmentedDeque<int> *empty = deque.splitAt(4);
+    EXPECT_EQ(empty->getLength(), 0);
+    delete empty;
+
+    SegmentedDeque<int> *everything = deque.splitAt(0);
+    EXPECT_EQ(deque.getLength(), 0);
+    EXPECT_EQ(everything->getLength(), 4);
+    delete everything;
+
+    EXPECT_THROW(back->splitAt(6), std::out_of_range);
+    delete back;
+}
+
+TEST(SegmentedDequeAccessTest, CheckedAndUncheckedAccessAgree)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 10; i++)
+    {
+        deque.append(i);
+    }
+    deque.prepend(-1);
+
+    for (int i = 0; i < deque.getLength(); i++)
+    {
+        EXPECT_EQ(deque.at(i), i - 1);
+        EXPECT_EQ(deque.unsafeGet(i), i - 1);
+        EXPECT_EQ(deque[i], i - 1);
+    }
+
+    deque[3] = 30;
+    EXPECT_EQ(deque.get(3), 30);
+    EXPECT_THROW(deque.at(11), std::out_of_range);
+#if SEQUENCE_BOUNDS_CHECK
+    EXPECT_THROW(deque[-1], std::out_of_range);
+#endif
+}
+
+TEST(SegmentedDequeInlineTest, SplicingMovesInlineSegmentsByCopy)
+{
+    SegmentedDeque<int> left(4);
+    SegmentedDeque<int> right(4);
+    for (int i = 0; i < 3; i++)
+    {
+        left.append(i);
+    }
+    for (int i = 3; i < 12; i++)
+    {
+        right.append(i);
+    }
+
+    left.splice(right);
+    EXPECT_EQ(right.getLength(), 0);
+    ASSERT_EQ(left.getLength(), 12);
+    for (int i = 0; i < 12; i++)
+    {
+        EXPECT_EQ(left.get(i), i);
+    }
+
+    right.append(100);
+    EXPECT_EQ(right.getFirst(), 100);
+
+    SegmentedDeque<int> *back = left.splitAt(1);
+    EXPECT_EQ(left.getLength(), 1);
+    EXPECT_EQ(back->getLength(), 11);
+    EXPECT_EQ(back->getFirst(), 1);
+    EXPECT_EQ(back->getLast(), 11);
+    left.append(-1);
+    EXPECT_EQ(left.getLast(), -1);
+    delete back;
+}
+
+TEST(SegmentedDequeInlineTest, CopyAssignAndRebalanceKeepItems)
+{
+    SegmentedDeque<int> deque(3);
+    for (int i = 0; i < 7; i++)
+    {
+        deque.prepend(i);
+    }
+    deque.insertAt(42, 2);
+    deque.rebalanceSegments();
+
+    SegmentedDeque<int> copy(deque);
+    SegmentedDeque<int> assigned;
+    assigned.append(5);
+    assigned = copy;
+
+    ASSERT_EQ(assigned.getLength(), 8);
+    EXPECT_EQ(assigned.getSegmentSize(), 3);
+    EXPECT_EQ(assigned.get(0), 6);
+    EXPECT_EQ(assigned.get(2), 42);
+    EXPECT_EQ(assigned.getLast(), 0);
+
+    copy.clear();
+    EXPECT_EQ(assigned.get(2), 42);
+    EXPECT_EQ(deque.get(2), 42);
+}
+
+TEST(SegmentedDequeInlineTest, SmallDequesPrependAndInsertInPlace)
+{
+    for (int items = 1; items <= 8; items++)
+    {
+        SegmentedDeque<int> prepended(2);
+        SegmentedDeque<int> inserted(2);
+        std::vector<int> reference;
+        for (int i = 0; i < items; i++)
+        {
+            prepended.prepend(i);
+            int middle = inserted.getLength() / 2;
+            inserted.insertAt(i, middle);
+            reference.insert(reference.begin() + middle, i);
+        }
+
+        ASSERT_EQ(prepended.getLength(), items);
+        ASSERT_EQ(inserted.getLength(), items);
+        for (int i = 0; i < items; i++)
+        {
+            EXPECT_EQ(prepended.get(i), items - 1 - i);
+            EXPECT_EQ(inserted.get(i), reference[i]);
+        }
+    }
+}
+
+TEST(SegmentedDequeBlockTest, VisitBlocksWalksSegmentChunks)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 10; i++)
+    {
+        deque.append(i);
+    }
+
+    int blocks = 0;
+    std::vector<int> seen;
+    auto visitor = makeBlockVisitor<int>([&](const int *items, const int count)
+                                         {
+        blocks++;
+        seen.insert(seen.end(), items, items + count); });
+    deque.visitBlocks(2, 7, visitor);
+
+    EXPECT_EQ(blocks, 3);
+    EXPECT_EQ(seen, std::vector<int>({2, 3, 4, 5, 6, 7, 8}));
+    EXPECT_THROW(deque.visitBlocks(5, 6, visitor), std::out_of_range);
+}
+
+TEST(SegmentedDequeBlockTest, ConcatAndSubsequenceCopyByBlocks)
+{
+    int items[] = {1, 2, 3, 4, 5, 6, 7};
+    ArraySequence<int> array(items, 7);
+    ListSequence<int> list(items, 7);
+    UnrolledListSequence<int> unrolled(items, 7);
+
+    SegmentedDeque<int> deque(3);
+    deque.append(0);
+    deque.concat(&array);
+    deque.concat(&list);
+    deque.concat(&unrolled);
+    deque.concat(&deque);
+
+    ASSERT_EQ(deque.getLength(), 44);
+    for (int i = 0; i < 44; i++)
+    {
+        int local = i % 22;
+        EXPECT_EQ(deque.get(i), local == 0 ? 0 : (local - 1) % 7 + 1);
+    }
+
+    Sequence<int> *sub = deque.getSubsequence(20, 25);
+    ASSERT_EQ(sub->getLength(), 6);
+    EXPECT_EQ(sub->get(0), 6);
+    EXPECT_EQ(sub->get(2), 0);
+    EXPECT_EQ(sub->get(5), 3);
+    delete sub;
+}
+
+TEST(SegmentedDequeViewTest, SliceSharesStorage)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 20; i++)
+    {
+        deque.append(i);
+    }
+
+    DequeSlice<int> slice = deque.slice(3, 14);
+    ASSERT_EQ(slice.getLength(), 12);
+    EXPECT_EQ(slice.get(0), 3);
+    EXPECT_EQ(slice.slice(2, 4).get(2), 7);
+    EXPECT_EQ(slice.reduce([](int acc, int x)
+                           { return acc + x; },
+                           0),
+              (3 + 14) * 12 / 2);
+
+    deque.set(5, 100);
+    EXPECT_EQ(slice.get(2), 100);
+
+    std::vector<int> seen(slice.begin(), slice.end());
+    EXPECT_EQ(seen.size(), 12u);
+    EXPECT_EQ(seen[2], 100);
+
+    EXPECT_THROW(deque.slice(5, 20), std::out_of_range);
+    EXPECT_THROW(slice.get(12), std::out_of_range);
+    EXPECT_EQ(SegmentedDeque<int>().view().count(), 0);
+}
+
+TEST(SegmentedDequeViewTest, FilterMapChainsMatchEagerWhere)
+{
+    SegmentedDeque<int> deque(5);
+    for (int i = 0; i < 50; i++)
+    {
+        deque.append(i);
+    }
+
+    auto isOdd = [](int x)
+    { return x % 2 != 0; };
+    auto square = [](int x)
+    { return static_cast<long long>(x) * x; };
+
+    auto chain = deque.filterView(isOdd).mapView(square);
+    long long expected = 0;
+    for (int i = 1; i < 50; i += 2)
+    {
+        expected += static_cast<long long>(i) * i;
+    }
+    EXPECT_EQ(chain.reduce([](long long acc, long long x)
+                           { return acc + x; },
+                           0LL),
+              expected);
+    EXPECT_EQ(chain.count(), 25);
+
+    std::vector<long long> iterated;
+    for (long long value : chain)
+    {
+        iterated.push_back(value);
+    }
+    ASSERT_EQ(iterated.size(), 25u);
+    EXPECT_EQ(iterated[3], 49);
+
+    SegmentedDeque<int> *eager = deque.where(isOdd);
+    SegmentedDeque<int> *lazy = deque.filterView(isOdd).toDeque();
+    ASSERT_EQ(lazy->getLength(), eager->getLength());
+    for (int i = 0; i < eager->getLength(); i++)
+    {
+        EXPECT_EQ(lazy->get(i), eager->get(i));
+    }
+    delete eager;
+    delete lazy;
+
+    SegmentedDeque<long long> *mapped = deque.slice(10, 19).mapView(square).filterView([](long long x)
+                                                                                       { return x > 200; })
+                                            .toDeque(4);
+    ASSERT_EQ(mapped->getLength(), 5);
+    EXPECT_EQ(mapped->getFirst(), 225);
+    EXPECT_EQ(mapped->getSegmentSize(), 4);
+    delete mapped;
+}
+
+TEST(SegmentedDequeViewTest, ZipStopsAtShorterSide)
+{
+    SegmentedDeque<int> numbers(3);
+    SegmentedDeque<char> letters(3);
+    for (int i = 0; i < 10; i++)
+    {
+        numbers.append(i);
+    }
+    for (char c = 'a'; c < 'a' + 7; c++)
+    {
+        letters.append(c);
+    }
+
+    auto zipped = numbers.zipView(letters);
+    EXPECT_EQ(zipped.count(), 7);
+
+    std::vector<std::pair<int, char>> pairs(zipped.begin(), zipped.end());
+    ASSERT_EQ(pairs.size(), 7u);
+    EXPECT_EQ(pairs[6], std::make_pair(6, 'g'));
+
+    auto it = zipped.begin();
+    auto same = zipped.begin();
+    EXPECT_TRUE(it == same);
+    ++same;
+    EXPECT_FALSE(it == same);
+    EXPECT_TRUE(it != same);
+    std::advance(it, 7);
+    EXPECT_TRUE(it == zipped.end());
+    EXPECT_FALSE(same == zipped.end());
+
+    SegmentedDeque<char> none;
+    auto empty = numbers.zipView(none);
+    EXPECT_TRUE(empty.begin() == empty.end());
+
+    auto evens = numbers.filterView([](int x)
+                                    { return x % 2 == 0; });
+    int dot = numbers.view().zipView(evens).reduce([](int acc, const std::pair<int, int> &p)
+                                                   { return acc + p.first * p.second; },
+                                                   0);
+    EXPECT_EQ(dot, 0 * 0 + 1 * 2 + 2 * 4 + 3 * 6 + 4 * 8);
+
+    SegmentedDeque<int> *codes = zipped.mapView([](const std::pair<int, char> &p)
+                                                { return p.first + p.second; })
+                                     .toDeque();
+    EXPECT_EQ(codes->getLength(), 7);
+    EXPECT_EQ(codes->getLast(), 6 + 'g');
+    delete codes;
+}
+
+TEST(SegmentedDequeIteratorTest, IteratorsStepAcrossSegments)
+{
+    SegmentedDeque<int> deque(3);
+    for (int i = 0; i < 10; i++)
+    {
+        deque.prepend(i);
+    }
+    deque.insertAt(100, 4);
+
+    std::vector<int> expected;
+    for (int i = 0; i < deque.getLength(); i++)
+    {
+        expected.push_back(deque.get(i));
+    }
+
+    std::vector<int> seen;
+    for (auto it = deque.begin(); it != deque.end(); ++it)
+    {
+        seen.push_back(*it);
+        *it += 1;
+    }
+    EXPECT_EQ(seen, expected);
+
+    auto it = deque.cbegin();
+    for (int i = 0; i < 4; i++)
+    {
+        ++it;
+    }
+    EXPECT_EQ(*it, 101);
+    EXPECT_THROW(*deque.cend(), std::runtime_error);
+}
+
+TEST(SegmentedDequePipelineTest, FusedStagesMatchWhereAndReduce)
+{
+    SegmentedDeque<int> deque(7);
+    for (int i = 0; i < 100; i++)
+    {
+        deque.append(i);
+    }
+
+    auto isMultipleOfThree = [](int x)
+    { return x % 3 == 0; };
+    auto half = [](int x)
+    { return x / 2.0; };
+    auto sum = [](double acc, double x)
+    { return acc + x; };
+
+    SegmentedDeque<int> *filtered = deque.where(isMultipleOfThree);
+    double expected = filtered->reduce([&](double acc, int x)
+                                       { return acc + half(x); },
+                                       0.0);
+    delete filtered;
+
+    auto pipeline = deque.pipeline().filter(isMultipleOfThree).map(half);
+    EXPECT_DOUBLE_EQ(pipeline.reduce(sum, 0.0), expected);
+    EXPECT_EQ(pipeline.count(), 34);
+    EXPECT_EQ(deque.pipeline().count(), 100);
+
+    std::vector<double> seen;
+    pipeline.filter([](double x)
+                    { return x > 40; })
+        .forEach([&seen](double x)
+                 { seen.push_back(x); });
+    EXPECT_EQ(seen, std::vector<double>({40.5, 42, 43.5, 45, 46.5, 48, 49.5}));
+
+    SegmentedDeque<int> empty;
+    EXPECT_EQ(empty.pipeline().map(half).reduce(sum, 1.5), 1.5);
+}
+
+TEST(SegmentedDequePipelineTest, ParallelReduceCombinesPartialsInOrder)
+{
+    SegmentedDeque<int> deque(64);
+    const int count = 4 * PARALLEL_MIN_ITEMS_PER_THREAD + 17;
+    for (int i = 0; i < count; i++)
+    {
+        deque.append(i % 1000);
+    }
+
+    auto pipeline = deque.pipeline()
+                        .filter([](int x)
+                                { return x % 2 == 1; })
+                        .map([](int x)
+                             { return static_cast<long long>(x) * x; });
+    auto add = [](long long a, long long b)
+    { return a + b; };
+
+    long long sequential = pipeline.reduce(add, 0LL);
+    EXPECT_EQ(pipeline.reduce(add, add, 0LL, 4), sequential);
+    EXPECT_EQ(pipeline.reduce(add, add, 0LL, 64), sequential);
+    EXPECT_EQ(pipeline.reduce(add, add, 0LL, 1), sequential);
+
+    // Order is preserved, so a non-commutative combine still works.
+    auto concatDigits = [](std::string acc, int x)
+    { return acc + static_cast<char>('0' + x % 10); };
+    auto join = [](const std::string &a, const std::string &b)
+    { return a + b; };
+    auto digits = deque.pipeline().filter([](int x)
+                                          { return x < 3; });
+    EXPECT_EQ(digits.reduce(concatDigits, join, std::string(), 4), digits.reduce(concatDigits, std::string()));
+
+    EXPECT_THROW(pipeline.reduce(add, add, 0LL, 0), std::invalid_argument);
+    EXPECT_THROW(deque.pipeline().map([](int x)
+                                      {
+        if (x == 999) throw std::runtime_error("bad item");
+        return x; })
+                     .reduce(add, add, 0LL, 4),
+                 std::runtime_error);
+}
+
+TEST(SegmentedDequePipelineTest, ParallelReduceToBool)
+{
+    SegmentedDeque<int> deque(64);
+    const int count = 8 * PARALLEL_MIN_ITEMS_PER_THREAD;
+    for (int i = 0; i < count; i++)
+    {
+        deque.append(i);
+    }
+
+    auto any = [](bool acc, bool x)
+    { return acc || x; };
+    auto isLast = deque.pipeline().map([count](int x)
+                                       { return x == count - 1; });
+    auto isNegative = deque.pipeline().map([](int x)
+                                           { return x < 0; });
+    for (int round = 0; round < 20; round++)
+    {
+        EXPECT_TRUE(isLast.reduce(any, any, false, 8));
+        EXPECT_FALSE(isNegative.reduce(any, any, false, 8));
+    }
+}
+
+TEST(SegmentedDequeSortTest, SortByKeyComputesEachKeyOnce)
+{
+    SegmentedDeque<Complex> deque(3);
+    deque.append(Complex(3, 4));
+    deque.append(Complex(1, 0));
+    deque.append(Complex(0, 2));
+    deque.append(Complex(-5, 0));
+    deque.append(Complex(0, 1));
+    deque.append(Complex(2, 0));
+    deque.prepend(Complex(6, 8));
+
+    int keyCalls = 0;
+    deque.sortByKey([&keyCalls](const Complex &c)
+                    {
+        keyCalls++;
+        return c.magnitude(); });
+
+    EXPECT_EQ(keyCalls, 7);
+    ASSERT_EQ(deque.getLength(), 7);
+    std::vector<double> magnitudes;
+    for (const Complex &c : deque)
+    {
+        magnitudes.push_back(c.magnitude());
+    }
+    EXPECT_TRUE(std::is_sorted(magnitudes.begin(), magnitudes.end()));
+    // Equal keys keep their order: (1, 0) came before (0, 1), and (0, 2) before (2, 0).
+    EXPECT_EQ(deque.get(0), Complex(1, 0));
+    EXPECT_EQ(deque.get(1), Complex(0, 1));
+    EXPECT_EQ(deque.get(2), Complex(0, 2));
+    EXPECT_EQ(deque.get(3), Complex(2, 0));
+    EXPECT_EQ(deque.getLast(), Complex(6, 8));
+}
+
+TEST(SegmentedDequeSortTest, SortByKeyWithComparatorAndImmutableCopy)
+{
+    SegmentedDeque<Person> people(2);
+    people.append(Person("Mia", 40));
+    people.append(Person("Al", 30));
+    people.append(Person("Zoe", 20));
+    people.append(Person("Bea", 30));
+
+    SegmentedDeque<Person> *byName = people.sortByKeyImmutable([](const Person &p)
+                                                               { return p.getName(); });
+    EXPECT_EQ(byName->get(0).getName(), "Al");
+    EXPECT_EQ(byName->getLast().getName(), "Zoe");
+    EXPECT_EQ(people.getFirst().getName(), "Mia");
+    delete byName;
+
+    people.sortByKey([](const Person &p)
+                     { return p.getAge(); },
+                     std::greater<int>());
+    EXPECT_EQ(people.get(0).getName(), "Mia");
+    EXPECT_EQ(people.get(1).getName(), "Al");
+    EXPECT_EQ(people.get(2).getName(), "Bea");
+    EXPECT_EQ(people.get(3).getName(), "Zoe");
+    EXPECT_EQ(people.getSegmentSize(), 2);
+
+    people.append(Person("Ed", 50));
+    EXPECT_EQ(people.getLength(), 5);
+}
+
+TEST(SegmentedDequeSortTest, IsSortedChecksAcrossSegments)
+{
+    SegmentedDeque<int> deque(3);
+    EXPECT_TRUE(deque.isSorted());
+    for (int i = 0; i < 10; i++)
+    {
+        deque.append(i);
+    }
+    EXPECT_TRUE(deque.isSorted());
+    EXPECT_FALSE(deque.isSorted(std::greater<int>()));
+
+    deque.set(3, 1);
+    EXPECT_FALSE(deque.isSorted());
+    deque.set(3, 2);
+    EXPECT_TRUE(deque.isSorted());
+}
+
+TEST(SegmentedDequeSortTest, SortIsStableAndAdaptive)
+{
+    SegmentedDeque<Person> people(4);
+    const char *names[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    for (int i = 0; i < 10; i++)
+    {
+        people.append(Person(names[i], (i * 7) % 3));
+    }
+    people.sort(people.begin(), people.end());
+    std::string order;
+    for (const Person &p : people)
+    {
+        order += p.getName();
+    }
+    EXPECT_EQ(order, "adgjbehcfi");
+
+    SegmentedDeque<int> deque(16);
+    for (int i = 0; i < 5000; i++)
+    {
+        deque.append(i % 1000 == 999 ? i - 500 : i);
+    }
+    int comparisons = 0;
+    auto counting = [&comparisons](int a, int b)
+    {
+        comparisons++;
+        return a < b;
+    };
+    deque.sort(deque.begin(), deque.end(), counting);
+    EXPECT_TRUE(deque.isSorted());
+    EXPECT_LT(comparisons, 3 * 5000);
+
+    comparisons = 0;
+    deque.sort(deque.begin(), deque.end(), counting);
+    EXPECT_EQ(comparisons, 4999);
+}
+
+TEST(SegmentedDequeSortTest, SortTouchesOnlyTheGivenRange)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 20; i++)
+    {
+        deque.append(19 - i);
+    }
+
+    deque.sort(deque.begin() + 3, deque.begin() + 14);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(deque[i], 19 - i);
+    }
+    for (int i = 3; i < 14; i++)
+    {
+        EXPECT_EQ(deque[i], i - 3 + 6);
+    }
+    for (int i = 14; i < 20; i++)
+    {
+        EXPECT_EQ(deque[i], 19 - i);
+    }
+
+    SegmentedDeque<int> *sorted = deque.sortImmutable(deque.begin(), deque.begin() + 3);
+    EXPECT_EQ((*sorted)[0], 17);
+    EXPECT_EQ((*sorted)[2], 19);
+    EXPECT_EQ((*sorted)[3], 6);
+    EXPECT_EQ(deque[0], 19);
+    delete sorted;
+
+    EXPECT_THROW(deque.sort(deque.begin() + 5, deque.begin() + 2), std::out_of_range);
+    EXPECT_THROW(deque.sort(deque.begin(), deque.end() + 1), std::out_of_range);
+}
+
+TEST(SegmentedDequeIteratorTest, RandomAccessAcrossSegments)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 30; i++)
+    {
+        deque.append(i);
+    }
+    deque.prepend(-1);
+
+    auto it = deque.begin() + 10;
+    EXPECT_EQ(*it, 9);
+    EXPECT_EQ(it[5], 14);
+    EXPECT_EQ(*(it - 10), -1);
+    it += 20;
+    EXPECT_EQ(*it, 29);
+    EXPECT_EQ(*--it, 28);
+    EXPECT_EQ(deque.end() - it, 2);
+    EXPECT_TRUE(deque.begin() < it && it <= deque.end() - 2 && deque.end() > it);
+
+    auto cit = deque.cend();
+    EXPECT_EQ(*(cit - 1), 29);
+    EXPECT_EQ(cit - deque.cbegin(), 31);
+    EXPECT_EQ(deque.cbegin()[17], 16);
+
+    std::reverse(deque.begin(), deque.end());
+    EXPECT_EQ(deque.getFirst(), 29);
+    EXPECT_EQ(deque.getLast(), -1);
+}
+
+TEST(SegmentedDequeSelectionTest, NthElementAndPartialSort)
+{
+    SegmentedDeque<int> deque(7);
+    std::vector<int> reference;
+    std::srand(21);
+    for (int i = 0; i < 3000; i++)
+    {
+        int value = std::rand() % 1000;
+        deque.append(value);
+        reference.push_back(value);
+    }
+    std::sort(reference.begin(), reference.end());
+
+    deque.nthElement(1234);
+    EXPECT_EQ(deque.get(1234), reference[1234]);
+    for (int i = 0; i < 3000; i++)
+    {
+        ASSERT_TRUE(i < 1234 ? deque.get(i) <= reference[1234] : deque.get(i) >= reference[1234]);
+    }
+
+    deque.nthElement(0, std::greater<int>());
+    EXPECT_EQ(deque.getFirst(), reference.back());
+
+    deque.partialSort(100);
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(deque.get(i), reference[i]);
+    }
+    EXPECT_EQ(deque.getLength(), 3000);
+
+    EXPECT_THROW(deque.nthElement(3000), std::out_of_range);
+    EXPECT_THROW(deque.partialSort(-1), std::out_of_range);
+    deque.partialSort(3000);
+    EXPECT_TRUE(deque.isSorted());
+}
+
+TEST(SegmentedDequeSelectionTest, TopKByKey)
+{
+    SegmentedDeque<Person> people(2);
+    people.append(Person("Ann", 40));
+    people.append(Person("Bob", 25));
+    people.append(Person("Cid", 52));
+    people.append(Person("Dan", 40));
+    people.append(Person("Eve", 19));
+
+    auto age = [](const Person &p)
+    { return p.getAge(); };
+    SegmentedDeque<Person> *oldest = people.topK(3, age);
+    ASSERT_EQ(oldest->getLength(), 3);
+    EXPECT_EQ(oldest->get(0).getName(), "Cid");
+    EXPECT_EQ(oldest->get(1).getName(), "Ann");
+    EXPECT_EQ(oldest->get(2).getName(), "Dan");
+    EXPECT_EQ(oldest->getSegmentSize(), 2);
+    delete oldest;
+
+    SegmentedDeque<Person> *youngest = people.topK(10, age, std::greater<int>());
+    ASSERT_EQ(youngest->getLength(), 5);
+    EXPECT_EQ(youngest->getFirst().getName(), "Eve");
+    EXPECT_EQ(youngest->getLast().getName(), "Cid");
+    delete youngest;
+
+    SegmentedDeque<Person> *none = people.topK(0, age);
+    EXPECT_EQ(none->getLength(), 0);
+    delete none;
+    EXPECT_THROW(people.topK(-1, age), std::invalid_argument);
+}
+
+TEST(SegmentedDequeSelectionTest, ParallelTopKMatchesSerial)
+{
+    SegmentedDeque<int> deque(64);
+    for (int i = 0; i < 50000; i++)
+    {
+        deque.append(static_cast<int>((static_cast<unsigned>(i) * 2654435761u) % 5000));
+    }
+
+    auto identity = [](int x)
+    { return x; };
+    SegmentedDeque<int> *serial = deque.topK(100, identity);
+    SegmentedDeque<int> *parallel = deque.topK(100, identity, std::less<>(), 4);
+    ASSERT_EQ(serial->getLength(), 100);
+    ASSERT_EQ(parallel->getLength(), 100);
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(serial->get(i), parallel->get(i));
+    }
+    EXPECT_EQ(serial->getFirst(), 4999);
+    delete serial;
+    delete parallel;
+
+    EXPECT_THROW(deque.topK(1, identity, std::less<>(), 0), std::invalid_argument);
+    EXPECT_THROW(deque.topK(1, [](int x) -> int
+                            {
+        if (x == 4999)
+        {
+            throw std::runtime_error("bad key");
+        }
+        return x; }, std::less<>(), 4),
+                 std::runtime_error);
+}
+
+TEST(SegmentedDequeSortedTest, BoundsMatchTheStandardLibrary)
+{
+    SegmentedDeque<int> deque(5);
+    std::vector<int> reference;
+    for (int i = 0; i < 200; i++)
+    {
+        deque.append(i / 3 * 2);
+        reference.push_back(i / 3 * 2);
+    }
+    deque.prepend(-10);
+    reference.insert(reference.begin(), -10);
+
+    for (int value = -12; value < 140; value++)
+    {
+        int lower = static_cast<int>(std::lower_bound(reference.begin(), reference.end(), value) - reference.begin());
+        int upper = static_cast<int>(std::upper_bound(reference.begin(), reference.end(), value) - reference.begin());
+        ASSERT_EQ(deque.lowerBound(value), lower) << value;
+        ASSERT_EQ(deque.upperBound(value), upper) << value;
+        ASSERT_EQ(deque.equalRange(value), std::make_pair(lower, upper));
+    }
+
+    SegmentedDeque<int> empty;
+    EXPECT_EQ(empty.lowerBound(3), 0);
+    EXPECT_EQ(empty.upperBound(3), 0);
+
+    SegmentedDeque<int> descending(3);
+    for (int i = 10; i > 0; i--)
+    {
+        descending.append(i);
+    }
+    EXPECT_EQ(descending.lowerBound(4, std::greater<int>()), 6);
+}
+
+TEST(SegmentedDequeSortedTest, InsertSortedKeepsOrderAndFillsSegments)
+{
+    SegmentedDeque<Person> people(4);
+    std::srand(17);
+    std::vector<int> ages;
+    auto byAge = [](const Person &a, const Person &b)
+    { return a.getAge() < b.getAge(); };
+    for (int i = 0; i < 300; i++)
+    {
+        int age = std::rand() % 60;
+        int index = people.insertSorted(Person(std::to_string(i), age), byAge);
+        ASSERT_EQ(people.get(index).getName(), std::to_string(i));
+        ages.push_back(age);
+    }
+
+    ASSERT_EQ(people.getLength(), 300);
+    EXPECT_TRUE(people.isSorted(byAge));
+    std::sort(ages.begin(), ages.end());
+    for (int i = 0; i < 300; i++)
+    {
+        ASSERT_EQ(people.get(i).getAge(), ages[i]);
+    }
+
+    // Equal keys keep insertion order.
+    int previous = -1;
+    for (int i = 0; i < 300; i++)
+    {
+        if (people.get(i).getAge() == 30)
+        {
+            int name = std::stoi(people.get(i).getName());
+            EXPECT_LT(previous, name);
+            previous = name;
+        }
+    }
+
+    SegmentedDeque<int> ascending(4);
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(ascending.insertSorted(i), i);
+    }
+    int full = 0;
+    ascending.forEachBlock([&full](const int *, const int count)
+                           { full += count == 4; });
+    EXPECT_EQ(full, 25);
+}
+
+TEST(SegmentedDequeSortedTest, InsertSortedWithOneItemSegments)
+{
+    SegmentedDeque<std::string> deque(1);
+    deque.append("b");
+    deque.append("d");
+    EXPECT_EQ(deque.insertSorted("c"), 1);
+    EXPECT_EQ(deque.insertSorted("a"), 0);
+    EXPECT_EQ(deque.insertSorted("e"), 4);
+    EXPECT_EQ(deque.insertSorted("c"), 3);
+
+    const char *expected[] = {"a", "b", "c", "c", "d", "e"};
+    ASSERT_EQ(deque.getLength(), 6);
+    int blocks = 0;
+    deque.forEachBlock([&blocks](const std::string *, const int count)
+                       {
+        EXPECT_EQ(count, 1);
+        blocks++; });
+    EXPECT_EQ(blocks, 6);
+    for (int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(deque.get(i), expected[i]);
+    }
+}
+
+TEST(SegmentedDequeSortedTest, MergeSortedIsStableWithFullSegments)
+{
+    SegmentedDeque<Person> left(3);
+    SegmentedDeque<Person> right(7);
+    left.append(Person("a", 1));
+    left.append(Person("b", 3));
+    left.append(Person("c", 3));
+    left.append(Person("d", 9));
+    right.append(Person("w", 0));
+    right.append(Person("x", 3));
+    right.append(Person("y", 4));
+
+    auto byAge = [](const Person &a, const Person &b)
+    { return a.getAge() < b.getAge(); };
+    SegmentedDeque<Person> *merged = left.mergeSorted(right, byAge);
+    std::string order;
+    for (const Person &p : *merged)
+    {
+        order += p.getName();
+    }
+    EXPECT_EQ(order, "wabcxyd");
+    EXPECT_EQ(merged->getSegmentSize(), 3);
+    int blocks = 0;
+    merged->forEachBlock([&blocks](const Person *, const int)
+                         { blocks++; });
+    EXPECT_EQ(blocks, 3);
+    delete merged;
+
+    SegmentedDeque<Person> empty;
+    SegmentedDeque<Person> *copy = empty.mergeSorted(left, byAge);
+    EXPECT_EQ(copy->getLength(), 4);
+    EXPECT_EQ(copy->getLast().getName(), "d");
+    delete copy;
+}
+
+TEST_F(SegmentedDequeTest, EraseShiftsItemsAndReleasesEmptySegments)
+{
+    SegmentedDeque<int> deque(3);
+    for (int i = 0; i < 10; i++)
+    {
+        deque.append(i);
+    }
+
+    deque.erase(0);
+    deque.erase(8);
+    deque.erase(3);
+    ASSERT_EQ(deque.getLength(), 7);
+    EXPECT_EQ(deque.get(0), 1);
+    EXPECT_EQ(deque.get(3), 5);
+    EXPECT_EQ(deque.getLast(), 8);
+
+    for (int i = 0; i < 3; i++)
+    {
+        deque.erase(2);
+    }
+    int segments = 0;
+    deque.forEachBlock([&segments](const int *, const int count)
+                       {
+        EXPECT_GT(count, 0);
+        segments++; });
+    EXPECT_EQ(segments, 2);
+    EXPECT_EQ(deque.get(2), 7);
+    EXPECT_EQ(deque.lowerBound(7), 2);
+
+    EXPECT_THROW(deque.erase(4), std::out_of_range);
+    EXPECT_THROW(deque.erase(-1), std::out_of_range);
+    while (deque.getLength() > 0)
+    {
+        deque.erase(0);
+    }
+    deque.append(42);
+    EXPECT_EQ(deque.getFirst(), 42);
+}
+
+TEST_F(SegmentedDequeTest, EraseFrontReleasesWholeSegmentsAndShiftsThePartOne)
+{
+    SegmentedDeque<int> deque(4);
+    for (int i = 0; i < 14; i++)
+    {
+        deque.append(i);
+    }
+    HashIndex<int> *index = deque.hashIndex();
+    EXPECT_EQ(index->findFirst(9), 9);
+
+    deque.eraseFront(4);
+    std::vector<int> sizes;
+    deque.forEachBlock([&sizes](const int *, const int count)
+                       { sizes.push_back(count); });
+    EXPECT_EQ(sizes, (std::vector<int>{4, 4, 2}));
+    EXPECT_EQ(deque.getFirst(), 4);
+    EXPECT_EQ(index->findFirst(9), 5);
+
+    deque.eraseFront(5);
+    sizes.clear();
+    deque.forEachBlock([&sizes](const int *, const int count)
+                       { sizes.push_back(count); });
+    EXPECT_EQ(sizes, (std::vector<int>{3, 2}));
+    ASSERT_EQ(deque.getLength(), 5);
+    EXPECT_EQ(deque.get(0), 9);
+    EXPECT_EQ(deque.get(4), 13);
+    EXPECT_EQ(index->findFirst(4), -1);
+    EXPECT_EQ(index->findFirst(12), 3);
+
+    EXPECT_THROW(deque.eraseFront(6), std::out_of_range);
+    EXPECT_THROW(deque.eraseFront(-1), std::out_of_range);
+    deque.eraseFront(0);
+    deque.eraseFront(5);
+    EXPECT_EQ(deque.getLength(), 0);
+    deque.append(42);
+    EXPECT_EQ(deque.getFirst(), 42);
+    EXPECT_EQ(index->findFirst(42), 0);
+    delete index;
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../inc/selection.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+TEST(IntroSelectTest, PlacesNthLikeAFullSort)
+{
+    std::srand(9);
+    const int sizes[] = {1, 2, 16, 17, 100, 1000, 20000};
+    for (int size : sizes)
+    {
+        for (int shape = 0; shape < 4; shape++)
+        {
+            std::vector<int> items(size);
+            for (int i = 0; i < size; i++)
+            {
+                switch (shape)
+                {
+                case 0:
+                    items[i] = std::rand();
+                    break;
+                case 1:
+                    items[i] = i;
+                    break;
+                case 2:
+                    items[i] = size - i;
+                    break;
+                default:
+                    items[i] = std::rand() % 3;
+                }
+            }
+            std::vector<int> sorted = items;
+            std::sort(sorted.begin(), sorted.end());
+
+            const int picks[] = {0, size / 3, size / 2, size - 1};
+            for (int nth : picks)
+            {
+                std::vector<int> selected = items;
+                introSelect(selected.begin(), selected.begin() + nth, selected.end(), std::less<int>());
+                ASSERT_EQ(selected[nth], sorted[nth]) << "size " << size << " shape " << shape;
+                for (int i = 0; i < size; i++)
+                {
+                    ASSERT_TRUE(i < nth ? selected[i] <= selected[nth] : selected[i] >= selected[nth]);
+                }
+            }
+        }
+    }
+}
+
+// McIlroy's adversary: item values are fixed lazily, during a first run, so
+// that every pivot turns out to be one of the smallest items left. Replaying
+// the same values drives plain quickselect quadratic; the depth limit has to
+// switch to heap selection and still place the right item.
+TEST(IntroSelectTest, FallsBackToHeapSelection)
+{
+    const int size = 4096;
+    const int gas = size;
+    std::vector<int> values(size, gas);
+    std::vector<int> order(size);
+    for (int i = 0; i < size; i++)
+    {
+        order[i] = i;
+    }
+    int solid = 0;
+    int candidate = 0;
+    introSelect(order.begin(), order.begin() + size / 2, order.end(), [&](int a, int b)
+                {
+        if (values[a] == gas && values[b] == gas)
+        {
+            values[a == candidate ? a : b] = solid++;
+        }
+        if (values[a] == gas)
+        {
+            candidate = a;
+        }
+        else if (values[b] == gas)
+        {
+            candidate = b;
+        }
+        return values[a] < values[b]; });
+
+    std::vector<int> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    int comparisons = 0;
+    introSelect(values.begin(), values.begin() + size / 2, values.end(), [&comparisons](int a, int b)
+                {
+        comparisons++;
+        return a < b; });
+    EXPECT_EQ(values[size / 2], sorted[size / 2]);
+    EXPECT_LT(comparisons, 64 * size);
+}
+
+TEST(TopKHeapTest, KeepsTheBestAndBreaksTiesByIndex)
+{
+    std::vector<std::string> words = {"pear", "fig", "apple", "kiwi", "plum", "banana", "lime"};
+    TopKHeap<std::string, int, std::less<int>> longest(3, std::less<int>());
+    for (int i = 0; i < static_cast<int>(words.size()); i++)
+    {
+        longest.offer(static_cast<int>(words[i].size()), i, &words[i]);
+    }
+    ASSERT_EQ(longest.getSize(), 3);
+
+    std::vector<std::string> order;
+    longest.forEachBest([&order](const std::string &word)
+                        { order.push_back(word); });
+    EXPECT_EQ(order, (std::vector<std::string>{"banana", "apple", "pear"}));
+
+    TopKHeap<std::string, int, std::less<int>> rest(3, std::less<int>());
+    std::string cherry = "cherry";
+    rest.offer(6, 10, &cherry);
+    longest.merge(std::move(rest));
+    order.clear();
+    longest.forEachBest([&order](const std::string &word)
+                        { order.push_back(word); });
+    EXPECT_EQ(order, (std::vector<std::string>{"banana", "cherry", "apple"}));
+
+    TopKHeap<std::string, int, std::less<int>> none(0, std::less<int>());
+    none.offer(1, 0, &cherry);
+    EXPECT_EQ(none.getSize(), 0);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../inc/slidingWindow.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+template <class Op, class Fold>
+static void expectMatchesRecomputation(const int width, const int segmentSize, const Op &op, const Fold &fold)
+{
+    SlidingWindow<long long, Op> window(width, op, segmentSize);
+    std::vector<long long> stream;
+    for (int step = 0; step < 3000; step++)
+    {
+        long long item = std::rand() % 1000 - 500;
+        window.push(item);
+        stream.push_back(item);
+
+        int length = std::min(width, static_cast<int>(stream.size()));
+        ASSERT_EQ(window.getLength(), length);
+        std::vector<long long> last(stream.end() - length, stream.end());
+        ASSERT_EQ(window.query(), fold(last));
+        ASSERT_EQ(window.get(0), last.front());
+        ASSERT_EQ(window.get(length - 1), last.back());
+    }
+}
+
+TEST(SlidingWindowTest, SumMatchesRecomputationForEveryWidth)
+{
+    std::srand(17);
+    auto sum = [](const std::vector<long long> &items)
+    {
+        long long total = 0;
+        for (long long item : items)
+        {
+            total += item;
+        }
+        return total;
+    };
+    for (int width : {1, 2, 3, 7, 32, 100})
+    {
+        expectMatchesRecomputation(width, 8, std::plus<>(), sum);
+    }
+}
+
+TEST(SlidingWindowTest, MinAndMaxUseAMonotonicQueue)
+{
+    std::srand(18);
+    auto minimum = [](const std::vector<long long> &items)
+    { return *std::min_element(items.begin(), items.end()); };
+    auto maximum = [](const std::vector<long long> &items)
+    { return *std::max_element(items.begin(), items.end()); };
+    for (int width : {1, 2, 5, 64, 257})
+    {
+        expectMatchesRecomputation(width, 16, MinOp<>(), minimum);
+        expectMatchesRecomputation(width, 16, MaxOp<>(), maximum);
+    }
+}
+
+TEST(SlidingWindowTest, KeepsTheOrderOfNonCommutativeOps)
+{
+    auto concat = [](const std::string &a, const std::string &b)
+    { return a + b; };
+    SlidingWindow<std::string, decltype(concat)> window(3, concat, 2);
+
+    const char *letters[] = {"a", "b", "c", "d", "e", "f", "g"};
+    std::vector<std::string> expected = {"a", "ab", "abc", "bcd", "cde", "def", "efg"};
+    for (int i = 0; i < 7; i++)
+    {
+        window.push(letters[i]);
+        EXPECT_EQ(window.query(), expected[i]);
+    }
+
+    window.evict();
+    EXPECT_EQ(window.query(), "fg");
+    window.push("h");
+    EXPECT_EQ(window.query(), "fgh");
+    EXPECT_TRUE(window.isFull());
+}
+
+TEST(SlidingWindowTest, EvictingDownToEmptyAndErrors)
+{
+    SlidingWindow<int, MaxOp<>> window(4, MaxOp<>(), 2);
+    for (int item : {5, 1, 4, 2})
+    {
+        window.push(item);
+    }
+    EXPECT_EQ(window.query(), 5);
+    window.evict();
+    EXPECT_EQ(window.query(), 4);
+    window.evict();
+    window.evict();
+    EXPECT_EQ(window.query(), 2);
+    window.evict();
+    EXPECT_EQ(window.getLength(), 0);
+    EXPECT_THROW(window.query(), std::out_of_range);
+    EXPECT_THROW(window.evict(), std::out_of_range);
+    EXPECT_THROW(window.get(0), std::out_of_range);
+
+    window.push(3);
+    EXPECT_EQ(window.query(), 3);
+    EXPECT_EQ(window.getWidth(), 4);
+    EXPECT_FALSE(window.isFull());
+
+    EXPECT_THROW((SlidingWindow<int, std::plus<>>(0)), std::invalid_argument);
+}
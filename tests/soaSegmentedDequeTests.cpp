@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include "../inc/soaSegmentedDeque.hpp"
+#include "../inc/arraySequence.hpp"
+#include "../types/complex.hpp"
+#include <vector>
+
+using ComplexLayout = SoALayout<Complex>;
+
+TEST(SoASegmentedDequeTest, ConstructorCreatesEmptyDeque)
+{
+    SoASegmentedDeque<Complex> deque(4);
+    EXPECT_EQ(deque.getLength(), 0);
+    EXPECT_EQ(deque.getSegmentCount(), 0);
+    EXPECT_THROW(deque.getFirst(), std::out_of_range);
+    EXPECT_THROW(SoASegmentedDeque<Complex>(0), std::invalid_argument);
+}
+
+TEST(SoASegmentedDequeTest, AppendAndPrependKeepOrder)
+{
+    SoASegmentedDeque<Complex> deque(3);
+    for (int i = 0; i < 5; i++)
+    {
+        deque.append(Complex(i, -i));
+    }
+    for (int i = 1; i <= 4; i++)
+    {
+        deque.prepend(Complex(-i, i));
+    }
+
+    EXPECT_EQ(deque.getLength(), 9);
+    for (int i = 0; i < 9; i++)
+    {
+        EXPECT_EQ(deque.get(i), Complex(i - 4, 4 - i));
+    }
+    EXPECT_EQ(deque.getFirst(), Complex(-4, 4));
+    EXPECT_EQ(deque.getLast(), Complex(4, -4));
+    EXPECT_THROW(deque.get(9), std::out_of_range);
+}
+
+TEST(SoASegmentedDequeTest, ColumnsAreContiguousPerSegment)
+{
+    SoASegmentedDeque<Complex> deque(4);
+    for (int i = 0; i < 6; i++)
+    {
+        deque.append(Complex(i, 10 * i));
+    }
+
+    EXPECT_EQ(deque.getSegmentCount(), 2);
+    EXPECT_EQ(deque.getSegmentLength(0), 4);
+    EXPECT_EQ(deque.getSegmentLength(1), 2);
+
+    const double *real = deque.getColumn(0, ComplexLayout::REAL);
+    const double *imag = deque.getColumn(0, ComplexLayout::IMAG);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_DOUBLE_EQ(real[i], i);
+        EXPECT_DOUBLE_EQ(imag[i], 10 * i);
+    }
+}
+
+TEST(SoASegmentedDequeTest, ProxyReferencesReadAndWrite)
+{
+    SoASegmentedDeque<Complex> deque(2);
+    deque.append(Complex(1, 2));
+    deque.append(Complex(3, 4));
+    deque.append(Complex(5, 6));
+
+    Complex value = deque[1];
+    EXPECT_EQ(value, Complex(3, 4));
+
+    deque[1] = Complex(7, 8);
+    EXPECT_EQ(deque.get(1), Complex(7, 8));
+
+    deque[0] = deque[2];
+    EXPECT_EQ(deque.get(0), Complex(5, 6));
+
+    deque[2].setField(ComplexLayout::IMAG, -1);
+    EXPECT_DOUBLE_EQ(deque[2].getField(ComplexLayout::IMAG), -1);
+    EXPECT_EQ(deque.get(2), Complex(5, -1));
+}
+
+TEST(SoASegmentedDequeTest, FieldKernels)
+{
+    SoASegmentedDeque<Complex> deque(3);
+    for (int i = 1; i <= 7; i++)
+    {
+        deque.append(Complex(i, 2 * i));
+    }
+
+    double realSum = deque.reduceField(ComplexLayout::REAL, [](double acc, double x)
+                                       { return acc + x; }, 0.0);
+    EXPECT_DOUBLE_EQ(realSum, 28.0);
+
+    SoASegmentedDeque<Complex> *bigImag = deque.whereField(ComplexLayout::IMAG, [](double x)
+                                                           { return x > 8; });
+    EXPECT_EQ(bigImag->getLength(), 3);
+    EXPECT_EQ(bigImag->getFirst(), Complex(5, 10));
+    delete bigImag;
+
+    SoASegmentedDeque<Complex> *large = deque.where([](const Complex &c)
+                                                    { return c.magnitude() > 10; });
+    EXPECT_EQ(large->getLength(), 3);
+    EXPECT_EQ(large->getLast(), Complex(7, 14));
+    delete large;
+
+    Complex total = deque.reduce([](const Complex &acc, const Complex &c)
+                                 { return acc + c; }, Complex());
+    EXPECT_EQ(total, Complex(28, 56));
+
+    EXPECT_THROW(deque.reduceField(2, [](double acc, double x)
+                                   { return acc + x; }, 0.0),
+                 std::out_of_range);
+}
+
+TEST(SoASegmentedDequeTest, FiltersCompactIntoFullSegments)
+{
+    SoASegmentedDeque<Complex> deque(4);
+    std::vector<Complex> expected;
+    for (int i = 0; i < 30; i++)
+    {
+        deque.append(Complex(i, i % 3));
+    }
+    for (int i = 1; i <= 5; i++)
+    {
+        deque.prepend(Complex(-i, -i % 3));
+    }
+    for (const Complex &c : deque)
+    {
+        if (c.getImag() == 0)
+        {
+            expected.push_back(c);
+        }
+    }
+
+    SoASegmentedDeque<Complex> *byField = deque.whereField(ComplexLayout::IMAG, [](double x)
+                                                           { return x == 0; });
+    SoASegmentedDeque<Complex> *byItem = deque.where([](const Complex &c)
+                                                     { return c.getImag() == 0; });
+    for (SoASegmentedDeque<Complex> *filtered : {byField, byItem})
+    {
+        ASSERT_EQ(filtered->getLength(), static_cast<int>(expected.size()));
+        for (int i = 0; i < filtered->getLength(); i++)
+        {
+            EXPECT_EQ(filtered->get(i), expected[i]);
+        }
+        for (int segment = 0; segment + 1 < filtered->getSegmentCount(); segment++)
+        {
+            EXPECT_EQ(filtered->getSegmentLength(segment), 4);
+        }
+    }
+    delete byField;
+    delete byItem;
+
+    SoASegmentedDeque<Complex> *none = deque.where([](const Complex &)
+                                                   { return false; });
+    EXPECT_EQ(none->getLength(), 0);
+    delete none;
+}
+
+TEST(SoASegmentedDequeTest, CopyIterateAndConcat)
+{
+    SoASegmentedDeque<Complex> deque(2);
+    deque.append(Complex(1, 1));
+    deque.prepend(Complex(0, 0));
+
+    SoASegmentedDeque<Complex> copy(deque);
+    copy.set(0, Complex(9, 9));
+    EXPECT_EQ(deque.get(0), Complex(0, 0));
+
+    Complex items[] = {Complex(2, 2), Complex(3, 3)};
+    ArraySequence<Complex> extra(items, 2);
+    deque.concat(&extra);
+
+    double expected = 0;
+    for (const Complex &c : deque)
+    {
+        EXPECT_EQ(c, Complex(expected, expected));
+        expected++;
+    }
+    EXPECT_EQ(expected, 4);
+
+    copy = deque;
+    EXPECT_EQ(copy.getLength(), 4);
+    EXPECT_EQ(copy.get(0), Complex(0, 0));
+}
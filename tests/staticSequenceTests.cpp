@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "../inc/arraySequence.hpp"
+#include "../inc/listSequence.hpp"
+#include "../inc/segmentedDeque.hpp"
+#include "../types/person.hpp"
+
+template <class Derived>
+int sumOf(const StaticSequence<Derived, int> &sequence)
+{
+    return sequence.reduce([](int acc, int item)
+                           { return acc + item; }, 0);
+}
+
+TEST(StaticSequenceTest, GenericAlgorithmWorksForEveryContainer)
+{
+    int items[] = {1, 2, 3, 4, 5, 6, 7};
+
+    ArraySequence<int> array(items, 7);
+    ListSequence<int> list(items, 7);
+    SegmentedDeque<int> deque(items, 7, 3);
+
+    EXPECT_EQ(sumOf(array), 28);
+    EXPECT_EQ(sumOf(list), 28);
+    EXPECT_EQ(sumOf(deque), 28);
+}
+
+TEST(StaticSequenceTest, ForEachVisitsInOrder)
+{
+    SegmentedDeque<int> deque(2);
+    for (int i = 0; i < 5; i++)
+    {
+        deque.append(i);
+    }
+    deque.prepend(-1);
+
+    int expected = -1;
+    deque.forEach([&expected](int item)
+                  { EXPECT_EQ(item, expected++); });
+    EXPECT_EQ(expected, 5);
+}
+
+TEST(StaticSequenceTest, TransformCountIfAndContains)
+{
+    int items[] = {1, 2, 3, 4};
+    ListSequence<int> list(items, 4);
+    list.transform([](int item)
+                   { return item * 10; });
+    EXPECT_EQ(list.get(3), 40);
+    EXPECT_EQ(list.countIf([](int item)
+                           { return item > 15; }),
+              3);
+    EXPECT_TRUE(list.contains(20));
+    EXPECT_FALSE(list.contains(2));
+
+    SegmentedDeque<Person> people(2);
+    people.append(Person("Alice", 30));
+    people.append(Person("Bob", 25));
+    people.append(Person("Charlie", 35));
+    EXPECT_EQ(people.countIf([](const Person &p)
+                             { return p.getAge() >= 30; }),
+              2);
+    EXPECT_TRUE(people.contains(Person("Bob", 25)));
+}
+
+TEST(StaticSequenceTest, VirtualInterfaceStillAvailable)
+{
+    int items[] = {5, 6};
+    SegmentedDeque<int> deque(items, 2, 4);
+    Sequence<int> *sequence = &deque;
+    EXPECT_EQ(sequence->getLength(), 2);
+    EXPECT_EQ(sequence->get(1), 6);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "../inc/timSort.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Items carry their original position so stability can be checked.
+typedef std::pair<int, int> Tagged;
+
+static bool byKey(const Tagged &a, const Tagged &b)
+{
+    return a.first < b.first;
+}
+
+static void expectMatchesStableSort(std::vector<Tagged> items)
+{
+    std::vector<Tagged> expected = items;
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+    timSort(items.data(), static_cast<int>(items.size()), byKey);
+    ASSERT_EQ(items, expected);
+}
+
+TEST(TimSortTest, MatchesStableSortOnManyShapes)
+{
+    std::srand(5);
+    const int sizes[] = {0, 1, 2, 31, 32, 33, 64, 100, 1000, 5000};
+    for (int size : sizes)
+    {
+        std::vector<Tagged> random, fewKeys, ascending, descending, sawtooth, nearlySorted;
+        for (int i = 0; i < size; i++)
+        {
+            random.push_back(Tagged(std::rand() % 100000, i));
+            fewKeys.push_back(Tagged(std::rand() % 4, i));
+            ascending.push_back(Tagged(i, i));
+            descending.push_back(Tagged(size - i, i));
+            sawtooth.push_back(Tagged(i % 50, i));
+            nearlySorted.push_back(Tagged(std::rand() % 20 == 0 ? std::rand() % size : i, i));
+        }
+        expectMatchesStableSort(random);
+        expectMatchesStableSort(fewKeys);
+        expectMatchesStableSort(ascending);
+        expectMatchesStableSort(descending);
+        expectMatchesStableSort(sawtooth);
+        expectMatchesStableSort(nearlySorted);
+    }
+}
+
+TEST(TimSortTest, SortedAndReversedInputTakeLinearComparisons)
+{
+    const int size = 10000;
+    std::vector<int> items(size);
+    for (int i = 0; i < size; i++)
+    {
+        items[i] = i;
+    }
+
+    int comparisons = 0;
+    auto counting = [&comparisons](int a, int b)
+    {
+        comparisons++;
+        return a < b;
+    };
+
+    timSort(items.data(), size, counting);
+    EXPECT_EQ(comparisons, size - 1);
+
+    std::reverse(items.begin(), items.end());
+    comparisons = 0;
+    timSort(items.data(), size, counting);
+    EXPECT_EQ(comparisons, size - 1);
+    EXPECT_TRUE(std::is_sorted(items.begin(), items.end()));
+
+    // Two interleaved sorted halves merge with galloping in well under n log n.
+    for (int i = 0; i < size; i++)
+    {
+        items[i] = i < size / 2 ? 2 * i : 2 * (i - size / 2) + 1;
+    }
+    comparisons = 0;
+    timSort(items.data(), size, counting);
+    EXPECT_TRUE(std::is_sorted(items.begin(), items.end()));
+    EXPECT_LT(comparisons, 2 * size);
+}
+
+TEST(TimSortTest, MovesNonTrivialItems)
+{
+    std::vector<std::string> words = {"pear", "fig", "apple", "kiwi", "banana", "date", "cherry"};
+    for (int i = 0; i < 100; i++)
+    {
+        words.push_back("w" + std::to_string((i * 37) % 101));
+    }
+    std::vector<std::string> expected = words;
+    std::sort(expected.begin(), expected.end());
+
+    timSort(words.data(), static_cast<int>(words.size()), std::less<std::string>());
+    EXPECT_EQ(words, expected);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "../inc/unrolledLinkedList.hpp"
+#include "../inc/listSequence.hpp"
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <vector>
+
+template <typename List>
+std::vector<int> toVector(const List &list)
+{
+    std::vector<int> result;
+    for (auto it = list.cbegin(); it != list.cend(); ++it)
+    {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+TEST(UnrolledLinkedListTest, AppendPrependAndGetAcrossNodes)
+{
+    UnrolledLinkedList<int, 4> list;
+    for (int i = 0; i < 10; i++)
+    {
+        list.append(i);
+    }
+    list.prepend(-1);
+    list.prepend(-2);
+
+    ASSERT_EQ(list.getLength(), 12);
+    EXPECT_EQ(list.getFirst(), -2);
+    EXPECT_EQ(list.getLast(), 9);
+    for (int i = 0; i < 12; i++)
+    {
+        EXPECT_EQ(list.get(i), i - 2);
+    }
+    EXPECT_THROW(list.get(12), std::out_of_range);
+    EXPECT_LE(list.getNodeCount(), 5);
+}
+
+TEST(UnrolledLinkedListTest, InsertAtSplitsFullNodes)
+{
+    int items[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    UnrolledLinkedList<int, 4> list(items, 8);
+    list.insertAt(100, 2);
+    list.insertAt(200, 7);
+    list.insertAt(300, 10);
+    list.set(0, -5);
+
+    std::vector<int> expected = {-5, 1, 100, 2, 3, 4, 5, 200, 6, 7, 300};
+    EXPECT_EQ(toVector(list), expected);
+    EXPECT_THROW(list.insertAt(0, 12), std::out_of_range);
+}
+
+TEST(UnrolledLinkedListTest, IteratorInsertAndEraseMatchStdList)
+{
+    UnrolledLinkedList<int, 4> list;
+    std::list<int> reference;
+    std::srand(7);
+
+    for (int step = 0; step < 2000; step++)
+    {
+        int position = reference.empty() ? 0 : std::rand() % (static_cast<int>(reference.size()) + 1);
+        auto it = list.begin();
+        auto expected = reference.begin();
+        for (int i = 0; i < position; i++)
+        {
+            ++it;
+            ++expected;
+        }
+
+        if (std::rand() % 3 != 0 || expected == reference.end())
+        {
+            it.insert(step);
+            expected = reference.insert(expected, step);
+        }
+        else
+        {
+            it.erase();
+            expected = reference.erase(expected);
+        }
+
+        if (expected == reference.end())
+        {
+            EXPECT_TRUE(it == list.end());
+        }
+        else
+        {
+            EXPECT_EQ(*it, *expected);
+        }
+        ASSERT_EQ(list.getLength(), static_cast<int>(reference.size()));
+    }
+
+    EXPECT_EQ(toVector(list), std::vector<int>(reference.begin(), reference.end()));
+}
+
+TEST(UnrolledLinkedListTest, EraseToEmptyAndWalkBackwards)
+{
+    int items[] = {1, 2, 3, 4, 5, 6};
+    UnrolledLinkedList<int, 2> list(items, 6);
+
+    auto it = list.end();
+    --it;
+    EXPECT_EQ(*it, 6);
+    it--;
+    EXPECT_EQ(*it, 5);
+
+    for (auto erase = list.begin(); erase.notEnd();)
+    {
+        erase.erase();
+    }
+    EXPECT_EQ(list.getLength(), 0);
+    EXPECT_EQ(list.getNodeCount(), 0);
+    EXPECT_TRUE(list.begin() == list.end());
+    EXPECT_THROW(list.end().erase(), std::runtime_error);
+    EXPECT_THROW(*list.end(), std::runtime_error);
+}
+
+TEST(UnrolledLinkedListTest, CopySubListAndConcat)
+{
+    int items[] = {1, 2, 3, 4, 5, 6, 7};
+    UnrolledLinkedList<int, 3> list(items, 7);
+    UnrolledLinkedList<int, 3> copy(list);
+    copy.append(8);
+
+    UnrolledLinkedList<int, 3> *sub = list.getSubList(2, 5);
+    EXPECT_EQ(toVector(*sub), std::vector<int>({3, 4, 5, 6}));
+
+    UnrolledLinkedList<int, 3> *joined = sub->concatImmutable(copy);
+    EXPECT_EQ(joined->getLength(), 12);
+    EXPECT_EQ(joined->getLast(), 8);
+    EXPECT_THROW(list.concat(list), std::invalid_argument);
+
+    list = *sub;
+    EXPECT_EQ(toVector(list), std::vector<int>({3, 4, 5, 6}));
+
+    delete sub;
+    delete joined;
+}
+
+TEST(UnrolledLinkedListTest, ForEachBlockVisitsWholeNodes)
+{
+    UnrolledLinkedList<int, 8> list;
+    for (int i = 0; i < 20; i++)
+    {
+        list.append(i);
+    }
+
+    int blocks = 0;
+    int sum = 0;
+    list.forEachBlock([&](const int *items, const int count)
+                      {
+        blocks++;
+        for (int i = 0; i < count; i++) sum += items[i]; });
+    EXPECT_EQ(blocks, 3);
+    EXPECT_EQ(sum, 190);
+}
+
+TEST(UnrolledListSequenceTest, SequenceInterfaceOnUnrolledStorage)
+{
+    int items[] = {1, 2, 3, 4, 5};
+    UnrolledListSequence<int> seq(items, 5);
+    seq.insertAt(10, 1);
+    seq.prepend(0);
+    seq.set(6, 50);
+
+    Sequence<int> *sub = seq.getSubsequence(1, 3);
+    EXPECT_EQ(sub->getLength(), 3);
+    EXPECT_EQ(sub->get(1), 10);
+    delete sub;
+
+    Sequence<int> *appended = seq.appendImmutable(6);
+    EXPECT_EQ(appended->getLast(), 6);
+    EXPECT_EQ(seq.getLength(), 7);
+    delete appended;
+
+    EXPECT_EQ(seq.reduce([](int acc, int x)
+                         { return acc + x; },
+                         0),
+              0 + 1 + 10 + 2 + 3 + 4 + 50);
+
+    int visited = 0;
+    for (auto it = seq.begin(); it != seq.end(); ++it)
+    {
+        visited++;
+    }
+    EXPECT_EQ(visited, 7);
+}
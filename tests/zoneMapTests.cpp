@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include "../inc/segmentedDeque.hpp"
+#include "../types/person.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+static int countInRange(const std::vector<int> &items, const int lo, const int hi)
+{
+    return static_cast<int>(std::count_if(items.begin(), items.end(), [&](int x)
+                                          { return x >= lo && x <= hi; }));
+}
+
+TEST(ZoneMapTest, RangeQueriesMatchFullScan)
+{
+    SegmentedDeque<int> deque(16);
+    std::vector<int> reference;
+    for (int i = 0; i < 1000; i++)
+    {
+        int value = i * 3 + i % 7;
+        deque.append(value);
+        reference.push_back(value);
+    }
+
+    ZoneMap<int> *zones = deque.zoneMap();
+    std::srand(3);
+    for (int query = 0; query < 200; query++)
+    {
+        int lo = std::rand() % 3200 - 100;
+        int hi = lo + std::rand() % 300;
+        ASSERT_EQ(zones->count(lo, hi), countInRange(reference, lo, hi));
+        EXPECT_EQ(zones->contains(lo, hi), countInRange(reference, lo, hi) > 0);
+    }
+
+    SegmentedDeque<int> *range = zones->whereRange(100, 400);
+    SegmentedDeque<int> *scanned = deque.where([](int x)
+                                               { return x >= 100 && x <= 400; });
+    ASSERT_EQ(range->getLength(), scanned->getLength());
+    for (int i = 0; i < range->getLength(); i++)
+    {
+        EXPECT_EQ(range->get(i), scanned->get(i));
+    }
+    EXPECT_EQ(range->getSegmentSize(), 16);
+    EXPECT_TRUE(zones->contains(4));
+    EXPECT_FALSE(zones->contains(3));
+    EXPECT_FALSE(zones->contains(-1));
+
+    delete range;
+    delete scanned;
+    delete zones;
+}
+
+TEST(ZoneMapTest, SkipsSegmentsOutsideTheRange)
+{
+    SegmentedDeque<int> deque(10);
+    for (int i = 0; i < 1000; i++)
+    {
+        deque.append(i);
+    }
+
+    int keyCalls = 0;
+    auto *zones = deque.zoneMap([&keyCalls](int x)
+                                {
+        keyCalls++;
+        return x; });
+
+    EXPECT_EQ(zones->count(0, 999), 1000);
+    keyCalls = 0;
+
+    // [505, 534] covers two whole segments and half of two more.
+    EXPECT_EQ(zones->count(505, 534), 30);
+    EXPECT_EQ(keyCalls, 20);
+
+    keyCalls = 0;
+    EXPECT_EQ(zones->count(200, 299), 100);
+    EXPECT_FALSE(zones->contains(2000));
+    EXPECT_EQ(keyCalls, 0);
+
+    deque.append(5000);
+    EXPECT_EQ(keyCalls, 1);
+    EXPECT_TRUE(zones->contains(5000));
+    delete zones;
+}
+
+TEST(ZoneMapTest, SummariesFollowEveryKindOfChange)
+{
+    SegmentedDeque<int> deque(4);
+    std::vector<int> reference;
+    ZoneMap<int> *zones = deque.zoneMap();
+    std::srand(11);
+
+    for (int step = 0; step < 600; step++)
+    {
+        int value = std::rand() % 1000;
+        int size = static_cast<int>(reference.size());
+        int index = size > 0 ? std::rand() % size : 0;
+        switch (size == 0 ? 0 : std::rand() % 8)
+        {
+        case 0:
+        case 1:
+            deque.append(value);
+            reference.push_back(value);
+            break;
+        case 2:
+            deque.prepend(value);
+            reference.insert(reference.begin(), value);
+            break;
+        case 3:
+            deque.insertAt(value, index);
+            reference.insert(reference.begin() + index, value);
+            break;
+        case 4:
+            deque.set(index, value);
+            reference[index] = value;
+            break;
+        case 5:
+            deque.get(index) = value;
+            reference[index] = value;
+            break;
+        case 6:
+        {
+            auto it = deque.begin();
+            for (int i = 0; i < index; i++)
+            {
+                ++it;
+            }
+            *it = value;
+            reference[index] = value;
+            break;
+        }
+        default:
+        {
+            int more[] = {value, value + 1, value + 2};
+            deque.appendRange(more, 3);
+            reference.insert(reference.end(), more, more + 3);
+            break;
+        }
+        }
+
+        int lo = std::rand() % 1000;
+        int hi = lo + std::rand() % 100;
+        ASSERT_EQ(zones->count(lo, hi), countInRange(reference, lo, hi)) << "step " << step;
+    }
+
+    deque.sort(deque.begin(), deque.end());
+    deque.transform([](int x)
+                    { return x * 2; });
+    for (int &x : reference)
+    {
+        x *= 2;
+    }
+    EXPECT_EQ(zones->count(0, 500), countInRange(reference, 0, 500));
+
+    deque.clear();
+    EXPECT_EQ(zones->count(0, 10000), 0);
+    delete zones;
+}
+
+TEST(ZoneMapTest, PersonByAge)
+{
+    SegmentedDeque<Person> people(2);
+    people.append(Person("Ann", 21));
+    people.append(Person("Bob", 25));
+    people.append(Person("Cid", 30));
+    people.append(Person("Dan", 34));
+    people.append(Person("Eve", 52));
+
+    auto *byAge = people.zoneMap([](const Person &p)
+                                 { return p.getAge(); });
+    EXPECT_EQ(byAge->count(25, 40), 3);
+    EXPECT_FALSE(byAge->contains(60, 70));
+
+    people.set(4, Person("Eve", 65));
+    EXPECT_TRUE(byAge->contains(60, 70));
+
+    SegmentedDeque<Person> *thirties = byAge->whereRange(30, 39);
+    ASSERT_EQ(thirties->getLength(), 2);
+    EXPECT_EQ(thirties->get(0).getName(), "Cid");
+    delete thirties;
+    delete byAge;
+}
+
+TEST(ZoneMapTest, DetachesFromItsDeque)
+{
+    auto *deque = new SegmentedDeque<int>(4);
+    deque->append(1);
+
+    ZoneMap<int> *first = deque->zoneMap();
+    ZoneMap<int> *second = deque->zoneMap();
+    delete first;
+    deque->append(2);
+    EXPECT_EQ(second->count(0, 5), 2);
+
+    delete deque;
+    EXPECT_THROW(second->count(0, 5), std::logic_error);
+    delete second;
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <iostream>
 #include <cmath>
+#include "../inc/serializer.hpp"
+#include "../inc/soaLayout.hpp"
 
 class Complex
 {
@@ -74,3 +76,32 @@ inline std::ostream &operator<<(std::ostream &os, const Complex &c)
     }
     return os;
 }
+
+template <>
+struct TypeTag<Complex>
+{
+    static const uint32_t value = 16;
+};
+
+template <>
+struct SoALayout<Complex>
+{
+    using Field = double;
+    static const int fieldCount = 2;
+    enum
+    {
+        REAL = 0,
+        IMAG = 1
+    };
+
+    static void scatter(const Complex &item, Field *const *columns, const int i)
+    {
+        columns[REAL][i] = item.getReal();
+        columns[IMAG][i] = item.getImag();
+    }
+
+    static Complex gather(const Field *const *columns, const int i)
+    {
+        return Complex(columns[REAL][i], columns[IMAG][i]);
+    }
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 #include <iostream>
+#include <stdexcept>
+#include "../inc/serializer.hpp"
 
 class Person
 {
@@ -44,3 +46,51 @@ inline std::ostream &operator<<(std::ostream &os, const Person &p)
     os << p.getName() << " (" << p.getAge() << ")";
     return os;
 }
+
+template <>
+struct TypeTag<Person>
+{
+    static const uint32_t value = 17;
+};
+
+// Person holds a std::string, so it is stored as a length-prefixed name followed by the age.
+template <>
+struct Serializer<Person>
+{
+    static const bool isRaw = false;
+    // Longer names are taken for a corrupted length rather than allocated.
+    static const uint32_t maxNameLength = 1u << 20;
+
+    static void write(std::ostream &os, const Person *items, const int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            std::string name = items[i].getName();
+            writeBinary(os, static_cast<uint32_t>(name.size()));
+            os.write(name.data(), static_cast<std::streamsize>(name.size()));
+            writeBinary(os, static_cast<int32_t>(items[i].getAge()));
+        }
+    }
+
+    static void read(std::istream &is, Person *items, const int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            uint32_t nameLength = 0;
+            readBinary(is, nameLength);
+            if (!is)
+            {
+                throw std::runtime_error("Unexpected end of stream");
+            }
+            if (nameLength > maxNameLength)
+            {
+                throw std::runtime_error("Serialized name length is invalid");
+            }
+            std::string name(nameLength, '\0');
+            is.read(&name[0], static_cast<std::streamsize>(nameLength));
+            int32_t age = 0;
+            readBinary(is, age);
+            items[i] = Person(name, age);
+        }
+    }
+};